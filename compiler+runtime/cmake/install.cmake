@@ -55,11 +55,6 @@ jank_glob_install_without_prefix(
   PATTERN "${CMAKE_SOURCE_DIR}/third-party/nanobench/include/*"
 )
 
-jank_glob_install_without_prefix(
-  INPUT_PREFIX "${CMAKE_SOURCE_DIR}/third-party/bpptree/"
-  PATTERN "${CMAKE_SOURCE_DIR}/third-party/bpptree/include/*"
-)
-
 jank_glob_install_without_prefix(
   INPUT_PREFIX "${CMAKE_SOURCE_DIR}/third-party/folly/"
   OUTPUT_PREFIX "include/"
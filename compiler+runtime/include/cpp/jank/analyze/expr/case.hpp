@@ -1,6 +1,7 @@
 #pragma once
 
 #include <jank/analyze/expression.hpp>
+#include <jank/option.hpp>
 
 namespace jank::analyze::expr
 {
@@ -8,6 +9,20 @@ namespace jank::analyze::expr
 
   using case_ptr = runtime::native_box<struct case_>;
 
+  /* How the value is turned into a key and how a matching key is checked against its test
+   * constant. These correspond to the `case*` forms the `case` macro generates. */
+  enum class case_test_type : uint8_t
+  {
+    /* The legacy form, where each branch checks the value itself. */
+    unchecked,
+    /* Every test is an integer and the key is the value itself, shifted and masked. */
+    integer,
+    /* Every test is a keyword. Keywords are interned, so the check is by identity. */
+    keyword,
+    /* Anything else. The key is the value's hash and the check is by equality. */
+    hash
+  };
+
   struct case_ : expression
   {
     static constexpr expression_kind expr_kind{ expression_kind::case_ };
@@ -20,7 +35,9 @@ namespace jank::analyze::expr
           native_integer mask,
           expression_ptr default_expr,
           native_vector<native_integer> &&keys,
-          native_vector<expression_ptr> &&exprs);
+          native_vector<expression_ptr> &&exprs,
+          case_test_type test_type,
+          native_vector<option<expression_ptr>> &&tests);
 
     void propagate_position(expression_position const pos) override;
     runtime::object_ptr to_runtime_data() const override;
@@ -31,5 +48,9 @@ namespace jank::analyze::expr
     expression_ptr default_expr{};
     native_vector<native_integer> keys{};
     native_vector<expression_ptr> exprs{};
+    case_test_type test_type{};
+    /* One per key. A key without a test belongs to constants whose hashes collide, so its
+     * expression does the checking. These are always literals. */
+    native_vector<option<expression_ptr>> tests{};
   };
 }
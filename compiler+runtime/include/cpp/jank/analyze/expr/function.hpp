@@ -18,7 +18,7 @@ namespace jank::analyze::expr
 {
   using function_ptr = runtime::native_box<struct function>;
 
-  struct function_context : gc
+  struct function_context : util::arena_object
   {
     static constexpr native_bool pointer_free{ true };
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <jank/runtime/object.hpp>
+#include <jank/util/arena.hpp>
 
 namespace jank::analyze
 {
@@ -103,7 +104,8 @@ namespace jank::analyze
   }
 
   /* Common base class for every expression. */
-  struct expression : gc
+  /* Expressions are arena allocated while an analyze::allocation_scope is active. */
+  struct expression : util::arena_object
   {
     static constexpr native_bool pointer_free{ false };
 
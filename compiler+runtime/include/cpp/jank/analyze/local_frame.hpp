@@ -1,6 +1,7 @@
 #pragma once
 
 #include <jank/option.hpp>
+#include <jank/util/arena.hpp>
 #include <jank/runtime/obj/symbol.hpp>
 
 namespace jank::runtime
@@ -55,7 +56,7 @@ namespace jank::analyze
 
   using local_binding_ptr = runtime::native_box<local_binding>;
 
-  struct local_frame : gc
+  struct local_frame : util::arena_object
   {
     enum class frame_type : uint8_t
     {
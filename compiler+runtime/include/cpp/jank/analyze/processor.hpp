@@ -158,11 +158,39 @@ namespace jank::analyze
                                         option<expr::function_context_ptr> const &,
                                         native_bool)>;
 
+    /* What we know about each var we've analyzed a def for. Expressions don't outlive their
+     * allocation_scope, so anything later forms need is copied out into here. */
+    struct var_info
+    {
+      expression_kind kind{};
+    };
+
     native_unordered_map<runtime::obj::symbol_ptr, special_function_type> specials;
-    native_unordered_map<runtime::var_ptr, expression_ptr> vars;
+    native_unordered_map<runtime::var_ptr, var_info> vars;
     /* TODO: Remove this. */
     runtime::context &rt_ctx;
     local_frame_ptr root_frame;
     native_deque<runtime::object_ptr> macro_expansions;
   };
+
+  /* Expressions, local frames, and function contexts are bump allocated while one of these
+   * is active and are all released together when it ends. Generally, this is one scope per
+   * top-level form, or per module when we're compiling, since the whole module is generated
+   * at the end. Scopes nest, so a `require` while evaluating a form gets its own arena. */
+  struct allocation_scope
+  {
+    allocation_scope(processor &an_prc);
+    allocation_scope(allocation_scope const &) = delete;
+    allocation_scope(allocation_scope &&) = delete;
+    ~allocation_scope();
+
+    allocation_scope &operator=(allocation_scope const &) = delete;
+    allocation_scope &operator=(allocation_scope &&) = delete;
+
+    processor &an_prc;
+    /* Wrapping a top-level expression for evaluation re-parents the root frame onto the
+     * wrapper's fn frame, which lives in the arena, so we need to put it back. */
+    option<local_frame_ptr> root_parent;
+    util::arena_scope allocations;
+  };
 }
@@ -96,18 +96,20 @@ extern "C"
                               jank_object_ptr a8,
                               jank_object_ptr a9,
                               jank_object_ptr a10);
-  jank_object_ptr jank_call11(jank_object_ptr f,
-                              jank_object_ptr a1,
-                              jank_object_ptr a2,
-                              jank_object_ptr a3,
-                              jank_object_ptr a4,
-                              jank_object_ptr a5,
-                              jank_object_ptr a6,
-                              jank_object_ptr a7,
-                              jank_object_ptr a8,
-                              jank_object_ptr a9,
-                              jank_object_ptr a10,
-                              jank_object_ptr rest);
+  /* Calls with more than 10 args pass them all in an array owned by the caller. */
+  jank_object_ptr
+  jank_call_array(jank_object_ptr f, jank_object_ptr const *args, uint64_t arg_count);
+  /* Calls through a multimethod inline cache. The site is zero initialized storage for a
+   * multi_function::call_site, owned by the caller. */
+  jank_object_ptr jank_call_site(void *site, jank_object_ptr f, uint64_t arity, ...);
+  /* The same, for protocol fns, with a protocol_function::call_site. */
+  jank_object_ptr jank_protocol_call_site(void *site, jank_object_ptr f, uint64_t arity, ...);
+  /* Looks up a keyword, caching where its field is for the last record type seen. The site
+   * is zero initialized storage for a record::lookup_site. The fallback may be null. */
+  jank_object_ptr jank_keyword_lookup_site(void *site,
+                                           jank_object_ptr key,
+                                           jank_object_ptr m,
+                                           jank_object_ptr fallback);
 
   jank_object_ptr jank_nil();
   jank_object_ptr jank_true();
@@ -127,7 +129,7 @@ extern "C"
   jank_arity_flags jank_function_build_arity_flags(uint8_t highest_fixed_arity,
                                                    jank_native_bool is_variadic,
                                                    jank_native_bool is_variadic_ambiguous);
-  jank_object_ptr jank_function_create(jank_arity_flags arity_flags);
+  jank_object_ptr jank_function_create(jank_arity_flags arity_flags, char const *name);
   void jank_function_set_arity0(jank_object_ptr fn, jank_object_ptr (*f)());
   void jank_function_set_arity1(jank_object_ptr fn, jank_object_ptr (*f)(jank_object_ptr));
   void jank_function_set_arity2(jank_object_ptr fn,
@@ -262,6 +264,7 @@ extern "C"
                                                    jank_native_integer mask);
 
   void jank_set_meta(jank_object_ptr o, jank_object_ptr meta);
+  void jank_function_set_code_owner(jank_object_ptr fn, void *owner);
 
   void jank_throw(jank_object_ptr o);
   jank_object_ptr
@@ -270,6 +273,9 @@ extern "C"
   void jank_profile_enter(char const *label);
   void jank_profile_exit(char const *label);
   void jank_profile_report(char const *label);
+  void *jank_profile_alloc_intern(char const *fn_name);
+  void *jank_profile_alloc_push(void *fn);
+  void jank_profile_alloc_pop(void *previous_fn);
 
 #ifdef __cplusplus
 }
@@ -3,6 +3,7 @@
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/LLVMContext.h>
+#include <llvm/Passes/PassBuilder.h>
 #include <llvm/Passes/StandardInstrumentations.h>
 #include <llvm/Analysis/LoopAnalysisManager.h>
 #include <llvm/Analysis/CGSCCPassManager.h>
@@ -43,6 +44,11 @@ namespace jank::analyze
   }
 }
 
+namespace jank::jit
+{
+  struct code_owner;
+}
+
 namespace jank::codegen
 {
   using namespace jank::runtime;
@@ -66,24 +72,34 @@ namespace jank::codegen
     std::unique_ptr<llvm::IRBuilder<>> builder;
     llvm::Value *nil{};
     llvm::BasicBlock *global_ctor_block{};
+    /* When set, every function object created by this module references the owner, so
+     * that the module can be unloaded once they're all gone. This is only for modules
+     * which are evaluated in this process, since the owner's address is baked in. */
+    jit::code_owner *code_owner{};
 
+    /* These are only needed while generating the module, so they come from the same arena
+     * as the expressions we're generating, if there is one. */
     /* TODO: Is this needed, given lifted constants? */
-    native_unordered_map<runtime::object_ptr,
-                         llvm::Value *,
-                         std::hash<runtime::object_ptr>,
-                         very_equal_to>
+    util::arena_unordered_map<runtime::object_ptr,
+                              llvm::Value *,
+                              std::hash<runtime::object_ptr>,
+                              very_equal_to>
       literal_globals;
-    native_unordered_map<obj::symbol_ptr, llvm::Value *> var_globals;
-    native_unordered_map<native_persistent_string, llvm::Value *> c_string_globals;
+    util::arena_unordered_map<obj::symbol_ptr, llvm::Value *> var_globals;
+    util::arena_unordered_map<native_persistent_string, llvm::Value *> c_string_globals;
 
-    /* Optimization details. */
-    std::unique_ptr<llvm::FunctionPassManager> fpm;
+    /* Optimization details. The pass builder needs to outlive the analysis managers'
+     * use, since the analyses it registers refer back to it. */
     std::unique_ptr<llvm::LoopAnalysisManager> lam;
     std::unique_ptr<llvm::FunctionAnalysisManager> fam;
     std::unique_ptr<llvm::CGSCCAnalysisManager> cgam;
     std::unique_ptr<llvm::ModuleAnalysisManager> mam;
     std::unique_ptr<llvm::PassInstrumentationCallbacks> pic;
     std::unique_ptr<llvm::StandardInstrumentations> si;
+    std::unique_ptr<llvm::PassBuilder> pb;
+    /* Run once the whole module has been generated, so that it can work across the
+     * functions within it. */
+    std::unique_ptr<llvm::ModulePassManager> mpm;
   };
 
   struct llvm_processor
@@ -129,6 +145,9 @@ namespace jank::codegen
     void create_function();
     void create_function(analyze::expr::function_arity const &arity);
     void create_global_ctor() const;
+    void optimize() const;
+    llvm::Value *gen_alloc_profile_push() const;
+    void gen_alloc_profile_pops(llvm::Value *previous_fn) const;
     llvm::GlobalVariable *create_global_var(native_persistent_string const &name) const;
 
     llvm::Value *gen_global(runtime::obj::nil_ptr) const;
@@ -151,6 +170,6 @@ namespace jank::codegen
     analyze::expr::function_ptr root_fn{};
     llvm::Function *fn{};
     std::unique_ptr<reusable_context> ctx;
-    native_unordered_map<obj::symbol_ptr, llvm::Value *> locals;
+    util::arena_unordered_map<obj::symbol_ptr, llvm::Value *> locals;
   };
 }
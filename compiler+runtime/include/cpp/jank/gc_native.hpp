@@ -0,0 +1,5 @@
+#pragma once
+
+#include <jank/c_api.h>
+
+jank_object_ptr jank_load_jank_gc_native();
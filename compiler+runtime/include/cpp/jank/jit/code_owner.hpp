@@ -0,0 +1,69 @@
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <llvm/ExecutionEngine/Orc/Core.h>
+
+#include <jank/type.hpp>
+
+namespace jank::jit
+{
+  struct code_registry;
+
+  /* Each module we JIT compile for evaluation is added under its own ORC resource tracker,
+   * so its code and data can be removed without touching anything else. That code is only
+   * reachable through the function objects which the module creates, so each of them holds
+   * onto the module's owner. Once the last of them has been collected, the owner's
+   * finalizer lets the registry know that the module can go.
+   *
+   * Function objects keep themselves alive for the duration of each call, so we never
+   * unload code which is still running. */
+  struct code_owner : gc_cleanup
+  {
+    code_owner(code_registry &registry, size_t id);
+    ~code_owner() override;
+
+    /* Directly linked code calls into other modules without going through their function
+     * objects, so those modules need to stay loaded for as long as this one is. This is
+     * only called while generating the module, before it's loaded. */
+    void depend_on(code_owner *other);
+
+    struct dependency
+    {
+      code_owner *owner{};
+      dependency *next{};
+    };
+
+    code_registry &registry;
+    size_t id{};
+    dependency *dependencies{};
+  };
+
+  struct code_registry
+  {
+    code_owner *create_owner();
+    void track(code_owner const &owner, llvm::orc::ResourceTrackerSP tracker);
+
+    /* Called from finalizers, which may run on any thread, in the middle of any allocation.
+     * This only queues the module; nothing is removed until the next `reclaim`. */
+    void release(size_t id);
+
+    /* Removes every queued module from the JIT. This needs to happen at a point where
+     * we're not in the middle of linking, such as just before adding a new module.
+     * Returns how many modules were removed. */
+    size_t reclaim();
+
+    /* The number of modules which are still loaded and could be unloaded later. */
+    size_t tracked_count();
+    size_t reclaimed_count();
+
+    std::mutex mutex;
+    size_t next_id{};
+    size_t total_reclaimed{};
+    /* These hold ref counted LLVM objects, so they can't live in GC memory. */
+    std::unordered_map<size_t, llvm::orc::ResourceTrackerSP> trackers;
+    std::vector<size_t> pending;
+  };
+}
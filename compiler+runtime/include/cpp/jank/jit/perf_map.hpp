@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdio>
+#include <mutex>
+
+#include <jank/type.hpp>
+
+namespace llvm::orc
+{
+  class LLJIT;
+}
+
+namespace jank::jit
+{
+  /* Linux perf can resolve JIT compiled code if the process writes a symbol map to
+   * /tmp/perf-<pid>.map, with one `<start> <size> <name>` line per function. This is
+   * the simplest format perf understands and it requires no cooperation from the
+   * ORC runtime. We hook into the JIT's object linking layer, so everything which goes
+   * through `load_ir_module`, `load_bitcode`, or `load_object` will be covered.
+   *
+   * Symbol names are demunged back into `ns/name` form where we can figure out the
+   * owning ns, so flame graphs are readable. */
+  struct perf_map
+  {
+    perf_map();
+    perf_map(perf_map const &) = delete;
+    perf_map(perf_map &&) = delete;
+    ~perf_map();
+
+    void write(uintptr_t address, size_t size, native_persistent_string_view const &name);
+
+    std::FILE *file{};
+    std::mutex mutex;
+  };
+
+  /* Turns a munged JIT symbol, such as `clojure_core_map_123_2`, into something more
+   * meaningful, such as `clojure.core/map [arity 2]`. If the symbol doesn't look like a
+   * jank function, it's just demunged. */
+  native_persistent_string demunge_symbol(native_persistent_string_view const &name);
+
+  /* Hooks the perf map into whichever object linking layer the JIT is using. */
+  void register_perf_map(llvm::orc::LLJIT &jit, perf_map &map);
+
+  /* Registers JIT compiled objects with GDB (and LLDB), through the standard
+   * __jit_debug_register_code interface. */
+  void register_debugger_support(llvm::orc::LLJIT &jit);
+}
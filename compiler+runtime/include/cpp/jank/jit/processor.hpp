@@ -4,8 +4,11 @@
 #include <memory>
 
 #include <clang/Interpreter/Interpreter.h>
+#include <llvm/Target/TargetMachine.h>
 
 #include <jank/result.hpp>
+#include <jank/jit/code_owner.hpp>
+#include <jank/jit/perf_map.hpp>
 #include <jank/util/cli.hpp>
 #include <jank/util/string_builder.hpp>
 
@@ -33,6 +36,10 @@ namespace jank::jit
     void load_dynamic_library(native_persistent_string const &path) const;
     void load_ir_module(std::unique_ptr<llvm::Module> m,
                         std::unique_ptr<llvm::LLVMContext> llvm_ctx) const;
+    /* Loads the module such that it will be unloaded once the owner has been collected. */
+    void load_ir_module(std::unique_ptr<llvm::Module> m,
+                        std::unique_ptr<llvm::LLVMContext> llvm_ctx,
+                        code_owner const &owner) const;
     void load_bitcode(native_persistent_string const &module,
                       native_persistent_string_view const &bitcode) const;
 
@@ -55,8 +62,22 @@ namespace jank::jit
     load_dynamic_libs(native_vector<native_persistent_string> const &libs) const;
     option<native_persistent_string> find_dynamic_lib(native_persistent_string const &lib) const;
 
+    /* Only present when perf map support was requested. This is declared before the
+     * interpreter so that it outlives the JIT which writes to it. */
+    std::unique_ptr<perf_map> perf_symbols;
     std::unique_ptr<clang::Interpreter> interpreter;
+    /* This is mutable for the same reason the interpreter is behind a pointer; loading
+     * code changes the JIT, but not anything we'd consider part of the processor. */
+    mutable code_registry unloadable_code;
     native_integer optimization_level{};
+    /* The CPU we generate code for, with `native` resolved to the host CPU's name. */
+    native_persistent_string target_cpu;
+    /* Whether generated calls to functions held by vars skip the var. See `--direct-linking`. */
+    native_bool direct_linking{};
+    /* This isn't the JIT's own target machine, which we can't configure, but we put its
+     * CPU and features on every function we JIT compile. We also use it to tune our
+     * optimization passes and to write object files when compiling. */
+    std::unique_ptr<llvm::TargetMachine> target_machine;
     native_vector<std::filesystem::path> library_dirs;
   };
 }
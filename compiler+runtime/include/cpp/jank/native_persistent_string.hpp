@@ -163,7 +163,8 @@ namespace jank
 
     constexpr native_persistent_string(native_persistent_string const &s,
                                        size_type const pos,
-                                       size_type count)
+                                       size_type count,
+                                       native_bool const always_share = false)
     {
       auto const s_length(s.size());
       if(s_length < pos) [[unlikely]]
@@ -183,7 +184,7 @@ namespace jank
        * not worth keeping the original string alive just to share the substring. In that case,
        * we deep copy. This prevents relatively small (yet still categorically large) substrings
        * from a large file keeping that whole file in memory as long as the substrings live. */
-      else if((s_length - count) > max_shared_difference)
+      else if(!always_share && (s_length - count) > max_shared_difference)
       {
         init_large_owned(s.store.large.data + pos, count);
       }
@@ -495,6 +496,15 @@ namespace jank
       return { *this, pos, count };
     }
 
+    /* Like substr, but large substrings share this string's memory no matter how much of it
+     * they keep alive. This is for when the caller knows the whole string is being kept
+     * around anyway, such as slices of an input buffer. */
+    constexpr native_persistent_string
+    shared_substr(size_type const pos = 0, size_type const count = npos) const
+    {
+      return { *this, pos, count, true };
+    }
+
     /*** Mutations. ***/
     constexpr native_persistent_string &operator=(native_persistent_string const &rhs)
     {
@@ -857,7 +867,7 @@ namespace jank
     }
 
     [[gnu::always_inline, gnu::flatten, gnu::hot]]
-    constexpr void init_large_fill(value_type const fill, uint8_t const size) noexcept
+    constexpr void init_large_fill(value_type const fill, size_type const size) noexcept
     {
       assert(max_small_size < size);
       store.large.data = std::assume_aligned<sizeof(pointer_type)>(store.allocate(size + 1));
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+
+#include <jank/type.hpp>
+
+namespace jank::util::cli
+{
+  struct options;
+}
+
+namespace jank::runtime
+{
+  /* This header is included by native_box.hpp, which is included by object.hpp, so
+   * we can't include object.hpp here. */
+  enum class object_type : uint8_t;
+}
+
+/* An opt-in allocation profiler. Every runtime object goes through make_box, which reports
+ * here whenever this is enabled. Allocations are sampled, every Nth allocation on each
+ * thread is recorded and weighted by N, so that the overhead can be tuned down for
+ * production processes.
+ *
+ * Allocations are tracked per object type and, if the code was compiled while profiling
+ * was enabled, per allocating jank function. The latter relies on codegen emitting calls
+ * to push/pop the current function around each function body. */
+namespace jank::profile::allocation
+{
+  struct stats
+  {
+    uint64_t count{};
+    uint64_t bytes{};
+  };
+
+  struct function_stats
+  {
+    native_persistent_string name;
+    stats totals;
+  };
+
+  /* Generated code refers to its function by a handle, which it interns by name once, when
+   * its module is loaded. Handles are never freed, so stats stay with the right function
+   * even after its code has been unloaded and the memory which held its name reused. */
+  using function_handle = function_stats *;
+
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  extern std::atomic<native_bool> enabled;
+
+  void configure(util::cli::options const &opts);
+  native_bool is_enabled();
+
+  void record(runtime::object_type type, size_t size);
+
+  [[gnu::always_inline, gnu::hot]]
+  inline void sample(runtime::object_type const type, size_t const size)
+  {
+    if(enabled.load(std::memory_order_relaxed)) [[unlikely]]
+    {
+      record(type, size);
+    }
+  }
+
+  function_handle intern_function(char const *name);
+  function_handle push_function(function_handle fn);
+  void pop_function(function_handle previous);
+  function_handle current_function();
+
+  /* Generated code only pops its function when it returns, so an exception unwinding
+   * through jank frames leaves the current function behind. Anything which catches those
+   * exceptions and carries on restores it with one of these. */
+  struct function_scope
+  {
+    function_scope();
+    function_scope(function_scope const &) = delete;
+    function_scope(function_scope &&) = delete;
+    ~function_scope();
+
+    function_scope &operator=(function_scope const &) = delete;
+    function_scope &operator=(function_scope &&) = delete;
+
+    function_handle previous{};
+  };
+
+  stats type_stats(runtime::object_type type);
+  native_vector<function_stats> all_function_stats();
+  void reset();
+  void report();
+}
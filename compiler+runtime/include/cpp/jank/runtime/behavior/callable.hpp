@@ -74,18 +74,9 @@ namespace jank::runtime
                           object_ptr,
                           object_ptr,
                           object_ptr);
-  object_ptr dynamic_call(object_ptr source,
-                          object_ptr,
-                          object_ptr,
-                          object_ptr,
-                          object_ptr,
-                          object_ptr,
-                          object_ptr,
-                          object_ptr,
-                          object_ptr,
-                          object_ptr,
-                          object_ptr,
-                          obj::persistent_list_ptr);
+  /* Calls with more args than max_params, and any caller which already has its args in an
+   * array, pass them as a span. Only args which land in a variadic rest param get copied. */
+  object_ptr dynamic_call(object_ptr source, object_ptr const *args, size_t arg_count);
 
   object_ptr apply_to(object_ptr source, object_ptr args);
 
@@ -171,6 +162,19 @@ namespace jank::runtime
        */
       virtual arity_flag_t get_arity_flags() const;
 
+      /* JIT compiled code is unloaded once every function object which references it has been
+       * collected. Function objects use this to stay reachable until their code has returned,
+       * rather than letting the compiler drop `this` before a tail call. */
+      [[gnu::always_inline]]
+      static object_ptr keep_alive(void const * const self, object_ptr const ret)
+      {
+        GC_reachable_here(self);
+        return ret;
+      }
+
+      /* Extracts the number of fixed params which come before the rest param. */
+      static constexpr arity_flag_t fixed_arity_mask{ 0b00001111 };
+
       static constexpr arity_flag_t mask_variadic_arity(uint8_t const pos)
       {
         return (0b10000000 | pos);
@@ -6,4 +6,11 @@ namespace jank::runtime::behavior
   concept derefable = requires(T * const t) {
     { t->deref() } -> std::convertible_to<object_ptr>;
   };
+
+  /* Things which may need to wait for their value, such as promises, and which can give
+   * up after a timeout. */
+  template <typename T>
+  concept blocking_derefable = requires(T * const t) {
+    { t->deref(native_integer{}, object_ptr{}) } -> std::convertible_to<object_ptr>;
+  };
 }
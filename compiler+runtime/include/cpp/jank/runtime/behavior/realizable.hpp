@@ -0,0 +1,10 @@
+#pragma once
+
+namespace jank::runtime::behavior
+{
+  /* Things which produce their value later, such as delays and lazy sequences. */
+  template <typename T>
+  concept realizable = requires(T const * const t) {
+    { t->is_realized() } -> std::convertible_to<native_bool>;
+  };
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <jank/runtime/object.hpp>
+#include <jank/result.hpp>
+
+namespace jank::util
+{
+  struct string_builder;
+}
+
+namespace jank::runtime::obj
+{
+  using transient_vector_ptr = native_box<struct transient_vector>;
+  using writer_ptr = native_box<struct writer>;
+}
+
+/* Bencode, as used by nREPL and BitTorrent. This lives in the runtime so that libraries,
+ * like jank.data.bencode, and the nREPL server can share one implementation.
+ *
+ * https://wiki.theory.org/BitTorrentSpecification#Bencoding */
+namespace jank::runtime::bencode
+{
+  enum class decode_error_reason : uint8_t
+  {
+    invalid_data,
+    incomplete_data
+  };
+
+  struct decode_error
+  {
+    native_persistent_string message;
+    decode_error_reason reason{};
+  };
+
+  /* The decoded value, along with the offset in the input just past it. */
+  using decode_result = result<std::pair<object_ptr, size_t>, decode_error>;
+
+  /* A decoder can be given its input in pieces. When the input runs out partway through a
+   * value, decode_some returns incomplete_data and the decoder holds onto everything read so
+   * far, including any half read integer or string, so the next call picks up from there
+   * instead of starting over.
+   *
+   * Byte strings which lie entirely within one piece of input share that input's memory,
+   * rather than being copied. Only strings split across pieces need to be put back together.
+   * Dicts are built as array maps, which are promoted to hash maps as they grow. */
+  struct decoder : gc
+  {
+    enum class state : uint8_t
+    {
+      value,
+      integer,
+      string_length,
+      string_body
+    };
+
+    /* Exactly one of list and dict is set. */
+    struct partial_collection
+    {
+      obj::transient_vector_ptr list;
+      object_ptr dict;
+      object_ptr next_key;
+    };
+
+    /* Decodes the next value, starting at the offset. */
+    decode_result decode_some(native_persistent_string const &input, size_t offset);
+
+    /* Whether a value has been started, but not finished. */
+    native_bool is_partial() const;
+
+    /* After invalid data, there's no telling where the next value starts, so we drop
+     * everything and start fresh. */
+    decode_error invalid(native_persistent_string const &message);
+
+    native_vector<partial_collection> stack;
+    state st{ state::value };
+    native_integer integer{};
+    native_bool negative{};
+    native_bool has_digits{};
+    size_t remaining{};
+    native_vector<char> partial_string;
+  };
+
+  /* Decodes the first value in a complete input. Empty input decodes to nil. */
+  result<object_ptr, decode_error> decode(native_persistent_string const &input);
+
+  /* Writes straight into the builder. When that's a writer's buffer, large values stream out
+   * through it as it fills, rather than being built up as one string first.
+   *
+   * Keywords and symbols are written as strings, since bencode has nothing else. Like
+   * nREPL, nil is written as an empty list. Dict keys are sorted by their bytes. */
+  void encode(util::string_builder &buff, object_ptr o);
+  native_persistent_string encode(object_ptr o);
+
+  /* Encodes into the writer's own buffer, holding its lock, so values encoded from separate
+   * threads are never interleaved. */
+  void encode_to(obj::writer_ptr w, object_ptr o);
+}
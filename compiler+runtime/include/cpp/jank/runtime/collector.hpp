@@ -0,0 +1,61 @@
+#pragma once
+
+#include <jank/type.hpp>
+
+namespace jank::util::cli
+{
+  struct options;
+}
+
+/* Tuning and telemetry for Boehm. The collector can't be named `gc` here, since that
+ * would shadow the `gc` base type from gc_cpp for all of our objects. */
+namespace jank::runtime::collector
+{
+  struct stats
+  {
+    /* Collections completed since startup. */
+    native_integer collections{};
+    /* Stop-the-world pauses, in nanoseconds. */
+    native_integer pause_count{};
+    native_integer pause_total_ns{};
+    native_integer pause_max_ns{};
+    native_integer heap_size{};
+    native_integer free_bytes{};
+    native_integer bytes_since_gc{};
+    native_integer total_bytes{};
+  };
+
+  /* Some settings, like the parallel marker count, only have an effect if they're set
+   * before the GC is initialized, which is before we can parse our CLI args. So we pick
+   * those out of argv by hand. This must not allocate. */
+  void pre_configure(int argc, char const **argv);
+
+  /* Applies the remaining tuning options and installs the event callbacks we use
+   * to measure pause times. */
+  void configure(util::cli::options const &opts);
+
+  stats current_stats();
+  void collect();
+
+  /* Threads we start ourselves can only register with the GC once this has been called
+   * from an already registered thread, such as the main thread. It's safe to call it
+   * more than once. */
+  void allow_thread_registration();
+
+  /* Registers the current thread with the GC for the lifetime of this object, so the
+   * GC scans its stack and stops it during collections. A thread must not touch any
+   * GC memory before it's registered, or after it's unregistered. */
+  struct thread_registration
+  {
+    thread_registration();
+    thread_registration(thread_registration const &) = delete;
+    thread_registration(thread_registration &&) = delete;
+    ~thread_registration();
+
+    thread_registration &operator=(thread_registration const &) = delete;
+    thread_registration &operator=(thread_registration &&) = delete;
+
+    /* If the thread was already registered, we leave it for its owner to unregister. */
+    native_bool registered{};
+  };
+}
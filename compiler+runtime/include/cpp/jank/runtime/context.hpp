@@ -57,6 +57,9 @@ namespace jank::runtime
     option<ns_ptr> resolve_ns(obj::symbol_ptr const &);
     ns_ptr current_ns();
 
+    /* Writes out anything still buffered in this thread's *out* and *err*. */
+    void flush_output();
+
     /* Adds the current ns to unqualified symbols and resolves the ns of qualified symbols.
      * Does not intern. */
     obj::symbol_ptr qualify_symbol(obj::symbol_ptr const &) const;
@@ -153,6 +156,10 @@ namespace jank::runtime
     var_ptr loaded_libs_var{};
     var_ptr current_module_var{};
     var_ptr assert_var{};
+    var_ptr out_var{};
+    var_ptr err_var{};
+    var_ptr flush_on_newline_var{};
+    var_ptr agent_var{};
     var_ptr no_recur_var{};
     var_ptr gensym_env_var{};
 
@@ -15,7 +15,8 @@ namespace jank::runtime
   native_integer compare(object_ptr, object_ptr);
   native_bool is_identical(object_ptr lhs, object_ptr rhs);
 
-  native_persistent_string type(object_ptr o);
+  /* Records give their record type. Everything else gives the name of its object_type. */
+  object_ptr type(object_ptr o);
   native_bool is_nil(object_ptr o);
   native_bool is_true(object_ptr o);
   native_bool is_false(object_ptr o);
@@ -31,6 +32,10 @@ namespace jank::runtime
   object_ptr println(object_ptr args);
   object_ptr pr(object_ptr args);
   object_ptr prn(object_ptr args);
+  object_ptr newline();
+  object_ptr flush(object_ptr writer);
+  object_ptr string_writer();
+  native_bool is_writer(object_ptr o);
 
   obj::persistent_string_ptr subs(object_ptr s, object_ptr start);
   obj::persistent_string_ptr subs(object_ptr s, object_ptr start, object_ptr end);
@@ -57,6 +62,7 @@ namespace jank::runtime
 
   object_ptr atom(object_ptr o);
   object_ptr deref(object_ptr o);
+  object_ptr blocking_deref(object_ptr o, object_ptr timeout_ms, object_ptr timeout_val);
   object_ptr swap_atom(object_ptr atom, object_ptr fn);
   object_ptr swap_atom(object_ptr atom, object_ptr fn, object_ptr a1);
   object_ptr swap_atom(object_ptr atom, object_ptr fn, object_ptr a1, object_ptr a2);
@@ -77,11 +83,15 @@ namespace jank::runtime
   object_ptr vswap(object_ptr v, object_ptr fn, object_ptr args);
   object_ptr vreset(object_ptr v, object_ptr new_val);
 
+  object_ptr promise();
+  object_ptr deliver(object_ptr p, object_ptr val);
+
   void push_thread_bindings(object_ptr o);
   void pop_thread_bindings();
   object_ptr get_thread_bindings();
 
   object_ptr force(object_ptr o);
+  native_bool is_realized(object_ptr o);
 
   object_ptr tagged_literal(object_ptr tag, object_ptr form);
   native_bool is_tagged_literal(object_ptr o);
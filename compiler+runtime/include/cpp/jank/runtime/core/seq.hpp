@@ -146,6 +146,9 @@ namespace jank::runtime
   object_ptr repeat(object_ptr n, object_ptr val);
 
   object_ptr sort(object_ptr coll);
+  object_ptr sort(object_ptr comp, object_ptr coll);
+  object_ptr sort_by(object_ptr keyfn, object_ptr coll);
+  object_ptr sort_by(object_ptr keyfn, object_ptr comp, object_ptr coll);
 
   object_ptr shuffle(object_ptr coll);
 }
@@ -16,8 +16,8 @@ namespace jank::runtime::detail
   struct native_persistent_array_map
   {
     /* Array maps are fast only for a small number of keys. Clojure JVM uses a threshold of 8
-     * k/v pairs, thus 16 elements. We follow the same. */
-    /* TODO: Benchmark difference thresholds. */
+     * k/v pairs, thus 16 elements. We follow the same. The "array map threshold" test case
+     * compares lookups against hash maps of the same size, if this needs revisiting. */
     static constexpr size_t max_size{ 8 };
 
     native_persistent_array_map() = default;
@@ -41,6 +41,10 @@ namespace jank::runtime::detail
 
     object_ptr find(object_ptr const key) const;
 
+    /* Returns the index of the key's slot, or `length` if it's not present. The value
+     * is in the following slot. */
+    size_t index_of(object_ptr const key) const;
+
     native_hash to_hash() const;
 
     struct iterator
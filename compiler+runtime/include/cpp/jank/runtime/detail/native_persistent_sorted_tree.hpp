@@ -0,0 +1,478 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+
+#include <jank/runtime/object.hpp>
+
+namespace jank::runtime::detail
+{
+  /* Sorted maps and sets are backed by a persistent AVL tree. Every node is allocated by
+   * the GC, so the nodes are traced, which keeps their keys and values alive, and
+   * they're reclaimed as soon as no version of the tree refers to them. There's no
+   * reference counting; persistent updates just copy the path to the changed node.
+   *
+   * Transients reuse the same nodes. Each node remembers which transient created it, via
+   * an edit token, and only that transient may change it in place. Any other node is
+   * copied first, so the persistent tree the transient came from is never changed. */
+  template <typename T>
+  struct sorted_tree_node
+  {
+    T value;
+    sorted_tree_node *left{};
+    sorted_tree_node *right{};
+    void const *edit{};
+    uint8_t height{ 1 };
+  };
+
+  /* Iterators keep a stack of the nodes they still need to visit. The stack is an
+   * immutable list, so copying an iterator, which sequences do all the time, is just
+   * copying a pointer. */
+  template <typename T>
+  struct sorted_tree_frame
+  {
+    sorted_tree_node<T> const *node{};
+    sorted_tree_frame const *next{};
+  };
+
+  template <typename T>
+  struct sorted_tree_iterator
+  {
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = value_type const *;
+    using reference = value_type const &;
+    using node_type = sorted_tree_node<T>;
+    using frame_type = sorted_tree_frame<T>;
+
+    static frame_type const *push_left(node_type const *n, frame_type const *stack)
+    {
+      for(; n != nullptr; n = n->left)
+      {
+        stack = new(GC) frame_type{ n, stack };
+      }
+      return stack;
+    }
+
+    reference operator*() const
+    {
+      return stack->node->value;
+    }
+
+    pointer operator->() const
+    {
+      return &stack->node->value;
+    }
+
+    sorted_tree_iterator &operator++()
+    {
+      stack = push_left(stack->node->right, stack->next);
+      return *this;
+    }
+
+    native_bool operator==(sorted_tree_iterator const &rhs) const
+    {
+      return current() == rhs.current();
+    }
+
+    native_bool operator!=(sorted_tree_iterator const &rhs) const
+    {
+      return current() != rhs.current();
+    }
+
+    node_type const *current() const
+    {
+      return stack ? stack->node : nullptr;
+    }
+
+    frame_type const *stack{};
+  };
+
+  /* The tree algorithms, shared by persistent and transient trees. Anything which
+   * changes the tree returns the new subtree root. A null edit token means we're making
+   * a persistent change, so every changed node is a copy. */
+  template <typename T, typename KeyOf, typename Compare>
+  struct sorted_tree_ops
+  {
+    using node_type = sorted_tree_node<T>;
+
+    static uint8_t height(node_type const * const n)
+    {
+      return n ? n->height : 0;
+    }
+
+    static node_type *editable(node_type * const n, void const * const edit)
+    {
+      if(edit != nullptr && n->edit == edit)
+      {
+        return n;
+      }
+      return new(GC) node_type{ n->value, n->left, n->right, edit, n->height };
+    }
+
+    static void update_height(node_type * const n)
+    {
+      n->height = 1 + std::max(height(n->left), height(n->right));
+    }
+
+    static node_type *rotate_right(node_type * const n, void const * const edit)
+    {
+      auto const l(editable(n->left, edit));
+      n->left = l->right;
+      l->right = n;
+      update_height(n);
+      update_height(l);
+      return l;
+    }
+
+    static node_type *rotate_left(node_type * const n, void const * const edit)
+    {
+      auto const r(editable(n->right, edit));
+      n->right = r->left;
+      r->left = n;
+      update_height(n);
+      update_height(r);
+      return r;
+    }
+
+    /* The node must already be editable. */
+    static node_type *balance(node_type * const n, void const * const edit)
+    {
+      update_height(n);
+      auto const factor(static_cast<int>(height(n->left)) - static_cast<int>(height(n->right)));
+      if(factor > 1)
+      {
+        if(height(n->left->left) < height(n->left->right))
+        {
+          n->left = rotate_left(editable(n->left, edit), edit);
+        }
+        return rotate_right(n, edit);
+      }
+      if(factor < -1)
+      {
+        if(height(n->right->right) < height(n->right->left))
+        {
+          n->right = rotate_right(editable(n->right, edit), edit);
+        }
+        return rotate_left(n, edit);
+      }
+      return n;
+    }
+
+    static T const *find(node_type const *n, object_ptr const key)
+    {
+      while(n != nullptr)
+      {
+        auto const c(Compare{}(key, KeyOf{}(n->value)));
+        if(c == 0)
+        {
+          return &n->value;
+        }
+        n = c < 0 ? n->left : n->right;
+      }
+      return nullptr;
+    }
+
+    /* When the key is already present, the value is only replaced if `replace` is set.
+     * Sets keep their existing element, like Clojure. */
+    static node_type *insert(node_type * const n,
+                             T const &value,
+                             native_bool const replace,
+                             void const * const edit,
+                             native_bool &added)
+    {
+      if(n == nullptr)
+      {
+        added = true;
+        return new(GC) node_type{ value, nullptr, nullptr, edit, 1 };
+      }
+
+      auto const c(Compare{}(KeyOf{}(value), KeyOf{}(n->value)));
+      if(c == 0)
+      {
+        if(!replace)
+        {
+          return n;
+        }
+        auto const ret(editable(n, edit));
+        ret->value = value;
+        return ret;
+      }
+      else if(c < 0)
+      {
+        auto const left(insert(n->left, value, replace, edit, added));
+        if(left == n->left && !added)
+        {
+          return n;
+        }
+        auto const ret(editable(n, edit));
+        ret->left = left;
+        return added ? balance(ret, edit) : ret;
+      }
+      else
+      {
+        auto const right(insert(n->right, value, replace, edit, added));
+        if(right == n->right && !added)
+        {
+          return n;
+        }
+        auto const ret(editable(n, edit));
+        ret->right = right;
+        return added ? balance(ret, edit) : ret;
+      }
+    }
+
+    static node_type *erase_min(node_type * const n, void const * const edit)
+    {
+      if(n->left == nullptr)
+      {
+        return n->right;
+      }
+      auto const ret(editable(n, edit));
+      ret->left = erase_min(n->left, edit);
+      return balance(ret, edit);
+    }
+
+    static node_type *
+    erase(node_type * const n, object_ptr const key, void const * const edit, native_bool &removed)
+    {
+      if(n == nullptr)
+      {
+        return nullptr;
+      }
+
+      auto const c(Compare{}(key, KeyOf{}(n->value)));
+      if(c < 0)
+      {
+        auto const left(erase(n->left, key, edit, removed));
+        if(!removed)
+        {
+          return n;
+        }
+        auto const ret(editable(n, edit));
+        ret->left = left;
+        return balance(ret, edit);
+      }
+      else if(c > 0)
+      {
+        auto const right(erase(n->right, key, edit, removed));
+        if(!removed)
+        {
+          return n;
+        }
+        auto const ret(editable(n, edit));
+        ret->right = right;
+        return balance(ret, edit);
+      }
+
+      removed = true;
+      if(n->left == nullptr)
+      {
+        return n->right;
+      }
+      if(n->right == nullptr)
+      {
+        return n->left;
+      }
+
+      /* Two children, so the next entry takes this node's place. */
+      auto successor(n->right);
+      while(successor->left != nullptr)
+      {
+        successor = successor->left;
+      }
+      auto const ret(editable(n, edit));
+      ret->value = successor->value;
+      ret->right = erase_min(n->right, edit);
+      return balance(ret, edit);
+    }
+  };
+
+  template <typename T, typename KeyOf, typename Compare>
+  struct native_transient_sorted_tree;
+
+  template <typename T, typename KeyOf, typename Compare>
+  struct native_persistent_sorted_tree
+  {
+    using ops = sorted_tree_ops<T, KeyOf, Compare>;
+    using node_type = sorted_tree_node<T>;
+    using value_type = T;
+    using iterator = sorted_tree_iterator<T>;
+    using const_iterator = iterator;
+    using transient_type = native_transient_sorted_tree<T, KeyOf, Compare>;
+
+    native_persistent_sorted_tree() = default;
+    native_persistent_sorted_tree(native_persistent_sorted_tree const &) = default;
+    native_persistent_sorted_tree(native_persistent_sorted_tree &&) noexcept = default;
+
+    native_persistent_sorted_tree(node_type * const root, size_t const length)
+      : root{ root }
+      , length{ length }
+    {
+    }
+
+    native_persistent_sorted_tree &operator=(native_persistent_sorted_tree const &) = default;
+    native_persistent_sorted_tree &operator=(native_persistent_sorted_tree &&) noexcept = default;
+
+    /* Returns null if the key isn't present. */
+    T const *find(object_ptr const key) const
+    {
+      return ops::find(root, key);
+    }
+
+    /* For maps. */
+    native_persistent_sorted_tree insert_or_assign(object_ptr const key, object_ptr const val) const
+    {
+      return insert(T{ key, val }, true);
+    }
+
+    /* For sets. */
+    native_persistent_sorted_tree insert_v(T const &value) const
+    {
+      return insert(value, false);
+    }
+
+    native_persistent_sorted_tree erase_key(object_ptr const key) const
+    {
+      native_bool removed{};
+      auto const new_root(ops::erase(root, key, nullptr, removed));
+      if(!removed)
+      {
+        return *this;
+      }
+      return { new_root, length - 1 };
+    }
+
+    transient_type transient() const
+    {
+      return { root, length };
+    }
+
+    iterator begin() const
+    {
+      return { iterator::push_left(root, nullptr) };
+    }
+
+    iterator end() const
+    {
+      return {};
+    }
+
+    size_t size() const
+    {
+      return length;
+    }
+
+    native_bool empty() const
+    {
+      return length == 0;
+    }
+
+    node_type *root{};
+    size_t length{};
+
+  private:
+    native_persistent_sorted_tree insert(T const &value, native_bool const replace) const
+    {
+      native_bool added{};
+      auto const new_root(ops::insert(root, value, replace, nullptr, added));
+      if(new_root == root)
+      {
+        return *this;
+      }
+      return { new_root, length + (added ? 1 : 0) };
+    }
+  };
+
+  template <typename T, typename KeyOf, typename Compare>
+  struct native_transient_sorted_tree
+  {
+    using ops = sorted_tree_ops<T, KeyOf, Compare>;
+    using node_type = sorted_tree_node<T>;
+    using value_type = T;
+    using iterator = sorted_tree_iterator<T>;
+    using const_iterator = iterator;
+    using persistent_type = native_persistent_sorted_tree<T, KeyOf, Compare>;
+
+    native_transient_sorted_tree() = default;
+    native_transient_sorted_tree(native_transient_sorted_tree const &) = default;
+    native_transient_sorted_tree(native_transient_sorted_tree &&) noexcept = default;
+
+    native_transient_sorted_tree(node_type * const root, size_t const length)
+      : root{ root }
+      , length{ length }
+    {
+    }
+
+    T const *find(object_ptr const key) const
+    {
+      return ops::find(root, key);
+    }
+
+    void insert_or_assign(object_ptr const key, object_ptr const val)
+    {
+      insert(T{ key, val }, true);
+    }
+
+    void insert_v(T const &value)
+    {
+      insert(value, false);
+    }
+
+    void erase_key(object_ptr const key)
+    {
+      native_bool removed{};
+      root = ops::erase(root, key, edit, removed);
+      if(removed)
+      {
+        --length;
+      }
+    }
+
+    /* Once persistent, the nodes we've made are shared, so we stop editing them. Any
+     * further changes through this transient will copy. */
+    persistent_type persistent()
+    {
+      edit = nullptr;
+      return { root, length };
+    }
+
+    iterator begin() const
+    {
+      return { iterator::push_left(root, nullptr) };
+    }
+
+    iterator end() const
+    {
+      return {};
+    }
+
+    size_t size() const
+    {
+      return length;
+    }
+
+    native_bool empty() const
+    {
+      return length == 0;
+    }
+
+    node_type *root{};
+    size_t length{};
+    /* Any unique address will do. It's allocated by the GC, so it can't be reused while
+     * any of our nodes still refer to it. */
+    void const *edit{ new(PointerFreeGC) char{} };
+
+  private:
+    void insert(T const &value, native_bool const replace)
+    {
+      native_bool added{};
+      root = ops::insert(root, value, replace, edit, added);
+      if(added)
+      {
+        ++length;
+      }
+    }
+  };
+}
@@ -8,11 +8,9 @@
 #include <immer/set_transient.hpp>
 #include <immer/memory_policy.hpp>
 
-#include <bpptree/bpptree.hpp>
-#include <bpptree/ordered.hpp>
-
 #include <jank/runtime/object.hpp>
 #include <jank/runtime/detail/native_persistent_list.hpp>
+#include <jank/runtime/detail/native_persistent_sorted_tree.hpp>
 
 namespace jank::runtime
 {
@@ -38,9 +36,25 @@ namespace jank::runtime
 
     struct object_ptr_compare
     {
-      native_bool operator()(object_ptr const l, object_ptr const r) const
+      native_integer operator()(object_ptr const l, object_ptr const r) const
+      {
+        return runtime::compare(l, r);
+      }
+    };
+
+    struct sorted_set_key
+    {
+      object_ptr operator()(object_ptr const o) const
+      {
+        return o;
+      }
+    };
+
+    struct sorted_map_key
+    {
+      object_ptr operator()(std::pair<object_ptr, object_ptr> const &entry) const
       {
-        return runtime::compare(l, r) < 0;
+        return entry.first;
       }
     };
 
@@ -51,20 +65,19 @@ namespace jank::runtime
       = immer::set<object_ptr, std::hash<object_ptr>, object_ptr_equal, memory_policy>;
     using native_transient_hash_set = native_persistent_hash_set::transient_type;
 
-    /* TODO: These BppTree types will leak until we get them GC allocated. */
     using native_persistent_sorted_set
-      = bpptree::BppTreeSet<object_ptr, object_ptr_compare>::Persistent;
-    using native_transient_sorted_set
-      = bpptree::BppTreeSet<object_ptr, object_ptr_compare>::Transient;
+      = native_persistent_sorted_tree<object_ptr, sorted_set_key, object_ptr_compare>;
+    using native_transient_sorted_set = native_persistent_sorted_set::transient_type;
 
     using native_persistent_hash_map = immer::
       map<object_ptr, object_ptr, std::hash<object_ptr>, object_ptr_equal, jank::memory_policy>;
     using native_transient_hash_map = native_persistent_hash_map::transient_type;
 
     using native_persistent_sorted_map
-      = bpptree::BppTreeMap<object_ptr, object_ptr, object_ptr_compare>::Persistent;
-    using native_transient_sorted_map
-      = bpptree::BppTreeMap<object_ptr, object_ptr, object_ptr_compare>::Transient;
+      = native_persistent_sorted_tree<std::pair<object_ptr, object_ptr>,
+                                      sorted_map_key,
+                                      object_ptr_compare>;
+    using native_transient_sorted_map = native_persistent_sorted_map::transient_type;
 
     /* If an object requires this in its constructor, use your runtime context to intern
      * it instead. */
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include <jank/type.hpp>
+
+namespace jank::runtime
+{
+  /* A pool of threads, each registered with the GC, which run tasks in the order they're
+   * submitted. Threads are only started once there's a task which no idle thread can take,
+   * up to the pool's limit. Threads beyond the core count exit once they've been idle for
+   * the keep alive duration, so an expanding pool shrinks again after a burst of blocking
+   * tasks.
+   *
+   * Executors live in GC memory, since their queues hold GC pointers. */
+  struct executor : gc
+  {
+    struct task : gc
+    {
+      task() = default;
+      task(task const &) = default;
+      task(task &&) noexcept = default;
+      virtual ~task() = default;
+
+      task &operator=(task const &) = default;
+      task &operator=(task &&) noexcept = default;
+
+      /* Anything thrown from here is dropped, so tasks need to handle their own errors. */
+      virtual void run() = 0;
+    };
+
+    executor(size_t core_threads, size_t max_threads, std::chrono::milliseconds keep_alive);
+
+    /* Returns false, without queueing the task, if the executor has been shut down. */
+    native_bool submit(task *t);
+
+    /* Tasks which have already been submitted still run, but no new tasks are accepted
+     * and threads exit once the queue is empty. */
+    void shutdown();
+    native_bool is_shutdown();
+
+    /* A fixed pool with one thread per core, for CPU bound work. */
+    static executor &pooled();
+    /* An unbounded pool, for work which may block. */
+    static executor &solo();
+
+  private:
+    void work();
+    void start_thread();
+
+    size_t core_threads{};
+    size_t max_threads{};
+    std::chrono::milliseconds keep_alive{};
+
+    std::mutex lock;
+    std::condition_variable ready;
+    native_deque<task *> queue;
+    size_t thread_count{};
+    size_t idle_count{};
+    native_bool shutting_down{};
+  };
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <jank/runtime/object.hpp>
+#include <jank/profile/allocation.hpp>
 
 namespace jank::runtime
 {
@@ -275,6 +276,11 @@ namespace jank::runtime
     {
       throw std::runtime_error{ "unable to allocate box" };
     }
+
+    if constexpr(requires { T::obj_type; })
+    {
+      profile::allocation::sample(T::obj_type, sizeof(T));
+    }
     return ret;
   }
 
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include <jank/runtime/object.hpp>
+#include <jank/option.hpp>
+
+namespace jank::runtime
+{
+  struct executor;
+}
+
+namespace jank::runtime::obj
+{
+  using agent_ptr = native_box<struct agent>;
+  using persistent_hash_map_ptr = native_box<struct persistent_hash_map>;
+
+  /* Agents hold a state which is only ever changed by actions sent to them. Actions are
+   * queued per agent and run one at a time, in order, on an executor's threads. Once an
+   * agent is scheduled, the thread running it keeps taking queued actions, up to a limit,
+   * so a burst of sends doesn't need a wake up for each action. */
+  struct agent : gc
+  {
+    static constexpr object_type obj_type{ object_type::agent };
+    static constexpr native_bool pointer_free{ false };
+
+    /* The most actions one thread runs for an agent before giving other agents a turn. */
+    static constexpr size_t max_batch_size{ 64 };
+
+    enum class error_mode : uint8_t
+    {
+      fail,
+      continue_
+    };
+
+    struct latch;
+
+    /* A single send, along with the thread bindings it was sent with. Actions with no fn
+     * are used by await, to count down a latch. */
+    struct action : gc
+    {
+      object_ptr fn{};
+      object_ptr args{};
+      persistent_hash_map_ptr bindings{};
+      executor *exec{};
+      latch *done{};
+    };
+
+    agent() = default;
+    agent(object_ptr state);
+
+    /* behavior::object_like */
+    native_bool equal(object const &) const;
+    native_persistent_string to_string() const;
+    void to_string(util::string_builder &buff) const;
+    native_persistent_string to_code_string() const;
+    native_hash to_hash() const;
+
+    /* behavior::derefable */
+    object_ptr deref() const;
+
+    /* behavior::metadatable */
+    agent_ptr with_meta(object_ptr m);
+
+    /* Queues (apply fn state args) to run on the executor. If this is called from within
+     * an action, the send is held until that action has finished. Throws if the agent is
+     * failed. */
+    agent_ptr dispatch(object_ptr fn, object_ptr args, executor &exec);
+
+    /* Un-fails the agent with a new state. Any held actions run afterward, unless they're
+     * cleared. Throws if the agent isn't failed or the new state isn't valid. */
+    object_ptr restart(object_ptr new_state, native_bool clear_actions);
+
+    /* Throws if the state isn't valid, in which case the validator isn't changed. */
+    void set_validator(object_ptr fn);
+    object_ptr get_validator() const;
+
+    void set_error_handler(object_ptr fn);
+    object_ptr get_error_handler() const;
+
+    void set_error_mode(object_ptr mode);
+    object_ptr get_error_mode() const;
+
+    /* The error which failed this agent, or nil. */
+    object_ptr get_error() const;
+
+    size_t queue_count();
+
+    /* Blocks until every action sent to these agents so far has run. Returns false if
+     * the timeout passes first. */
+    static native_bool await(object_ptr agents, option<native_integer> timeout_ms);
+
+    /* Sends any actions held by the current action right away, returning how many there
+     * were. */
+    static size_t release_pending_sends();
+
+    /* The agent whose action is running on this thread, if any. */
+    static agent *current();
+
+    object base{ obj_type };
+    std::atomic<object *> state{};
+    std::atomic<object *> validator{};
+    std::atomic<object *> error_handler{};
+    std::atomic<object *> error{};
+    std::atomic<error_mode> mode{ error_mode::fail };
+    option<object_ptr> meta;
+
+  private:
+    friend struct agent_batch;
+
+    agent_ptr dispatch(action *a);
+    void enqueue(action *a);
+    /* Returns false if the executor has been shut down. */
+    native_bool schedule(executor &exec);
+    void run_batch(executor &exec);
+    void run_action(action *a);
+    void validate(object_ptr s) const;
+    void handle_error(object_ptr e);
+
+    std::mutex queue_lock;
+    native_deque<action *> queue;
+    /* Whether a batch is queued or running on an executor, in which case new actions
+     * will be picked up by it. */
+    native_bool scheduled{};
+  };
+}
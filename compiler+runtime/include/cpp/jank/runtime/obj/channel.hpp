@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include <jank/runtime/object.hpp>
+#include <jank/option.hpp>
+
+namespace jank::runtime::obj
+{
+  using channel_ptr = native_box<struct channel>;
+  using persistent_vector_ptr = native_box<struct persistent_vector>;
+
+  /* A bounded, multi-producer, multi-consumer queue for passing values between threads.
+   *
+   * The buffer is a lock-free ring, where each cell has a sequence number saying whether
+   * it's ready to be written or read on the current lap. Blocking puts and takes park on
+   * an event count, which is bumped whenever a put or take frees up the other side. The
+   * event counts are futex words, and wakers only make a syscall when someone's waiting.
+   *
+   * alts waits on several channels at once, so it can't park on any one event count.
+   * Instead, it registers a selector with each channel, which is the only time a channel
+   * takes a lock. */
+  struct channel : gc
+  {
+    static constexpr object_type obj_type{ object_type::channel };
+    static constexpr native_bool pointer_free{ false };
+
+    struct cell
+    {
+      std::atomic<size_t> sequence;
+      object *value;
+    };
+
+    /* A parked alts call. Every channel it's waiting on bumps its word on any change. */
+    struct selector : gc
+    {
+      std::atomic<uint32_t> event{};
+    };
+
+    channel(size_t capacity);
+
+    /* behavior::object_like */
+    native_bool equal(object const &) const;
+    native_persistent_string to_string() const;
+    void to_string(util::string_builder &buff) const;
+    native_persistent_string to_code_string() const;
+    native_hash to_hash() const;
+
+    /* Returns false right away if the channel is full or closed. */
+    native_bool offer(object_ptr o);
+    /* Returns nullptr right away if the channel is empty. */
+    object *poll();
+
+    /* Blocks while the channel is full. Returns false if the channel is closed. */
+    native_bool put(object_ptr o);
+    /* Blocks while the channel is empty. Returns nil once it's closed and drained. */
+    object_ptr take();
+
+    /* Pending blocking puts fail and takes drain what's left, then get nil. */
+    void close();
+    native_bool is_closed() const;
+
+    /* Completes the first ready op out of ops, which holds channels to take from and
+     * [channel value] vectors to put to, blocking until one is ready. Returns [value
+     * channel], where the value is true or false for puts. If a default is given and
+     * nothing is ready right away, returns [default :default] instead. */
+    static persistent_vector_ptr
+    alts(object_ptr ops, native_bool priority, option<object_ptr> const &default_val);
+
+    object base{ obj_type };
+    size_t capacity{};
+
+  private:
+    /* Just the ring buffer, without waking anyone. */
+    native_bool push(object_ptr o);
+    object *pop();
+    /* The same, but waking anyone waiting on the other side. */
+    native_bool try_offer(object_ptr o);
+    object *try_poll();
+    void signal(std::atomic<uint32_t> &event, std::atomic<uint32_t> const &waiters);
+    void notify_selectors();
+    void add_selector(selector *s);
+    void remove_selector(selector *s);
+
+    native_box<cell> cells;
+    /* The next positions to write and read. */
+    std::atomic<size_t> head{};
+    std::atomic<size_t> tail{};
+    std::atomic<native_bool> closed{};
+
+    /* Bumped whenever a value is added or the channel is closed. */
+    std::atomic<uint32_t> not_empty{};
+    std::atomic<uint32_t> take_waiters{};
+    /* Bumped whenever a value is removed or the channel is closed. */
+    std::atomic<uint32_t> not_full{};
+    std::atomic<uint32_t> put_waiters{};
+
+    std::atomic<size_t> selector_count{};
+    std::mutex selectors_lock;
+    native_vector<selector *> selectors;
+  };
+}
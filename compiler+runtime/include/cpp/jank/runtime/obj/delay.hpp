@@ -1,6 +1,7 @@
 #pragma once
 
 #include <jank/runtime/object.hpp>
+#include <jank/util/once.hpp>
 
 namespace jank::runtime::obj
 {
@@ -24,10 +25,13 @@ namespace jank::runtime::obj
     /* behavior::derefable */
     object_ptr deref();
 
+    native_bool is_realized() const;
+
     object base{ obj_type };
     object_ptr val{};
     object_ptr fn{};
+    /* As on the JVM, if the fn throws, every deref rethrows the same error. */
     object_ptr error{};
-    std::mutex mutex;
+    util::once realized;
   };
 }
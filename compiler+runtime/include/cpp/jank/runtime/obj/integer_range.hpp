@@ -7,6 +7,7 @@ namespace jank::runtime::obj
 {
   using integer_ptr = native_box<struct integer>;
   using cons_ptr = native_box<struct cons>;
+  using array_chunk_ptr = native_box<struct array_chunk>;
   using integer_range_ptr = native_box<struct integer_range>;
 
   /* An integer range from X to Y, exclusive, incrementing by S. */
@@ -17,6 +18,8 @@ namespace jank::runtime::obj
     static constexpr native_bool pointer_free{ false };
     static constexpr native_bool is_sequential{ true };
 
+    static constexpr size_t chunk_size{ 32 };
+
     using bounds_check_t = native_bool (*)(integer_ptr, integer_ptr);
 
     /* Constructors are only to be used within integer_range.cpp. Prefer integer_range::create. */
@@ -30,12 +33,6 @@ namespace jank::runtime::obj
                   integer_ptr end,
                   integer_ptr step,
                   bounds_check_t bounds_check);
-    //integer_range(integer_ptr start,
-    //              integer_ptr end,
-    //              integer_ptr step,
-    //              bounds_check_t bounds_check,
-    //              array_chunk_ptr chunk,
-    //              integer_range_ptr chunk_next);
 
     static object_ptr create(integer_ptr end);
     static object_ptr create(integer_ptr start, obj::integer_ptr end);
@@ -59,10 +56,9 @@ namespace jank::runtime::obj
     /* behavior::sequenceable_in_place */
     integer_range_ptr next_in_place();
 
-    /* TODO: behavior::chunkable */
-    /* array_chunk_ptr chunked_first() const; */
-    /* integer_range_ptr chunked_next() const; */
-    /* void force_chunk() const; */
+    /* behavior::chunkable */
+    obj::array_chunk_ptr chunked_first() const;
+    integer_range_ptr chunked_next() const;
 
     /* behavior::conjable */
     cons_ptr conj(object_ptr head) const;
@@ -78,11 +74,6 @@ namespace jank::runtime::obj
     integer_ptr end{};
     integer_ptr step{};
     bounds_check_t bounds_check{};
-
-    /* TODO: behavior::chunkable */
-    /* mutable array_chunk_ptr chunk{}; */
-    /* mutable integer_range_ptr chunk_next{}; */
-    /* mutable integer_range_ptr cached_next{}; */
     option<object_ptr> meta{};
   };
 }
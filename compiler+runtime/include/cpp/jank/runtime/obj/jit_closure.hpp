@@ -3,6 +3,11 @@
 #include <jank/runtime/object.hpp>
 #include <jank/runtime/behavior/callable.hpp>
 
+namespace jank::jit
+{
+  struct code_owner;
+}
+
 namespace jank::runtime::obj
 {
   using jit_closure_ptr = native_box<struct jit_closure>;
@@ -115,6 +120,8 @@ namespace jank::runtime::obj
                         object *,
                         object *){};
     option<object_ptr> meta;
+    /* Present when this function's code can be unloaded. */
+    jit::code_owner *owner{};
     arity_flag_t arity_flags{};
   };
 }
@@ -3,6 +3,11 @@
 #include <jank/runtime/object.hpp>
 #include <jank/runtime/behavior/callable.hpp>
 
+namespace jank::jit
+{
+  struct code_owner;
+}
+
 namespace jank::runtime::obj
 {
   using jit_function_ptr = native_box<struct jit_function>;
@@ -103,6 +108,12 @@ namespace jank::runtime::obj
                         object *,
                         object *){};
     option<object_ptr> meta;
+    /* Present when this function's code can be unloaded. */
+    jit::code_owner *owner{};
+    /* The munged name of the generated code. Each arity is a symbol named `{name}_{arity}`,
+     * which direct linking calls instead of going through this object. This lives in the
+     * same module as the code, so the owner keeps it alive. */
+    char const *name{};
     arity_flag_t arity_flags{};
   };
 }
@@ -50,6 +50,9 @@ namespace jank::runtime::obj
 
     object base{ obj_type };
     symbol_ptr sym;
+    /* Computed up front, since keywords are interned and immutable. This also lets `case`
+     * switch on it directly from generated code. */
+    native_hash hash{};
   };
 }
 
@@ -3,13 +3,20 @@
 #include <jank/runtime/object.hpp>
 #include <jank/runtime/behavior/seqable.hpp>
 #include <jank/option.hpp>
+#include <jank/util/once.hpp>
 
 namespace jank::runtime::obj
 {
   using cons_ptr = native_box<struct cons>;
   using lazy_sequence_ptr = native_box<struct lazy_sequence>;
 
-  /* TODO: IPending analog, to implement `realized?`. */
+  /* Realization happens in two steps, as on the JVM. First, the fn is called. Its result
+   * may well be another lazy sequence, so we then walk through those until we find
+   * something which isn't, and that's our sequence. Each step happens once, no matter how
+   * many threads get to it.
+   *
+   * Walking through the nested lazy sequences only runs their first step. We need to do
+   * this iteratively, since things like `filter` can nest them very deeply. */
   struct lazy_sequence : gc
   {
     static constexpr object_type obj_type{ object_type::lazy_sequence };
@@ -17,8 +24,6 @@ namespace jank::runtime::obj
     static constexpr native_bool is_sequential{ true };
 
     lazy_sequence() = default;
-    lazy_sequence(lazy_sequence &&) noexcept = default;
-    lazy_sequence(lazy_sequence const &) = default;
     lazy_sequence(object_ptr fn);
     lazy_sequence(object_ptr fn, object_ptr sequence);
 
@@ -44,16 +49,22 @@ namespace jank::runtime::obj
     /* behavior::metadatable */
     lazy_sequence_ptr with_meta(object_ptr m) const;
 
+    native_bool is_realized() const;
+
   private:
     object_ptr resolve_fn() const;
     object_ptr resolve_seq() const;
 
   public:
-    /* TODO: Synchronize. */
     object base{ obj_type };
     mutable object_ptr fn{};
-    mutable object_ptr fn_result{};
+    /* This is cleared once we have the sequence, so it doesn't keep a chain of nested
+     * lazy sequences alive. Nested lazy sequences may read it from other threads, which
+     * is why it's atomic. */
+    mutable std::atomic<object *> fn_result{};
     mutable object_ptr sequence{};
+    mutable util::once fn_called;
+    mutable util::once realized;
     option<object_ptr> meta;
   };
 }
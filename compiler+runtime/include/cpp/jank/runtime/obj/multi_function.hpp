@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <mutex>
 
 #include <jank/runtime/object.hpp>
@@ -11,6 +12,38 @@ namespace jank::runtime::obj
   using persistent_hash_map_ptr = native_box<struct persistent_hash_map>;
   using multi_function_ptr = native_box<struct multi_function>;
 
+  /* An open addressed map of dispatch values to methods, which can be read without any
+   * locking. Entries are only ever added, while holding the multi_function's lock. Anything
+   * which would invalidate entries, such as adding a method, instead swaps in a whole new
+   * cache with a new generation. The old one is left for the GC once no readers are
+   * using it. */
+  struct multi_function_cache : gc
+  {
+    static constexpr size_t initial_capacity{ 16 };
+
+    struct entry : gc
+    {
+      entry(object_ptr dispatch_val, object_ptr method, native_hash hash);
+
+      object_ptr dispatch_val{};
+      object_ptr method{};
+      native_hash hash{};
+    };
+
+    multi_function_cache(size_t generation, object_ptr hierarchy, size_t capacity);
+
+    /* Returns nullptr if the dispatch value isn't cached. */
+    object_ptr find(object_ptr dispatch_val, native_hash hash) const;
+    /* Returns false if there's no room left, in which case a bigger cache is needed. */
+    native_bool insert(entry *e);
+
+    size_t generation{};
+    object_ptr hierarchy{};
+    size_t capacity{};
+    size_t size{};
+    std::atomic<entry *> *slots{};
+  };
+
   struct multi_function
     : gc
     , behavior::callable
@@ -18,6 +51,25 @@ namespace jank::runtime::obj
     static constexpr object_type obj_type{ object_type::multi_function };
     static constexpr native_bool pointer_free{ false };
 
+    /* A monomorphic inline cache for a single call site of a multimethod, which lives in
+     * the compiled code for that call site and starts out zeroed. It remembers the last
+     * dispatch value and the method it resolved to, which stays valid for as long as the
+     * multimethod's cache generation doesn't change.
+     *
+     * Only dispatch values which live as long as the runtime, such as keywords, are
+     * remembered, since we compare them by identity and we don't keep them alive.
+     *
+     * Updates are guarded with a sequence number, which is odd while writing. Readers which
+     * see it change just go the slow route. */
+    struct call_site
+    {
+      std::atomic<uint64_t> sequence;
+      std::atomic<uint64_t> generation;
+      std::atomic<object *> fn;
+      std::atomic<object *> dispatch_val;
+      std::atomic<object *> method;
+    };
+
     multi_function() = default;
     multi_function(object_ptr name, object_ptr dispatch, object_ptr default_, object_ptr hierarchy);
 
@@ -69,8 +121,16 @@ namespace jank::runtime::obj
                     object_ptr) override;
     object_ptr this_object_ptr() final;
 
+    template <typename... Args>
+    object_ptr call(call_site &site, Args const... args)
+    {
+      return dynamic_call(get_fn(site, dynamic_call(dispatch, args...)), args...);
+    }
+
     multi_function_ptr reset();
-    persistent_hash_map_ptr reset_cache();
+    multi_function_cache *reset_cache();
+    /* Returns the current cache, after making sure it's for the current hierarchy. */
+    multi_function_cache *current_cache();
     multi_function_ptr add_method(object_ptr dispatch_val, object_ptr method);
     multi_function_ptr remove_method(object_ptr dispatch_val);
     multi_function_ptr prefer_method(object_ptr x, object_ptr y);
@@ -80,16 +140,17 @@ namespace jank::runtime::obj
     native_bool is_dominant(object_ptr hierarchy, object_ptr x, object_ptr y) const;
 
     object_ptr get_fn(object_ptr dispatch_val);
+    object_ptr get_fn(call_site &site, object_ptr dispatch_val);
     object_ptr get_method(object_ptr dispatch_val);
-    object_ptr find_and_cache_best_method(object_ptr dispatch_val);
+    object_ptr find_and_cache_best_method(object_ptr dispatch_val, native_hash hash);
 
     object base{ obj_type };
     object_ptr dispatch{};
     object_ptr default_dispatch_value{};
     object_ptr hierarchy{};
-    mutable object_ptr cached_hierarchy{};
     persistent_hash_map_ptr method_table{};
-    mutable persistent_hash_map_ptr method_cache{};
+    /* Reads of this don't need the lock. Replacing it does. */
+    std::atomic<multi_function_cache *> method_cache{};
     persistent_hash_map_ptr prefer_table{};
     symbol_ptr name{};
     std::recursive_mutex data_lock;
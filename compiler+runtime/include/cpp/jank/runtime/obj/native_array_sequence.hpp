@@ -26,6 +26,10 @@ namespace jank::runtime::obj
     {
     }
 
+    /* Copies the values into the same allocation as the sequence itself. This is how call
+     * args are packed into a rest param, so it's one allocation per call, rather than two. */
+    static native_array_sequence_ptr create(object_ptr const *values, size_t count);
+
     /* behavior::object_like */
     native_bool equal(object const &o) const;
     void to_string(util::string_builder &buff) const;
@@ -6,6 +6,7 @@
 namespace jank::runtime::obj
 {
   using cons_ptr = native_box<struct cons>;
+  using array_chunk_ptr = native_box<struct array_chunk>;
   using native_vector_sequence_ptr = native_box<struct native_vector_sequence>;
 
   struct native_vector_sequence : gc
@@ -13,6 +14,7 @@ namespace jank::runtime::obj
     static constexpr object_type obj_type{ object_type::native_vector_sequence };
     static constexpr native_bool pointer_free{ false };
     static constexpr native_bool is_sequential{ true };
+    static constexpr size_t chunk_size{ 32 };
 
     native_vector_sequence() = default;
     native_vector_sequence(native_vector_sequence &&) noexcept = default;
@@ -44,6 +46,10 @@ namespace jank::runtime::obj
     /* behavior::sequenceable_in_place */
     native_vector_sequence_ptr next_in_place();
 
+    /* behavior::chunkable */
+    obj::array_chunk_ptr chunked_first() const;
+    native_vector_sequence_ptr chunked_next() const;
+
     /* behavior::metadatable */
     native_vector_sequence_ptr with_meta(object_ptr const m) const;
 
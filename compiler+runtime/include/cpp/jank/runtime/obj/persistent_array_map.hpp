@@ -8,7 +8,7 @@
 namespace jank::runtime::obj
 {
   using persistent_array_map_ptr = native_box<struct persistent_array_map>;
-  using transient_hash_map_ptr = native_box<struct transient_hash_map>;
+  using transient_array_map_ptr = native_box<struct transient_array_map>;
 
   struct persistent_array_map
     : obj::detail::base_persistent_map<persistent_array_map,
@@ -86,7 +86,7 @@ namespace jank::runtime::obj
     object_ptr call(object_ptr, object_ptr) const;
 
     /* behavior::transientable */
-    transient_hash_map_ptr to_transient() const;
+    transient_array_map_ptr to_transient() const;
 
     value_type data{};
   };
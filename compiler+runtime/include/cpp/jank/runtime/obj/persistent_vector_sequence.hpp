@@ -5,6 +5,7 @@
 namespace jank::runtime::obj
 {
   using cons_ptr = native_box<struct cons>;
+  using array_chunk_ptr = native_box<struct array_chunk>;
   using persistent_vector_ptr = native_box<struct persistent_vector>;
   using persistent_vector_sequence_ptr = native_box<struct persistent_vector_sequence>;
 
@@ -13,6 +14,8 @@ namespace jank::runtime::obj
     static constexpr object_type obj_type{ object_type::persistent_vector_sequence };
     static constexpr native_bool pointer_free{ false };
     static constexpr native_bool is_sequential{ true };
+    /* Chunks line up with the vector's leaves, so they can be copied out in one go. */
+    static constexpr size_t chunk_size{ 32 };
 
     persistent_vector_sequence() = default;
     persistent_vector_sequence(persistent_vector_sequence &&) noexcept = default;
@@ -42,6 +45,11 @@ namespace jank::runtime::obj
     /* behavior::sequenceable_in_place */
     persistent_vector_sequence_ptr next_in_place();
 
+    /* behavior::chunkable */
+    obj::array_chunk_ptr chunked_first() const;
+    persistent_vector_sequence_ptr chunked_next() const;
+    size_t chunk_end() const;
+
     object base{ obj_type };
     obj::persistent_vector_ptr vec{};
     size_t index{};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include <jank/runtime/object.hpp>
+#include <jank/option.hpp>
+
+namespace jank::runtime::obj
+{
+  using promise_ptr = native_box<struct promise>;
+
+  /* A value which is delivered once, by any thread, and which derefs wait for. Promises
+   * are meant to be created in bulk, as completion handles, so they're just a state word
+   * and a value. Nothing waits on a lock; the state word doubles as a futex, and it
+   * records whether anyone is waiting, so delivering only wakes threads when it needs to. */
+  struct promise : gc
+  {
+    static constexpr object_type obj_type{ object_type::promise };
+    static constexpr native_bool pointer_free{ false };
+
+    static constexpr uint32_t delivering{ 1 };
+    static constexpr uint32_t delivered{ 2 };
+    static constexpr uint32_t has_waiters{ 4 };
+
+    promise() = default;
+
+    /* behavior::object_like */
+    native_bool equal(object const &) const;
+    native_persistent_string to_string() const;
+    void to_string(util::string_builder &buff) const;
+    native_persistent_string to_code_string() const;
+    native_hash to_hash() const;
+
+    /* behavior::derefable */
+    object_ptr deref() const;
+
+    /* behavior::blocking_derefable */
+    object_ptr deref(native_integer timeout_ms, object_ptr timeout_val) const;
+
+    /* behavior::realizable */
+    native_bool is_realized() const;
+
+    /* Returns false, leaving the promise as it was, if something was already delivered. */
+    native_bool deliver(object_ptr o);
+
+    object base{ obj_type };
+    mutable std::atomic<uint32_t> state{};
+    object_ptr value{};
+
+  private:
+    /* Returns false if the timeout passed before delivery. */
+    native_bool wait(option<native_integer> timeout_ms) const;
+  };
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <limits>
+#include <mutex>
+
+#include <jank/runtime/object.hpp>
+#include <jank/runtime/behavior/callable.hpp>
+
+namespace jank::runtime::obj
+{
+  using symbol_ptr = native_box<struct symbol>;
+  using persistent_hash_map_ptr = native_box<struct persistent_hash_map>;
+  using protocol_function_ptr = native_box<struct protocol_function>;
+
+  /* A single method of a protocol, which dispatches on the type of its first arg. Each
+   * method keeps a dense table of implementations, indexed by object_type, which can be
+   * read without any locking. The extension map holds every implementation, keyed by the
+   * type it was extended to, and is what the table is built from. */
+  struct protocol_function
+    : gc
+    , behavior::callable
+  {
+    static constexpr object_type obj_type{ object_type::protocol_function };
+    static constexpr native_bool pointer_free{ false };
+    static constexpr size_t type_count{
+      std::numeric_limits<std::underlying_type_t<object_type>>::max() + 1
+    };
+
+    /* A polymorphic inline cache for a single call site of a protocol fn, which lives in the
+     * compiled code for that call site and starts out zeroed. It remembers the methods for
+     * the last few types seen there, which stay valid for as long as the protocol fn's
+     * generation doesn't change.
+     *
+     * Updates are guarded with a sequence number, which is odd while writing. Readers which
+     * see it change just go the slow route. */
+    struct call_site
+    {
+      static constexpr size_t entry_count{ 4 };
+
+      std::atomic<uint64_t> sequence;
+      std::atomic<uint64_t> generation;
+      std::atomic<object *> fn;
+      /* One byte per entry, holding the object_type plus one, so zero means empty. */
+      std::atomic<uint64_t> types;
+      std::array<std::atomic<object *>, entry_count> methods;
+    };
+
+    protocol_function() = default;
+    protocol_function(object_ptr protocol_name, object_ptr name);
+
+    /* behavior::object_like */
+    native_bool equal(object const &) const;
+    native_persistent_string to_string();
+    void to_string(util::string_builder &buff);
+    native_persistent_string to_code_string();
+    native_hash to_hash() const;
+
+    /* behavior::callable */
+    object_ptr call() override;
+    object_ptr call(object_ptr) override;
+    object_ptr call(object_ptr, object_ptr) override;
+    object_ptr call(object_ptr, object_ptr, object_ptr) override;
+    object_ptr call(object_ptr, object_ptr, object_ptr, object_ptr) override;
+    object_ptr call(object_ptr, object_ptr, object_ptr, object_ptr, object_ptr) override;
+    object_ptr
+      call(object_ptr, object_ptr, object_ptr, object_ptr, object_ptr, object_ptr) override;
+    object_ptr
+      call(object_ptr, object_ptr, object_ptr, object_ptr, object_ptr, object_ptr, object_ptr)
+        override;
+    object_ptr call(object_ptr,
+                    object_ptr,
+                    object_ptr,
+                    object_ptr,
+                    object_ptr,
+                    object_ptr,
+                    object_ptr,
+                    object_ptr) override;
+    object_ptr call(object_ptr,
+                    object_ptr,
+                    object_ptr,
+                    object_ptr,
+                    object_ptr,
+                    object_ptr,
+                    object_ptr,
+                    object_ptr,
+                    object_ptr) override;
+    object_ptr call(object_ptr,
+                    object_ptr,
+                    object_ptr,
+                    object_ptr,
+                    object_ptr,
+                    object_ptr,
+                    object_ptr,
+                    object_ptr,
+                    object_ptr,
+                    object_ptr) override;
+    object_ptr this_object_ptr() final;
+
+    template <typename... Args>
+    object_ptr call(call_site &site, object_ptr const target, Args const... args)
+    {
+      return dynamic_call(get_fn(site, target), target, args...);
+    }
+
+    /* Types are named by nil, by the keyword or string which matches their object_type_str,
+     * or by a record type. :default covers every type which has no implementation of its
+     * own. */
+    protocol_function_ptr extend(object_ptr type, object_ptr method);
+    persistent_hash_map_ptr get_extensions();
+
+    /* Returns nil if the target's type has no implementation. */
+    object_ptr find_fn(object_ptr target) const;
+    object_ptr get_fn(object_ptr target) const;
+    object_ptr get_fn(call_site &site, object_ptr target);
+
+    object base{ obj_type };
+    symbol_ptr protocol_name{};
+    symbol_ptr name{};
+    std::array<std::atomic<object *>, type_count> method_table{};
+    std::atomic<object *> default_method{};
+    /* A persistent_hash_map of record types to their implementations, or nullptr. It's
+     * replaced as a whole, so it can be read without locking. */
+    std::atomic<object *> record_methods{};
+    /* Changes whenever an implementation does, so call sites know to look again. */
+    std::atomic<uint64_t> generation{};
+    /* Only accessed while holding the lock. */
+    persistent_hash_map_ptr extensions{};
+    std::mutex data_lock;
+  };
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+
+#include <jank/runtime/object.hpp>
+#include <jank/runtime/obj/record_type.hpp>
+#include <jank/runtime/obj/persistent_hash_map_sequence.hpp>
+#include <jank/option.hpp>
+
+namespace jank::runtime::obj
+{
+  using record_ptr = native_box<struct record>;
+  using persistent_hash_map_ptr = native_box<struct persistent_hash_map>;
+
+  /* An instance of a deftype or defrecord. The field values are stored right after the
+   * record, in the same allocation, in the order given by the record type. Records can
+   * also hold keys which aren't fields, which go into a separate map. */
+  struct record : gc
+  {
+    static constexpr object_type obj_type{ object_type::record };
+    static constexpr native_bool pointer_free{ false };
+
+    /* Caches the index of a keyword's field, for one record type at a time. This lives in
+     * the compiled code for a keyword lookup and starts out zeroed. The record type's id
+     * is in the high bits and the field index is in the low bits, so they're always read
+     * together. */
+    struct lookup_site
+    {
+      std::atomic<uint64_t> type_and_index;
+    };
+
+    /* Expects exactly one value per field. */
+    static record_ptr create(record_type_ptr type, object_ptr const *values, size_t count);
+    static record_ptr create(record_type_ptr type, object_ptr values);
+
+    /* behavior::object_like */
+    native_bool equal(object const &) const;
+    native_persistent_string to_string() const;
+    void to_string(util::string_builder &buff) const;
+    native_persistent_string to_code_string() const;
+    native_hash to_hash() const;
+
+    /* behavior::associatively_readable */
+    object_ptr get(object_ptr const key) const;
+    object_ptr get(object_ptr const key, object_ptr const fallback) const;
+    object_ptr get_entry(object_ptr key) const;
+    native_bool contains(object_ptr key) const;
+
+    /* behavior::associatively_writable */
+    object_ptr assoc(object_ptr key, object_ptr val) const;
+    object_ptr dissoc(object_ptr key) const;
+
+    /* behavior::conjable */
+    object_ptr conj(object_ptr head) const;
+
+    /* behavior::countable */
+    size_t count() const;
+
+    /* behavior::seqable */
+    native_box<persistent_hash_map_sequence> seq() const;
+    native_box<persistent_hash_map_sequence> fresh_seq() const;
+
+    /* behavior::metadatable */
+    record_ptr with_meta(object_ptr m) const;
+
+    /* A map of every key, field or not. */
+    persistent_hash_map_ptr to_map() const;
+
+    object_ptr get(lookup_site &site, object_ptr key, object_ptr fallback) const;
+
+    object_ptr *fields();
+    object_ptr const *fields() const;
+
+    object base{ obj_type };
+    record_type_ptr type{};
+    /* Any keys which aren't fields, or nullptr if there are none. */
+    persistent_hash_map_ptr extension{};
+    option<object_ptr> meta;
+    mutable native_hash hash{};
+
+  private:
+    record(record_type_ptr type);
+    record(record const &) = default;
+
+    record_ptr clone() const;
+    void check_is_record(char const *action) const;
+  };
+}
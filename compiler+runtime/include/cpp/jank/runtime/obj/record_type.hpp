@@ -0,0 +1,45 @@
+#pragma once
+
+#include <jank/runtime/object.hpp>
+#include <jank/option.hpp>
+
+namespace jank::runtime::obj
+{
+  using symbol_ptr = native_box<struct symbol>;
+  using persistent_vector_ptr = native_box<struct persistent_vector>;
+  using record_type_ptr = native_box<struct record_type>;
+
+  /* The descriptor shared by every instance of a deftype or defrecord. It knows the names
+   * of the fields, in order, so instances only need to store their values. */
+  struct record_type : gc
+  {
+    static constexpr object_type obj_type{ object_type::record_type };
+    static constexpr native_bool pointer_free{ false };
+    /* Field lookup caches pack the field index into the low bits. */
+    static constexpr size_t max_fields{ 0xffff };
+
+    record_type() = default;
+    record_type(object_ptr name, object_ptr fields, native_bool is_record);
+
+    /* behavior::object_like */
+    native_bool equal(object const &) const;
+    native_persistent_string to_string() const;
+    void to_string(util::string_builder &buff) const;
+    native_persistent_string to_code_string() const;
+    native_hash to_hash() const;
+
+    /* Fields are keywords, so this is just a scan for the same pointer. */
+    option<size_t> field_index(object_ptr key) const;
+
+    object base{ obj_type };
+    symbol_ptr name{};
+    /* The keywords naming each field, in order. */
+    persistent_vector_ptr basis{};
+    native_vector<object_ptr> fields;
+    /* Records act as maps. Plain types only allow their fields to be read. */
+    native_bool is_record{};
+    /* Unique across all record types and never zero, so it can be cached in place of a
+     * pointer to this descriptor. */
+    uint64_t id{};
+  };
+}
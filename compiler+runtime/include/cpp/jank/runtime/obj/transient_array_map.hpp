@@ -0,0 +1,67 @@
+#pragma once
+
+#include <jank/runtime/object.hpp>
+#include <jank/runtime/detail/native_persistent_array_map.hpp>
+
+namespace jank::runtime::obj
+{
+  using transient_array_map_ptr = native_box<struct transient_array_map>;
+
+  /* A transient for small maps. All of its storage is allocated up front, with room for
+   * `max_size` pairs, so building a small map only ever writes into that one array. Once
+   * a new key would take it past `max_size`, it's promoted to a transient_hash_map, which
+   * is returned from the operation instead of this. This is why the return values of
+   * `assoc!` and `conj!` must always be used. */
+  struct transient_array_map : gc
+  {
+    static constexpr object_type obj_type{ object_type::transient_array_map };
+    static constexpr bool pointer_free{ false };
+    static constexpr size_t max_size{ runtime::detail::native_persistent_array_map::max_size };
+
+    using value_type = runtime::detail::native_persistent_array_map;
+    using persistent_type_ptr = native_box<struct persistent_array_map>;
+
+    transient_array_map();
+    transient_array_map(transient_array_map &&) noexcept = default;
+    transient_array_map(transient_array_map const &) = default;
+    transient_array_map(value_type const &d);
+
+    static transient_array_map_ptr empty();
+
+    /* behavior::object_like */
+    native_bool equal(object const &) const;
+    native_persistent_string to_string() const;
+    void to_string(util::string_builder &buff) const;
+    native_persistent_string to_code_string() const;
+    native_hash to_hash() const;
+
+    /* behavior::countable */
+    size_t count() const;
+
+    /* behavior::associatively_readable */
+    object_ptr get(object_ptr const key) const;
+    object_ptr get(object_ptr const key, object_ptr const fallback) const;
+    object_ptr get_entry(object_ptr key) const;
+    native_bool contains(object_ptr key) const;
+
+    /* behavior::associatively_writable_in_place */
+    object_ptr assoc_in_place(object_ptr const key, object_ptr const val);
+    transient_array_map_ptr dissoc_in_place(object_ptr const key);
+
+    /* behavior::conjable_in_place */
+    object_ptr conj_in_place(object_ptr head);
+
+    /* behavior::persistentable */
+    persistent_type_ptr to_persistent();
+
+    /* behavior::callable */
+    object_ptr call(object_ptr) const;
+    object_ptr call(object_ptr, object_ptr) const;
+
+    void assert_active() const;
+
+    object base{ obj_type };
+    value_type data;
+    native_bool active{ true };
+  };
+}
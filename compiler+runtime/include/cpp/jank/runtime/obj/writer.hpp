@@ -0,0 +1,56 @@
+#pragma once
+
+#include <mutex>
+
+#include <jank/runtime/object.hpp>
+
+namespace jank::runtime::obj
+{
+  using writer_ptr = native_box<struct writer>;
+
+  /* The destination for printing, such as *out* and *err*. A writer either buffers output
+   * for a file descriptor, writing it out whenever the buffer fills up or the writer is
+   * flushed, or it collects everything into a string, for things like `with-out-str`.
+   *
+   * Printing streams straight into the buffer, so printing a huge collection to a file
+   * descriptor only ever needs `buffer_size` bytes, rather than the whole string.
+   *
+   * The lock is held for the duration of each print, so output from separate threads isn't
+   * interleaved. It's recursive, since printing may realize lazy sequences which print. */
+  struct writer : gc
+  {
+    static constexpr object_type obj_type{ object_type::writer };
+    static constexpr native_bool pointer_free{ false };
+    static constexpr size_t buffer_size{ 8 * 1024 };
+
+    /* A string writer. */
+    writer();
+    /* A file descriptor writer. When auto flushing, each print is written out as soon as
+     * it's done, which is what we want for *err*. */
+    writer(int fd, native_bool auto_flush);
+    /* A writer which hands each full buffer, and whatever's left on a flush, to the sink,
+     * such as a network connection. */
+    writer(util::string_builder::sink_fn sink, void *sink_data);
+
+    /* behavior::object_like */
+    native_bool equal(object const &) const;
+    native_persistent_string to_string();
+    void to_string(util::string_builder &buff);
+    native_persistent_string to_code_string();
+    native_hash to_hash() const;
+
+    void write(native_persistent_string_view const &s);
+    void write(char c);
+    /* Called once a print has finished writing. */
+    void wrote();
+    void flush();
+
+    native_bool is_string_writer() const;
+
+    object base{ obj_type };
+    int fd{ -1 };
+    native_bool auto_flush{};
+    util::string_builder buffer;
+    std::recursive_mutex mutex;
+  };
+}
@@ -31,7 +31,7 @@ namespace jank::runtime
     persistent_vector_sequence,
 
     persistent_array_map,
-    /* TODO: transient_array_map */
+    transient_array_map,
     persistent_array_map_sequence,
 
     persistent_hash_map,
@@ -67,13 +67,21 @@ namespace jank::runtime
     jit_function,
     jit_closure,
     multi_function,
+    protocol_function,
+
+    record_type,
+    record,
 
     native_pointer_wrapper,
 
     atom,
+    agent,
     volatile_,
     reduced,
     delay,
+    promise,
+    channel,
+    writer,
     ns,
 
     var,
@@ -125,6 +133,8 @@ namespace jank::runtime
 
       case object_type::persistent_array_map:
         return "persistent_array_map";
+      case object_type::transient_array_map:
+        return "transient_array_map";
       case object_type::persistent_array_map_sequence:
         return "persistent_array_map_sequence";
 
@@ -188,18 +198,32 @@ namespace jank::runtime
         return "jit_closure";
       case object_type::multi_function:
         return "multi_function";
+      case object_type::protocol_function:
+        return "protocol_function";
+      case object_type::record_type:
+        return "record_type";
+      case object_type::record:
+        return "record";
 
       case object_type::native_pointer_wrapper:
         return "native_pointer_wrapper";
 
       case object_type::atom:
         return "atom";
+      case object_type::agent:
+        return "agent";
       case object_type::volatile_:
         return "volatile_";
       case object_type::reduced:
         return "reduced";
       case object_type::delay:
         return "delay";
+      case object_type::promise:
+        return "promise";
+      case object_type::channel:
+        return "channel";
+      case object_type::writer:
+        return "writer";
       case object_type::ns:
         return "ns";
 
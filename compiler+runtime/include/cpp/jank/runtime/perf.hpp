@@ -5,4 +5,9 @@
 namespace jank::runtime::perf
 {
   object_ptr benchmark(object_ptr opts, object_ptr f);
+
+  /* Reports from the allocation profiler. Both are empty unless jank was started with
+   * allocation profiling enabled. */
+  object_ptr allocations();
+  object_ptr reset_allocations();
 }
@@ -28,11 +28,7 @@ namespace jank::runtime
     var() = delete;
     var(ns_ptr const &n, obj::symbol_ptr const &name);
     var(ns_ptr const &n, obj::symbol_ptr const &name, object_ptr root);
-    var(ns_ptr const &n,
-        obj::symbol_ptr const &name,
-        object_ptr const root,
-        native_bool dynamic,
-        native_bool thread_bound);
+    var(ns_ptr const &n, obj::symbol_ptr const &name, object_ptr const root, native_bool dynamic);
 
     /* behavior::object_like */
     native_bool equal(object const &) const;
@@ -59,6 +55,9 @@ namespace jank::runtime
     var_ptr set_dynamic(native_bool dyn);
 
     var_thread_binding_ptr get_thread_binding() const;
+    /* Installs the binding for the current thread, returning the one it replaces. This only
+     * updates the per-thread slot; the binding frames are managed by the context. */
+    var_thread_binding_ptr swap_thread_binding(var_thread_binding_ptr binding);
 
     /* behavior::derefable */
     object_ptr deref() const;
@@ -79,7 +78,10 @@ namespace jank::runtime
 
   public:
     std::atomic_bool dynamic{ false };
-    std::atomic_bool thread_bound{ false };
+    /* Every var which has ever been dynamically bound gets a slot, which indexes into a
+     * per-thread array of current bindings. Zero means no slot, and thus no bindings on
+     * any thread, which keeps reads of non-dynamic vars to a single check. */
+    std::atomic<uint32_t> binding_slot{};
   };
 
   struct var_thread_binding : gc
@@ -104,6 +106,8 @@ namespace jank::runtime
   struct thread_binding_frame
   {
     obj::persistent_hash_map_ptr bindings{};
+    /* The slot bindings which this frame replaced, to be restored when it's popped. */
+    native_vector<std::pair<var_ptr, var_thread_binding_ptr>> previous_bindings;
   };
 
   struct var_unbound_root : gc
@@ -18,6 +18,7 @@
 #include <jank/runtime/obj/persistent_hash_map_sequence.hpp>
 #include <jank/runtime/obj/persistent_sorted_map.hpp>
 #include <jank/runtime/obj/persistent_sorted_map_sequence.hpp>
+#include <jank/runtime/obj/transient_array_map.hpp>
 #include <jank/runtime/obj/transient_hash_map.hpp>
 #include <jank/runtime/obj/transient_sorted_map.hpp>
 #include <jank/runtime/obj/transient_vector.hpp>
@@ -35,6 +36,9 @@
 #include <jank/runtime/obj/jit_function.hpp>
 #include <jank/runtime/obj/jit_closure.hpp>
 #include <jank/runtime/obj/multi_function.hpp>
+#include <jank/runtime/obj/protocol_function.hpp>
+#include <jank/runtime/obj/record_type.hpp>
+#include <jank/runtime/obj/record.hpp>
 #include <jank/runtime/obj/native_function_wrapper.hpp>
 #include <jank/runtime/obj/native_pointer_wrapper.hpp>
 #include <jank/runtime/obj/persistent_vector_sequence.hpp>
@@ -45,8 +49,12 @@
 #include <jank/runtime/obj/native_array_sequence.hpp>
 #include <jank/runtime/obj/native_vector_sequence.hpp>
 #include <jank/runtime/obj/atom.hpp>
+#include <jank/runtime/obj/agent.hpp>
 #include <jank/runtime/obj/volatile.hpp>
 #include <jank/runtime/obj/delay.hpp>
+#include <jank/runtime/obj/promise.hpp>
+#include <jank/runtime/obj/channel.hpp>
+#include <jank/runtime/obj/writer.hpp>
 #include <jank/runtime/obj/reduced.hpp>
 #include <jank/runtime/obj/tagged_literal.hpp>
 #include <jank/runtime/ns.hpp>
@@ -160,6 +168,11 @@ namespace jank::runtime
                     std::forward<Args>(args)...);
         }
         break;
+      case object_type::transient_array_map:
+        {
+          return fn(expect_object<obj::transient_array_map>(erased), std::forward<Args>(args)...);
+        }
+        break;
       case object_type::transient_hash_map:
         {
           return fn(expect_object<obj::transient_hash_map>(erased), std::forward<Args>(args)...);
@@ -313,11 +326,31 @@ namespace jank::runtime
           return fn(expect_object<obj::multi_function>(erased), std::forward<Args>(args)...);
         }
         break;
+      case object_type::protocol_function:
+        {
+          return fn(expect_object<obj::protocol_function>(erased), std::forward<Args>(args)...);
+        }
+        break;
+      case object_type::record_type:
+        {
+          return fn(expect_object<obj::record_type>(erased), std::forward<Args>(args)...);
+        }
+        break;
+      case object_type::record:
+        {
+          return fn(expect_object<obj::record>(erased), std::forward<Args>(args)...);
+        }
+        break;
       case object_type::atom:
         {
           return fn(expect_object<obj::atom>(erased), std::forward<Args>(args)...);
         }
         break;
+      case object_type::agent:
+        {
+          return fn(expect_object<obj::agent>(erased), std::forward<Args>(args)...);
+        }
+        break;
       case object_type::volatile_:
         {
           return fn(expect_object<obj::volatile_>(erased), std::forward<Args>(args)...);
@@ -333,6 +366,21 @@ namespace jank::runtime
           return fn(expect_object<obj::delay>(erased), std::forward<Args>(args)...);
         }
         break;
+      case object_type::promise:
+        {
+          return fn(expect_object<obj::promise>(erased), std::forward<Args>(args)...);
+        }
+        break;
+      case object_type::channel:
+        {
+          return fn(expect_object<obj::channel>(erased), std::forward<Args>(args)...);
+        }
+        break;
+      case object_type::writer:
+        {
+          return fn(expect_object<obj::writer>(erased), std::forward<Args>(args)...);
+        }
+        break;
       case object_type::ns:
         {
           return fn(expect_object<ns>(erased), std::forward<Args>(args)...);
@@ -539,6 +587,11 @@ namespace jank::runtime
           return fn(expect_object<obj::persistent_string>(erased), std::forward<Args>(args)...);
         }
         break;
+      case object_type::record:
+        {
+          return fn(expect_object<obj::record>(erased), std::forward<Args>(args)...);
+        }
+        break;
 
       /* Not seqable. */
       default:
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <memory>
+
+#include <jank/type.hpp>
+
+namespace jank::util
+{
+  /* A bump allocator for short lived, pointer heavy data, such as analyzer expression trees.
+   * Allocating is just a pointer bump and everything is released at once with `reset`.
+   *
+   * Chunks are allocated as uncollectable GC memory, which means the collector will scan
+   * them for pointers, so anything GC allocated which is only referenced from the arena
+   * stays alive. Nothing within the arena is ever collected on its own, though, so holding
+   * onto arena memory past a `reset` is a use after free. */
+  struct arena
+  {
+    static constexpr size_t chunk_size{ 64 * 1024 };
+    static constexpr size_t alignment{ alignof(std::max_align_t) };
+
+    struct chunk
+    {
+      chunk *next{};
+      size_t capacity{};
+      size_t used{};
+
+      char *data();
+    };
+
+    arena();
+    arena(arena const &) = delete;
+    arena(arena &&) = delete;
+    ~arena();
+
+    arena &operator=(arena const &) = delete;
+    arena &operator=(arena &&) = delete;
+
+    void *allocate(size_t size);
+    /* Releases every allocation, keeping only the first chunk around for reuse. */
+    void reset();
+    /* Total bytes handed out since the last reset. */
+    size_t size() const;
+
+    /* The first chunk is never freed. The current chunk is the most recently added and
+     * chunks link back toward the first. */
+    chunk *first{};
+    chunk *current{};
+  };
+
+  /* The arena into which arena aware allocations on this thread go, if any. */
+  arena *current_arena();
+
+  /* Allocates from the given arena or, if there isn't one, from the GC. */
+  void *arena_allocate(arena *a, size_t size);
+
+  /* Makes an arena current on this thread for the lifetime of the scope. Each nesting level
+   * has its own arena, which is reset when the scope ends and reused by the next scope at
+   * the same level, so the steady state doesn't allocate any chunks at all. */
+  struct arena_scope
+  {
+    arena_scope();
+    arena_scope(arena_scope const &) = delete;
+    arena_scope(arena_scope &&) = delete;
+    ~arena_scope();
+
+    arena_scope &operator=(arena_scope const &) = delete;
+    arena_scope &operator=(arena_scope &&) = delete;
+
+    arena *allocations{};
+    arena *previous{};
+  };
+
+  /* Types which inherit from this, rather than `gc`, are allocated within the current arena
+   * whenever there is one. This keeps `make_box` unchanged for them. Otherwise, they're
+   * GC allocated as usual. */
+  struct arena_object : gc
+  {
+    using gc::operator new;
+    using gc::operator delete;
+
+    static void *operator new(size_t size, GCPlacement placement);
+    /* Arena memory is released in bulk and GC memory is reclaimed by the collector, so
+     * there's nothing to do on delete. */
+    static void operator delete(void *p);
+    static void operator delete(void *p, GCPlacement placement);
+  };
+
+  /* A standard allocator which uses whichever arena was current when it was constructed.
+   * Containers keep their allocator, so they don't start pulling from a nested arena
+   * partway through their life. */
+  template <typename T>
+  struct arena_allocator
+  {
+    using value_type = T;
+
+    arena_allocator() noexcept
+      : source{ current_arena() }
+    {
+    }
+
+    template <typename U>
+    arena_allocator(arena_allocator<U> const &o) noexcept
+      : source{ o.source }
+    {
+    }
+
+    T *allocate(size_t const n)
+    {
+      return static_cast<T *>(arena_allocate(source, n * sizeof(T)));
+    }
+
+    void deallocate(T *, size_t) noexcept
+    {
+    }
+
+    template <typename U>
+    native_bool operator==(arena_allocator<U> const &o) const noexcept
+    {
+      return source == o.source;
+    }
+
+    arena *source{};
+  };
+
+  template <typename K, typename V, typename Hash = std::hash<K>, typename Pred = std::equal_to<K>>
+  using arena_unordered_map
+    = std::unordered_map<K, V, Hash, Pred, arena_allocator<std::pair<K const, V>>>;
+}
@@ -19,7 +19,15 @@ namespace jank::util::cli
     native_transient_string module_path;
     native_bool profiler_enabled{};
     native_transient_string profiler_file{ "jank.profile" };
+    native_bool alloc_profiler_enabled{};
+    native_integer alloc_profiler_sample_rate{ 1 };
     native_bool gc_incremental{};
+    native_integer gc_initial_heap_size{};
+    native_integer gc_free_space_divisor{};
+    native_integer gc_markers{};
+    native_integer gc_pause_target_ms{};
+    native_bool perf_map_enabled{};
+    native_bool jit_debug_enabled{};
 
     /* Native dependencies. */
     native_vector<native_persistent_string> include_dirs;
@@ -29,6 +37,8 @@ namespace jank::util::cli
 
     /* Compilation. */
     native_integer optimization_level{};
+    native_transient_string target_cpu;
+    native_bool direct_linking{};
 
     /* Run command. */
     native_transient_string target_file;
@@ -9,11 +9,15 @@ namespace jank::util
   native_persistent_string const &user_config_dir();
   native_persistent_string const &
   binary_cache_dir(native_integer const optimization_level,
+                   native_persistent_string const &target_cpu,
+                   native_bool const direct_linking,
                    native_vector<native_persistent_string> const &includes,
                    native_vector<native_persistent_string> const &defines);
 
   native_persistent_string const &
   binary_version(native_integer const optimization_level,
+                 native_persistent_string const &target_cpu,
+                 native_bool const direct_linking,
                  native_vector<native_persistent_string> const &includes,
                  native_vector<native_persistent_string> const &defines);
 }
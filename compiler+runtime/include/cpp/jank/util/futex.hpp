@@ -0,0 +1,25 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <jank/type.hpp>
+#include <jank/option.hpp>
+
+namespace jank::util::futex
+{
+  /* Blocks while the word still holds the expected value, without spinning. On Linux,
+   * this goes straight to the kernel's futex. Elsewhere, waiters park on one of a fixed
+   * set of condition variables, picked by address, so the word itself never needs more
+   * than its four bytes.
+   *
+   * Waking up doesn't mean the word has changed, so callers need to check it again. Returns
+   * false only if the timeout passed. */
+  native_bool wait(std::atomic<uint32_t> &word,
+                   uint32_t expected,
+                   option<std::chrono::nanoseconds> const &timeout);
+
+  /* Wakes every thread waiting on the word. */
+  void wake_all(std::atomic<uint32_t> &word);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+#include <jank/type.hpp>
+
+namespace jank::util
+{
+  /* Runs a piece of code at most once, even when many threads get to it at the same time.
+   * This is what we build realization on, for things like lazy sequences and delays.
+   *
+   * Once it's done, checking is just an acquire load, so realized objects don't pay for
+   * any locking. Until then, the first thread to get there runs the code while the others
+   * wait for it. If that code throws, nothing is marked as done and the next caller will
+   * try again. Callers which want to remember failures need to store them as the result.
+   *
+   * Realizing something from within its own realization would never finish, so that's
+   * reported as an error instead of deadlocking. */
+  struct once
+  {
+    enum class state : uint8_t
+    {
+      pending,
+      running,
+      done
+    };
+
+    once() = default;
+    /* Starts out done, for objects which are created already realized. */
+    explicit once(native_bool done);
+
+    native_bool is_done() const
+    {
+      return current.load(std::memory_order_acquire) == state::done;
+    }
+
+    template <typename F>
+    void call(F &&f)
+    {
+      if(is_done() || !begin())
+      {
+        return;
+      }
+
+      try
+      {
+        f();
+      }
+      catch(...)
+      {
+        finish(state::pending);
+        throw;
+      }
+      finish(state::done);
+    }
+
+  private:
+    /* Returns true when the caller needs to run the code. Otherwise, it's been done,
+     * possibly by another thread which we waited for. */
+    native_bool begin();
+    void finish(state s);
+
+  public:
+    std::atomic<state> current{ state::pending };
+    std::atomic<std::thread::id> owner;
+  };
+}
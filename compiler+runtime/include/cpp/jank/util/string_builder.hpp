@@ -11,6 +11,9 @@ namespace jank::util
     using value_type = char;
     using traits_type = std::char_traits<value_type>;
 
+    /* Receives everything which has been buffered so far. */
+    using sink_fn = void (*)(void *data, value_type const *s, size_t size);
+
     string_builder();
     string_builder(size_t capacity);
     string_builder(string_builder const &) = delete;
@@ -32,6 +35,7 @@ namespace jank::util
     string_builder &operator()(char const *d) &;
     string_builder &operator()(native_transient_string const &d) &;
     string_builder &operator()(native_persistent_string const &d) &;
+    string_builder &operator()(native_persistent_string_view const &d) &;
 
     void push_back(native_bool d) &;
     void push_back(native_integer d) &;
@@ -45,6 +49,7 @@ namespace jank::util
     void push_back(char const *d) &;
     void push_back(native_transient_string const &d) &;
     void push_back(native_persistent_string const &d) &;
+    void push_back(native_persistent_string_view const &d) &;
 
     void reserve(size_t capacity);
     value_type *data() const;
@@ -54,8 +59,17 @@ namespace jank::util
     native_transient_string str() const;
     native_persistent_string_view view() const &;
 
+    /* Hands everything buffered so far to the sink, if there is one. */
+    void drain();
+
     value_type *buffer{};
     size_t pos{};
     size_t capacity{ initial_capacity };
+
+    /* When there's a sink, the builder doesn't grow to fit everything written to it.
+     * Whenever it runs out of room, it drains into the sink and starts over, so large
+     * output can be streamed through a fixed size buffer. */
+    sink_fn sink{};
+    void *sink_data{};
   };
 }
@@ -1,3 +1,5 @@
+#include <array>
+
 #include <fmt/format.h>
 
 #include <jank/native_persistent_string/fmt.hpp>
@@ -6,6 +8,7 @@
 #include <jank/runtime/core.hpp>
 #include <jank/runtime/core/meta.hpp>
 #include <jank/runtime/context.hpp>
+#include <jank/runtime/executor.hpp>
 #include <jank/runtime/behavior/callable.hpp>
 #include <jank/runtime/visit.hpp>
 
@@ -171,6 +174,179 @@ namespace clojure::core_native
     return try_object<obj::multi_function>(multifn)->prefer_table;
   }
 
+  static object_ptr is_protocol_fn(object_ptr const o)
+  {
+    return make_box(o->type == object_type::protocol_function);
+  }
+
+  static object_ptr protocol_fn(object_ptr const protocol_name, object_ptr const name)
+  {
+    return make_box<obj::protocol_function>(protocol_name, name);
+  }
+
+  static object_ptr
+  extend_protocol_fn(object_ptr const protocol_fn, object_ptr const type, object_ptr const fn)
+  {
+    return try_object<obj::protocol_function>(protocol_fn)->extend(type, fn);
+  }
+
+  static object_ptr protocol_fn_extends(object_ptr const protocol_fn, object_ptr const o)
+  {
+    return make_box(try_object<obj::protocol_function>(protocol_fn)->find_fn(o)
+                    != obj::nil::nil_const());
+  }
+
+  static object_ptr protocol_fn_extensions(object_ptr const protocol_fn)
+  {
+    return try_object<obj::protocol_function>(protocol_fn)->get_extensions();
+  }
+
+  static object_ptr
+  record_type(object_ptr const name, object_ptr const fields, object_ptr const is_record)
+  {
+    return make_box<obj::record_type>(name, fields, truthy(is_record));
+  }
+
+  static object_ptr is_record(object_ptr const o)
+  {
+    return make_box(o->type == object_type::record
+                    && expect_object<obj::record>(o)->type->is_record);
+  }
+
+  template <typename... Args>
+  static object *create_record(object * const type, Args * const... values)
+  {
+    std::array<object_ptr, sizeof...(Args)> const fields{ values... };
+    return &obj::record::create(try_object<obj::record_type>(type), fields.data(), fields.size())
+              ->base;
+  }
+
+  static object_ptr new_record(object_ptr const type, object_ptr const values)
+  {
+    return obj::record::create(try_object<obj::record_type>(type), values);
+  }
+
+  /* Fields missing from the map are nil and any other keys are kept. */
+  static object_ptr map_to_record(object_ptr const type, object_ptr const m)
+  {
+    auto const typed_type(try_object<obj::record_type>(type));
+    native_vector<object_ptr> fields;
+    fields.reserve(typed_type->fields.size());
+    for(auto const &field : typed_type->fields)
+    {
+      fields.emplace_back(runtime::get(m, field));
+    }
+
+    object_ptr ret{ obj::record::create(typed_type, fields.data(), fields.size()) };
+    for(auto it(fresh_seq(m)); it != obj::nil::nil_const(); it = next_in_place(it))
+    {
+      auto const entry(first(it));
+      auto const key(first(entry));
+      if(typed_type->field_index(key).is_none())
+      {
+        ret = runtime::assoc(ret, key, second(entry));
+      }
+    }
+    return ret;
+  }
+
+  static object_ptr record_basis(object_ptr const type)
+  {
+    return try_object<obj::record_type>(type)->basis;
+  }
+
+  static object_ptr agent(object_ptr const state)
+  {
+    return make_box<obj::agent>(state);
+  }
+
+  static object_ptr is_agent(object_ptr const o)
+  {
+    return make_box(o->type == object_type::agent);
+  }
+
+  static object_ptr send(object_ptr const a, object_ptr const fn, object_ptr const args)
+  {
+    return try_object<obj::agent>(a)->dispatch(fn, args, executor::pooled());
+  }
+
+  static object_ptr send_off(object_ptr const a, object_ptr const fn, object_ptr const args)
+  {
+    return try_object<obj::agent>(a)->dispatch(fn, args, executor::solo());
+  }
+
+  static object_ptr release_pending_sends()
+  {
+    return make_box(static_cast<native_integer>(obj::agent::release_pending_sends()));
+  }
+
+  static object_ptr agent_error(object_ptr const a)
+  {
+    return try_object<obj::agent>(a)->get_error();
+  }
+
+  static object_ptr
+  restart_agent(object_ptr const a, object_ptr const new_state, object_ptr const clear_actions)
+  {
+    return try_object<obj::agent>(a)->restart(new_state, truthy(clear_actions));
+  }
+
+  static object_ptr set_error_handler(object_ptr const a, object_ptr const fn)
+  {
+    try_object<obj::agent>(a)->set_error_handler(fn);
+    return obj::nil::nil_const();
+  }
+
+  static object_ptr error_handler(object_ptr const a)
+  {
+    return try_object<obj::agent>(a)->get_error_handler();
+  }
+
+  static object_ptr set_error_mode(object_ptr const a, object_ptr const mode)
+  {
+    try_object<obj::agent>(a)->set_error_mode(mode);
+    return obj::nil::nil_const();
+  }
+
+  static object_ptr error_mode(object_ptr const a)
+  {
+    return try_object<obj::agent>(a)->get_error_mode();
+  }
+
+  static object_ptr set_agent_validator(object_ptr const a, object_ptr const fn)
+  {
+    try_object<obj::agent>(a)->set_validator(fn);
+    return obj::nil::nil_const();
+  }
+
+  static object_ptr agent_validator(object_ptr const a)
+  {
+    return try_object<obj::agent>(a)->get_validator();
+  }
+
+  static object_ptr agent_queue_count(object_ptr const a)
+  {
+    return make_box(static_cast<native_integer>(try_object<obj::agent>(a)->queue_count()));
+  }
+
+  static object_ptr await(object_ptr const agents)
+  {
+    obj::agent::await(agents, none);
+    return obj::nil::nil_const();
+  }
+
+  static object_ptr await_for(object_ptr const timeout_ms, object_ptr const agents)
+  {
+    return make_box(obj::agent::await(agents, to_int(timeout_ms)));
+  }
+
+  static object_ptr shutdown_agents()
+  {
+    executor::pooled().shutdown();
+    executor::solo().shutdown();
+    return obj::nil::nil_const();
+  }
+
   static object_ptr sleep(object_ptr const ms)
   {
     std::this_thread::sleep_for(std::chrono::milliseconds(to_int(ms)));
@@ -357,6 +533,10 @@ jank_object_ptr jank_load_clojure_core_native()
   intern_fn("associative?", &is_associative);
   intern_fn("assoc", &assoc);
   intern_fn("pr-str", static_cast<native_persistent_string (*)(object const *)>(&to_code_string));
+  intern_fn("newline", &newline);
+  intern_fn("flush", &flush);
+  intern_fn("string-writer", &string_writer);
+  intern_fn("writer?", &is_writer);
   intern_fn("string?", &is_string);
   intern_fn("char?", &is_char);
   intern_fn("to-string", static_cast<native_persistent_string (*)(object const *)>(&to_string));
@@ -396,6 +576,9 @@ jank_object_ptr jank_load_clojure_core_native()
   intern_fn("volatile!", &volatile_);
   intern_fn("volatile?", &is_volatile);
   intern_fn("vreset!", &vreset);
+  intern_fn("promise", &promise);
+  intern_fn("deliver", &deliver);
+  intern_fn("blocking-deref", &blocking_deref);
   intern_fn("+", static_cast<object_ptr (*)(object_ptr, object_ptr)>(&add));
   intern_fn("-", static_cast<object_ptr (*)(object_ptr, object_ptr)>(&sub));
   intern_fn("/", static_cast<object_ptr (*)(object_ptr, object_ptr)>(&div));
@@ -477,6 +660,7 @@ jank_object_ptr jank_load_clojure_core_native()
   intern_fn("iterate", &iterate);
   intern_fn("delay*", &core_native::delay);
   intern_fn("force", &force);
+  intern_fn("realized?", &is_realized);
   intern_fn("ifn?", &is_callable);
   intern_fn("fn?", &core_native::is_fn);
   intern_fn("multi-fn?", &core_native::is_multi_fn);
@@ -488,10 +672,37 @@ jank_object_ptr jank_load_clojure_core_native()
   intern_fn("methods", &core_native::methods);
   intern_fn("get-method", &core_native::get_method);
   intern_fn("prefers", &core_native::prefers);
+  intern_fn("protocol-fn?", &core_native::is_protocol_fn);
+  intern_fn("protocol-fn*", &core_native::protocol_fn);
+  intern_fn("extend-protocol-fn*", &core_native::extend_protocol_fn);
+  intern_fn("protocol-fn-extends?", &core_native::protocol_fn_extends);
+  intern_fn("protocol-fn-extensions", &core_native::protocol_fn_extensions);
+  intern_fn("record-type*", &core_native::record_type);
+  intern_fn("record?", &core_native::is_record);
+  intern_fn("new-record*", &core_native::new_record);
+  intern_fn("map->record*", &core_native::map_to_record);
+  intern_fn("record-basis", &core_native::record_basis);
   intern_val("int-min", std::numeric_limits<native_integer>::min());
   intern_val("int-max", std::numeric_limits<native_integer>::max());
   intern_val("int32-min", std::numeric_limits<int32_t>::min());
   intern_val("int32-max", std::numeric_limits<int32_t>::max());
+  intern_fn("agent*", &core_native::agent);
+  intern_fn("agent?", &core_native::is_agent);
+  intern_fn("send*", &core_native::send);
+  intern_fn("send-off*", &core_native::send_off);
+  intern_fn("release-pending-sends", &core_native::release_pending_sends);
+  intern_fn("agent-error", &core_native::agent_error);
+  intern_fn("restart-agent*", &core_native::restart_agent);
+  intern_fn("set-error-handler!", &core_native::set_error_handler);
+  intern_fn("error-handler", &core_native::error_handler);
+  intern_fn("set-error-mode!", &core_native::set_error_mode);
+  intern_fn("error-mode", &core_native::error_mode);
+  intern_fn("set-agent-validator!", &core_native::set_agent_validator);
+  intern_fn("agent-validator", &core_native::agent_validator);
+  intern_fn("agent-queue-count", &core_native::agent_queue_count);
+  intern_fn("await*", &core_native::await);
+  intern_fn("await-for*", &core_native::await_for);
+  intern_fn("shutdown-agents", &core_native::shutdown_agents);
   intern_fn("sleep", &core_native::sleep);
   intern_fn("current-time", &core_native::current_time);
   intern_fn("create-ns", &core_native::intern_ns);
@@ -519,7 +730,6 @@ jank_object_ptr jank_load_clojure_core_native()
   intern_fn("tagged-literal", &tagged_literal);
   intern_fn("tagged-literal?", &is_tagged_literal);
   intern_fn("sorted?", &is_sorted);
-  intern_fn("sort", &sort);
   intern_fn("shuffle", &shuffle);
 
   /* TODO: jank.math? */
@@ -814,5 +1024,46 @@ jank_object_ptr jank_load_clojure_core_native()
     intern_fn_obj("repeat", fn);
   }
 
+  {
+    auto const fn(
+      make_box<obj::jit_function>(behavior::callable::build_arity_flags(2, false, false)));
+    fn->arity_1 = [](object * const coll) -> object * { return sort(coll); };
+    fn->arity_2 = [](object * const comp, object * const coll) -> object * {
+      return sort(comp, coll);
+    };
+    intern_fn_obj("sort", fn);
+  }
+
+  {
+    auto const fn(
+      make_box<obj::jit_function>(behavior::callable::build_arity_flags(3, false, false)));
+    fn->arity_2 = [](object * const keyfn, object * const coll) -> object * {
+      return sort_by(keyfn, coll);
+    };
+    fn->arity_3 = [](object * const keyfn, object * const comp, object * const coll) -> object * {
+      return sort_by(keyfn, comp, coll);
+    };
+    intern_fn_obj("sort-by", fn);
+  }
+
+  {
+    /* Positional construction of records with up to nine fields, without packing them
+     * into a collection first. Bigger records go through new-record*. */
+    auto const fn(
+      make_box<obj::jit_function>(behavior::callable::build_arity_flags(10, false, false)));
+    fn->arity_1 = &create_record<>;
+    fn->arity_2 = &create_record<object>;
+    fn->arity_3 = &create_record<object, object>;
+    fn->arity_4 = &create_record<object, object, object>;
+    fn->arity_5 = &create_record<object, object, object, object>;
+    fn->arity_6 = &create_record<object, object, object, object, object>;
+    fn->arity_7 = &create_record<object, object, object, object, object, object>;
+    fn->arity_8 = &create_record<object, object, object, object, object, object, object>;
+    fn->arity_9 = &create_record<object, object, object, object, object, object, object, object>;
+    fn->arity_10
+      = &create_record<object, object, object, object, object, object, object, object, object>;
+    intern_fn_obj("create-record*", fn);
+  }
+
   return erase(obj::nil::nil_const());
 }
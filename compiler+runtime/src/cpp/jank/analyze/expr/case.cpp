@@ -14,7 +14,9 @@ namespace jank::analyze::expr
                native_integer const mask,
                expression_ptr const default_expr,
                native_vector<native_integer> &&keys,
-               native_vector<expression_ptr> &&exprs)
+               native_vector<expression_ptr> &&exprs,
+               case_test_type const test_type,
+               native_vector<option<expression_ptr>> &&tests)
     : expression{ expr_kind, position, frame, needs_box }
     , value_expr{ value_expr }
     , shift{ shift }
@@ -22,6 +24,8 @@ namespace jank::analyze::expr
     , default_expr{ default_expr }
     , keys{ std::move(keys) }
     , exprs{ std::move(exprs) }
+    , test_type{ test_type }
+    , tests{ std::move(tests) }
   {
   }
 
@@ -40,17 +44,40 @@ namespace jank::analyze::expr
     auto pairs{ make_box<obj::persistent_vector>() };
     for(size_t i{}; i < keys.size(); ++i)
     {
+      object_ptr test{ obj::nil::nil_const() };
+      if(tests[i].is_some())
+      {
+        test = tests[i].unwrap()->to_runtime_data();
+      }
       pairs = pairs->conj(make_box<obj::persistent_vector>(std::in_place,
                                                            make_box(keys[i]),
+                                                           test,
                                                            exprs[i]->to_runtime_data()));
     }
 
+    native_persistent_string_view test_type_str{ "unchecked" };
+    switch(test_type)
+    {
+      case case_test_type::unchecked:
+        break;
+      case case_test_type::integer:
+        test_type_str = "integer";
+        break;
+      case case_test_type::keyword:
+        test_type_str = "keyword";
+        break;
+      case case_test_type::hash:
+        test_type_str = "hash";
+        break;
+    }
+
     return merge(expression::to_runtime_data(),
                  obj::persistent_hash_map::create_unique(
                    std::make_pair(make_box("value_expr"), value_expr->to_runtime_data()),
                    std::make_pair(make_box("pairs"), pairs),
                    std::make_pair(make_box(shift), make_box("shift")),
                    std::make_pair(make_box("mask"), make_box(mask)),
+                   std::make_pair(make_box("test_type"), make_box(test_type_str)),
                    std::make_pair(make_box("default_expr"), default_expr->to_runtime_data())));
   }
 }
@@ -222,7 +222,7 @@ namespace jank::analyze
       }
       value_expr = some(value_result.expect_ok());
 
-      vars.insert_or_assign(var.expect_ok(), value_expr.unwrap());
+      vars.insert_or_assign(var.expect_ok(), var_info{ value_expr.unwrap()->kind });
     }
 
     if(has_docstring)
@@ -261,12 +261,20 @@ namespace jank::analyze
   {
     auto const pop_macro_expansions{ push_macro_expansions(*this, o) };
 
-    if(auto const length(o->count()); length != 6)
+    /* There are two forms of case*. The checked form, which the case macro generates, is
+     * (case* value shift mask default {key [test expr]} test-type skip-check). The test type
+     * is one of :int, :hash-identity, or :hash-equiv and the skip-check set has the keys
+     * whose expression already checks the value, since several tests share a hash. The
+     * unchecked form is (case* value shift mask default {key expr}), where every
+     * expression checks the value itself. */
+    auto const length(o->count());
+    if(length != 6 && length != 8)
     {
-      return error::analysis_invalid_case("Invalid case*: exactly 6 parameters are needed.",
+      return error::analysis_invalid_case("Invalid case*: exactly 6 or 8 parameters are needed.",
                                           meta_source(o->meta),
                                           add_top_expansion(macro_expansions));
     }
+    auto const checked(length == 8);
 
     auto it{ o->data.rest() };
     if(it.first().is_none())
@@ -335,10 +343,47 @@ namespace jank::analyze
     }
     auto const imap_obj{ it.first().unwrap() };
 
+    auto test_type{ expr::case_test_type::unchecked };
+    object_ptr skip_check{ obj::nil::nil_const() };
+    if(checked)
+    {
+      it = it.rest();
+      auto const test_type_obj{ it.first().unwrap() };
+      if(runtime::equal(test_type_obj, rt_ctx.intern_keyword("int").expect_ok()))
+      {
+        test_type = expr::case_test_type::integer;
+      }
+      else if(runtime::equal(test_type_obj, rt_ctx.intern_keyword("hash-identity").expect_ok()))
+      {
+        test_type = expr::case_test_type::keyword;
+      }
+      else if(runtime::equal(test_type_obj, rt_ctx.intern_keyword("hash-equiv").expect_ok()))
+      {
+        test_type = expr::case_test_type::hash;
+      }
+      else
+      {
+        return error::analysis_invalid_case(
+          "Test type should be one of :int, :hash-identity, or :hash-equiv.",
+          meta_source(o->meta),
+          add_top_expansion(macro_expansions));
+      }
+
+      it = it.rest();
+      skip_check = it.first().unwrap();
+      if(!visit_set_like([](auto const) { return true; }, []() { return false; }, skip_check))
+      {
+        return error::analysis_invalid_case("Skip check value should be a set.",
+                                            meta_source(o->meta),
+                                            add_top_expansion(macro_expansions));
+      }
+    }
+
     struct keys_and_exprs
     {
       native_vector<native_integer> keys{};
       native_vector<expression_ptr> exprs{};
+      native_vector<option<expression_ptr>> tests{};
     };
 
     auto keys_exprs{ visit_map_like(
@@ -354,13 +399,44 @@ namespace jank::analyze
             return err("Map key for case* is expected to be an integer.");
           }
           auto const key{ runtime::expect_object<obj::integer>(k_obj) };
-          auto const expr{ analyze(v_obj, f, position, fc, needs_box) };
+
+          auto expr_obj{ v_obj };
+          option<expression_ptr> test;
+          if(checked)
+          {
+            if(v_obj->type != object_type::persistent_vector
+               || runtime::sequence_length(v_obj) != 2)
+            {
+              return err("Map value for case* is expected to be a [test expression] vector.");
+            }
+            expr_obj = runtime::nth(v_obj, make_box(1));
+            if(!runtime::contains(skip_check, k_obj))
+            {
+              auto const test_obj{ runtime::nth(v_obj, make_box(0)) };
+              if((test_type == expr::case_test_type::integer
+                  && test_obj->type != object_type::integer)
+                 || (test_type == expr::case_test_type::keyword
+                     && test_obj->type != object_type::keyword))
+              {
+                return err("Test constant for case* doesn't match its test type.");
+              }
+              test = analyze_primitive_literal(test_obj,
+                                               f,
+                                               expression_position::value,
+                                               fc,
+                                               true)
+                       .expect_ok();
+            }
+          }
+
+          auto const expr{ analyze(expr_obj, f, position, fc, needs_box) };
           if(expr.is_err())
           {
             return err(expr.expect_err()->message);
           }
           ret.keys.push_back(key->data);
           ret.exprs.push_back(expr.expect_ok());
+          ret.tests.push_back(test);
         }
         return ret;
       },
@@ -386,7 +462,9 @@ namespace jank::analyze
                                  mask->data,
                                  default_expr.expect_ok(),
                                  std::move(pairs.keys),
-                                 std::move(pairs.exprs));
+                                 std::move(pairs.exprs),
+                                 test_type,
+                                 std::move(pairs.tests));
   }
 
   processor::expression_result processor::analyze_symbol(runtime::obj::symbol_ptr const sym,
@@ -1548,34 +1626,17 @@ namespace jank::analyze
     /* TODO: Detect literal and act accordingly. */
     return visit_map_like(
       [&](auto const typed_o) -> processor::expression_result {
-        using T = typename decltype(typed_o)::value_type;
-
         native_vector<std::pair<expression_ptr, expression_ptr>> exprs;
         exprs.reserve(typed_o->data.size());
 
         for(auto const &kv : typed_o->data)
         {
-          /* The two maps (hash and sorted) have slightly different iterators, so we need to
-           * pull out the entries differently. */
-          object_ptr first{}, second{};
-          if constexpr(std::same_as<T, obj::persistent_sorted_map>)
-          {
-            auto const &entry(kv.get());
-            first = entry.first;
-            second = entry.second;
-          }
-          else
-          {
-            first = kv.first;
-            second = kv.second;
-          }
-
-          auto k_expr(analyze(first, current_frame, expression_position::value, fn_ctx, true));
+          auto k_expr(analyze(kv.first, current_frame, expression_position::value, fn_ctx, true));
           if(k_expr.is_err())
           {
             return k_expr.expect_err_move();
           }
-          auto v_expr(analyze(second, current_frame, expression_position::value, fn_ctx, true));
+          auto v_expr(analyze(kv.second, current_frame, expression_position::value, fn_ctx, true));
           if(v_expr.is_err())
           {
             return v_expr.expect_err_move();
@@ -1714,7 +1775,7 @@ namespace jank::analyze
            * tell us what we need. */
           if(fn_res != vars.end())
           {
-            if(fn_res->second.data->kind != expression_kind::function)
+            if(fn_res->second.kind != expression_kind::function)
             {
               return error::internal_analysis_failure("Unsupported arity meta on non-function var.",
                                                       object_source(first),
@@ -1740,11 +1801,14 @@ namespace jank::analyze
       source = callable_expr.expect_ok_move();
     }
 
+    /* Calls with more args than max_params aren't packed here. Codegen passes all of them as
+     * an array and dynamic_call builds the rest param the callee actually wants, based on its
+     * highest fixed arity flag. */
     native_vector<expression_ptr> arg_exprs;
-    arg_exprs.reserve(std::min(arg_count, runtime::max_params + 1));
+    arg_exprs.reserve(arg_count);
 
     auto it(o->data.rest());
-    for(size_t i{}; i < runtime::max_params && i < arg_count; ++i, it = it.rest())
+    for(size_t i{}; i < arg_count; ++i, it = it.rest())
     {
       auto arg_expr(analyze(it.first().unwrap(),
                             current_frame,
@@ -1758,35 +1822,6 @@ namespace jank::analyze
       arg_exprs.emplace_back(arg_expr.expect_ok());
     }
 
-    /* If we have more args than a fn allows, we need to pack all of the extras
-     * into a single list and tack that on at the end. So, if max_params is 10, and
-     * we pass 15 args, we'll pass 10 normally and then we'll have a special 11th
-     * arg which is a list containing the 5 remaining params. We rely on dynamic_call
-     * to do the hard work of packing that in the shape the function actually wants,
-     * based on its highest fixed arity flag. */
-    if(runtime::max_params < arg_count)
-    {
-      native_vector<expression_ptr> packed_arg_exprs;
-      for(size_t i{ runtime::max_params }; i < arg_count; ++i, it = it.rest())
-      {
-        auto arg_expr(analyze(it.first().unwrap(),
-                              current_frame,
-                              expression_position::value,
-                              fn_ctx,
-                              needs_arg_box));
-        if(arg_expr.is_err())
-        {
-          return arg_expr;
-        }
-        packed_arg_exprs.emplace_back(arg_expr.expect_ok());
-      }
-      arg_exprs.emplace_back(make_box<expr::list>(expression_position::value,
-                                                  current_frame,
-                                                  needs_arg_box,
-                                                  std::move(packed_arg_exprs),
-                                                  none));
-    }
-
     auto const recursion_ref(llvm::dyn_cast<expr::recursion_reference>(source.data));
     if(recursion_ref)
     {
@@ -1903,4 +1938,15 @@ namespace jank::analyze
     auto const found_special(specials.find(sym));
     return found_special != specials.end();
   }
+
+  allocation_scope::allocation_scope(processor &an_prc)
+    : an_prc{ an_prc }
+    , root_parent{ an_prc.root_frame->parent }
+  {
+  }
+
+  allocation_scope::~allocation_scope()
+  {
+    an_prc.root_frame->parent = root_parent;
+  }
 }
@@ -0,0 +1,98 @@
+#include <jank/async_native.hpp>
+#include <jank/runtime/convert.hpp>
+#include <jank/runtime/context.hpp>
+#include <jank/runtime/core.hpp>
+#include <jank/runtime/obj/channel.hpp>
+#include <jank/runtime/obj/native_function_wrapper.hpp>
+#include <jank/runtime/obj/persistent_hash_map.hpp>
+#include <jank/runtime/obj/keyword.hpp>
+
+namespace jank::async_native
+{
+  using namespace jank;
+  using namespace jank::runtime;
+
+  static object_ptr chan(object_ptr const capacity)
+  {
+    auto const n(to_int(capacity));
+    if(n <= 0)
+    {
+      throw std::runtime_error{ "Channel capacity must be positive" };
+    }
+    return make_box<obj::channel>(static_cast<size_t>(n));
+  }
+
+  static object_ptr is_chan(object_ptr const o)
+  {
+    return make_box(o->type == object_type::channel);
+  }
+
+  static object_ptr put(object_ptr const ch, object_ptr const val)
+  {
+    return make_box(try_object<obj::channel>(ch)->put(val));
+  }
+
+  static object_ptr take(object_ptr const ch)
+  {
+    return try_object<obj::channel>(ch)->take();
+  }
+
+  static object_ptr offer(object_ptr const ch, object_ptr const val)
+  {
+    return make_box(try_object<obj::channel>(ch)->offer(val));
+  }
+
+  static object_ptr poll(object_ptr const ch)
+  {
+    auto const ret(try_object<obj::channel>(ch)->poll());
+    return ret ? object_ptr{ ret } : obj::nil::nil_const();
+  }
+
+  static object_ptr close(object_ptr const ch)
+  {
+    try_object<obj::channel>(ch)->close();
+    return obj::nil::nil_const();
+  }
+
+  static object_ptr is_closed(object_ptr const ch)
+  {
+    return make_box(try_object<obj::channel>(ch)->is_closed());
+  }
+
+  static object_ptr alts(object_ptr const ops,
+                         object_ptr const priority,
+                         object_ptr const has_default,
+                         object_ptr const default_val)
+  {
+    return obj::channel::alts(ops,
+                              truthy(priority),
+                              truthy(has_default) ? option<object_ptr>{ default_val } : none);
+  }
+}
+
+jank_object_ptr jank_load_jank_async_native()
+{
+  using namespace jank;
+  using namespace jank::runtime;
+
+  auto const ns(__rt_ctx->intern_ns("jank.async-native"));
+
+  auto const intern_fn([=](native_persistent_string const &name, auto const fn) {
+    ns->intern_var(name)->bind_root(
+      make_box<obj::native_function_wrapper>(convert_function(fn))
+        ->with_meta(obj::persistent_hash_map::create_unique(std::make_pair(
+          __rt_ctx->intern_keyword("name").expect_ok(),
+          make_box(obj::symbol{ __rt_ctx->current_ns()->to_string(), name }.to_string())))));
+  });
+  intern_fn("chan", &async_native::chan);
+  intern_fn("chan?", &async_native::is_chan);
+  intern_fn("put", &async_native::put);
+  intern_fn("take", &async_native::take);
+  intern_fn("offer", &async_native::offer);
+  intern_fn("poll", &async_native::poll);
+  intern_fn("close", &async_native::close);
+  intern_fn("closed?", &async_native::is_closed);
+  intern_fn("alts", &async_native::alts);
+
+  return erase(obj::nil::nil_const());
+}
@@ -1,13 +1,18 @@
+#include <array>
 #include <cstdarg>
 #include <cstdint>
 
+#include <type_traits>
 #include <utility>
 
+#include <fmt/format.h>
+
 #include <jank/c_api.h>
 #include <jank/runtime/visit.hpp>
 #include <jank/runtime/context.hpp>
 #include <jank/runtime/core.hpp>
 #include <jank/profile/time.hpp>
+#include <jank/profile/allocation.hpp>
 #include <jank/util/scope_exit.hpp>
 
 using namespace jank;
@@ -37,6 +42,73 @@ struct make_closure_arity<std::index_sequence<>>
 template <size_t N>
 using closure_arity = typename make_closure_arity<std::make_index_sequence<N>>::type;
 
+/* Calls through an inline cache, if the callee turns out to be the kind of object the cache
+ * is for. Otherwise, it's just a normal call. */
+template <typename F, size_t... Is>
+static object_ptr call_through_site(typename F::call_site &site,
+                                    object_ptr const f,
+                                    std::array<object_ptr, runtime::max_params> const &args,
+                                    std::index_sequence<Is...>)
+{
+  if constexpr(std::is_same_v<F, obj::protocol_function> && sizeof...(Is) == 0)
+  {
+    /* Protocol fns dispatch on their first arg, so there's nothing to cache. */
+    return dynamic_call(f);
+  }
+  else
+  {
+    if(f->type == F::obj_type)
+    {
+      return expect_object<F>(f)->call(site, args[Is]...);
+    }
+    return dynamic_call(f, args[Is]...);
+  }
+}
+
+template <typename F>
+static object_ptr call_through_site(void * const site,
+                                    object_ptr const f,
+                                    uint64_t const arity,
+                                    va_list args)
+{
+  auto &site_ref(*reinterpret_cast<typename F::call_site *>(site));
+
+  std::array<object_ptr, runtime::max_params> arg_objs;
+  for(uint64_t i{}; i < arity; ++i)
+  {
+    /* NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg) */
+    arg_objs[i] = reinterpret_cast<object *>(va_arg(args, jank_object_ptr));
+  }
+
+  switch(arity)
+  {
+    case 0:
+      return call_through_site<F>(site_ref, f, arg_objs, std::make_index_sequence<0>{});
+    case 1:
+      return call_through_site<F>(site_ref, f, arg_objs, std::make_index_sequence<1>{});
+    case 2:
+      return call_through_site<F>(site_ref, f, arg_objs, std::make_index_sequence<2>{});
+    case 3:
+      return call_through_site<F>(site_ref, f, arg_objs, std::make_index_sequence<3>{});
+    case 4:
+      return call_through_site<F>(site_ref, f, arg_objs, std::make_index_sequence<4>{});
+    case 5:
+      return call_through_site<F>(site_ref, f, arg_objs, std::make_index_sequence<5>{});
+    case 6:
+      return call_through_site<F>(site_ref, f, arg_objs, std::make_index_sequence<6>{});
+    case 7:
+      return call_through_site<F>(site_ref, f, arg_objs, std::make_index_sequence<7>{});
+    case 8:
+      return call_through_site<F>(site_ref, f, arg_objs, std::make_index_sequence<8>{});
+    case 9:
+      return call_through_site<F>(site_ref, f, arg_objs, std::make_index_sequence<9>{});
+    case 10:
+      return call_through_site<F>(site_ref, f, arg_objs, std::make_index_sequence<10>{});
+    default:
+      throw std::runtime_error{ fmt::format("invalid call site arity: {}", arity) };
+  }
+}
+
 template <typename Is>
 struct make_function_arity;
 
@@ -310,43 +382,63 @@ extern "C"
                         a10_obj);
   }
 
-  jank_object_ptr jank_call11(jank_object_ptr const f,
-                              jank_object_ptr const a1,
-                              jank_object_ptr const a2,
-                              jank_object_ptr const a3,
-                              jank_object_ptr const a4,
-                              jank_object_ptr const a5,
-                              jank_object_ptr const a6,
-                              jank_object_ptr const a7,
-                              jank_object_ptr const a8,
-                              jank_object_ptr const a9,
-                              jank_object_ptr const a10,
-                              jank_object_ptr const rest)
+  jank_object_ptr jank_call_array(jank_object_ptr const f,
+                                  jank_object_ptr const * const args,
+                                  uint64_t const arg_count)
   {
     auto const f_obj(reinterpret_cast<object *>(f));
-    auto const a1_obj(reinterpret_cast<object *>(a1));
-    auto const a2_obj(reinterpret_cast<object *>(a2));
-    auto const a3_obj(reinterpret_cast<object *>(a3));
-    auto const a4_obj(reinterpret_cast<object *>(a4));
-    auto const a5_obj(reinterpret_cast<object *>(a5));
-    auto const a6_obj(reinterpret_cast<object *>(a6));
-    auto const a7_obj(reinterpret_cast<object *>(a7));
-    auto const a8_obj(reinterpret_cast<object *>(a8));
-    auto const a9_obj(reinterpret_cast<object *>(a9));
-    auto const a10_obj(reinterpret_cast<object *>(a10));
-    auto const rest_obj(reinterpret_cast<object *>(rest));
-    return dynamic_call(f_obj,
-                        a1_obj,
-                        a2_obj,
-                        a3_obj,
-                        a4_obj,
-                        a5_obj,
-                        a6_obj,
-                        a7_obj,
-                        a8_obj,
-                        a9_obj,
-                        a10_obj,
-                        try_object<obj::persistent_list>(rest_obj));
+    /* object_ptr is just a boxed pointer, so the array can be read in place. */
+    static_assert(sizeof(object_ptr) == sizeof(jank_object_ptr));
+    return dynamic_call(f_obj, reinterpret_cast<object_ptr const *>(args), arg_count);
+  }
+
+  jank_object_ptr
+  jank_call_site(void * const site, jank_object_ptr const f, uint64_t const arity, ...)
+  {
+    auto const f_obj(reinterpret_cast<object *>(f));
+
+    /* NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg) */
+    va_list args{};
+    va_start(args, arity);
+    util::scope_exit const done{ [&]() { va_end(args); } };
+    return call_through_site<obj::multi_function>(site, f_obj, arity, args);
+  }
+
+  jank_object_ptr
+  jank_protocol_call_site(void * const site, jank_object_ptr const f, uint64_t const arity, ...)
+  {
+    auto const f_obj(reinterpret_cast<object *>(f));
+
+    /* NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg) */
+    va_list args{};
+    va_start(args, arity);
+    util::scope_exit const done{ [&]() { va_end(args); } };
+    return call_through_site<obj::protocol_function>(site, f_obj, arity, args);
+  }
+
+  jank_object_ptr jank_keyword_lookup_site(void * const site,
+                                           jank_object_ptr const key,
+                                           jank_object_ptr const m,
+                                           jank_object_ptr const fallback)
+  {
+    auto const key_obj(reinterpret_cast<object *>(key));
+    auto const m_obj(reinterpret_cast<object *>(m));
+    if(m_obj->type == object_type::record)
+    {
+      auto &site_ref(*reinterpret_cast<obj::record::lookup_site *>(site));
+      object_ptr fallback_obj{ obj::nil::nil_const() };
+      if(fallback)
+      {
+        fallback_obj = reinterpret_cast<object *>(fallback);
+      }
+      return expect_object<obj::record>(m_obj)->get(site_ref, key_obj, fallback_obj);
+    }
+
+    if(fallback)
+    {
+      return runtime::get(m_obj, key_obj, reinterpret_cast<object *>(fallback));
+    }
+    return runtime::get(m_obj, key_obj);
   }
 
   jank_object_ptr jank_nil()
@@ -444,9 +536,22 @@ extern "C"
     va_list args{};
     va_start(args, pairs);
 
-    /* TODO: Could optimize to build an array map, if it's small enough. */
-    obj::transient_hash_map trans;
+    if(pairs <= obj::persistent_array_map::max_size)
+    {
+      obj::transient_array_map trans;
+      for(uint64_t i{}; i < pairs; ++i)
+      {
+        /* NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg) */
+        trans.assoc_in_place(reinterpret_cast<object *>(va_arg(args, jank_object_ptr)),
+                             /* NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg) */
+                             reinterpret_cast<object *>(va_arg(args, jank_object_ptr)));
+      }
 
+      va_end(args);
+      return erase(trans.to_persistent());
+    }
+
+    obj::transient_hash_map trans;
     for(uint64_t i{}; i < pairs; ++i)
     {
       /* NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg) */
@@ -486,9 +591,11 @@ extern "C"
                                                  is_variadic_ambiguous);
   }
 
-  jank_object_ptr jank_function_create(jank_arity_flags const arity_flags)
+  jank_object_ptr jank_function_create(jank_arity_flags const arity_flags, char const * const name)
   {
-    return erase(make_box<obj::jit_function>(arity_flags));
+    auto const ret(make_box<obj::jit_function>(arity_flags));
+    ret->name = name;
+    return erase(ret);
   }
 
   void jank_function_set_arity0(jank_object_ptr const fn, jank_object_ptr (* const f)())
@@ -871,6 +978,20 @@ extern "C"
       o_obj);
   }
 
+  void jank_function_set_code_owner(jank_object_ptr const fn, void * const owner)
+  {
+    auto const fn_obj(reinterpret_cast<object *>(fn));
+    auto const typed_owner(static_cast<jit::code_owner *>(owner));
+    if(fn_obj->type == object_type::jit_closure)
+    {
+      expect_object<obj::jit_closure>(fn_obj)->owner = typed_owner;
+    }
+    else
+    {
+      try_object<obj::jit_function>(fn_obj)->owner = typed_owner;
+    }
+  }
+
   void jank_throw(jank_object_ptr const o)
   {
     throw runtime::object_ptr{ reinterpret_cast<object *>(o) };
@@ -894,8 +1015,10 @@ extern "C"
     {
       return dynamic_call(try_fn_obj);
     }
+
     try
     {
+      profile::allocation::function_scope const alloc_fn;
       return dynamic_call(try_fn_obj);
     }
     catch(object_ptr const e)
@@ -918,4 +1041,21 @@ extern "C"
   {
     profile::report(label);
   }
+
+  void *jank_profile_alloc_intern(char const * const fn_name)
+  {
+    return profile::allocation::intern_function(fn_name);
+  }
+
+  void *jank_profile_alloc_push(void * const fn)
+  {
+    return profile::allocation::push_function(
+      static_cast<profile::allocation::function_handle>(fn));
+  }
+
+  void jank_profile_alloc_pop(void * const previous_fn)
+  {
+    profile::allocation::pop_function(
+      static_cast<profile::allocation::function_handle>(previous_fn));
+  }
 }
@@ -3,10 +3,6 @@
 #include <llvm/TargetParser/Host.h>
 #include <llvm/ExecutionEngine/Orc/LLJIT.h>
 #include <llvm/Passes/PassBuilder.h>
-#include <llvm/Transforms/InstCombine/InstCombine.h>
-#include <llvm/Transforms/Scalar/GVN.h>
-#include <llvm/Transforms/Scalar/Reassociate.h>
-#include <llvm/Transforms/Scalar/SimplifyCFG.h>
 
 #include <fmt/format.h>
 
@@ -20,6 +16,7 @@
 #include <jank/analyze/visit.hpp>
 #include <jank/analyze/rtti.hpp>
 #include <jank/profile/time.hpp>
+#include <jank/profile/allocation.hpp>
 
 /* TODO: Remove exceptions. */
 namespace jank::codegen
@@ -34,14 +31,13 @@ namespace jank::codegen
                                              *llvm_ctx) }
     , builder{ std::make_unique<llvm::IRBuilder<>>(*llvm_ctx) }
     , global_ctor_block{ llvm::BasicBlock::Create(*llvm_ctx, "entry") }
-    , fpm{ std::make_unique<llvm::FunctionPassManager>() }
     , lam{ std::make_unique<llvm::LoopAnalysisManager>() }
     , fam{ std::make_unique<llvm::FunctionAnalysisManager>() }
     , cgam{ std::make_unique<llvm::CGSCCAnalysisManager>() }
     , mam{ std::make_unique<llvm::ModuleAnalysisManager>() }
     , pic{ std::make_unique<llvm::PassInstrumentationCallbacks>() }
     , si{ std::make_unique<llvm::StandardInstrumentations>(*llvm_ctx,
-                                                           /*DebugLogging*/ true) }
+                                                           /*DebugLogging*/ false) }
   {
     /* The LLVM front-end tips documentation suggests setting the target triple and
      * data layout to improve back-end codegen performance. */
@@ -49,25 +45,43 @@ namespace jank::codegen
     module->setDataLayout(
       __rt_ctx->jit_prc.interpreter->getExecutionEngine().get().getDataLayout());
 
-    /* TODO: Configure these passes based on the CLI optimization flag. */
-
-    /* TODO: Add more passes and measure the order of the passes. */
-
     si->registerCallbacks(*pic, mam.get());
 
-    /* Do simple "peephole" optimizations and bit-twiddling optzns. */
-    fpm->addPass(llvm::InstCombinePass());
-    /* Reassociate expressions. */
-    fpm->addPass(llvm::ReassociatePass());
-    /* Eliminate Common SubExpressions. */
-    fpm->addPass(llvm::GVNPass());
-    /* Simplify the control flow graph (deleting unreachable blocks, etc). */
-    fpm->addPass(llvm::SimplifyCFGPass());
-
-    llvm::PassBuilder pb;
-    pb.registerModuleAnalyses(*mam);
-    pb.registerFunctionAnalyses(*fam);
-    pb.crossRegisterProxies(*lam, *fam, *cgam, *mam);
+    /* We use the same pipelines as Clang does for each level. Knowing the target machine
+     * lets the vectorizers and the inliner make use of its cost model. */
+    auto const &jit_prc(__rt_ctx->jit_prc);
+    llvm::PipelineTuningOptions tuning;
+    tuning.LoopVectorization = jit_prc.optimization_level >= 2;
+    tuning.SLPVectorization = jit_prc.optimization_level >= 2;
+    pb = std::make_unique<llvm::PassBuilder>(jit_prc.target_machine.get(),
+                                             tuning,
+                                             std::nullopt,
+                                             pic.get());
+    pb->registerModuleAnalyses(*mam);
+    pb->registerCGSCCAnalyses(*cgam);
+    pb->registerFunctionAnalyses(*fam);
+    pb->registerLoopAnalyses(*lam);
+    pb->crossRegisterProxies(*lam, *fam, *cgam, *mam);
+
+    switch(jit_prc.optimization_level)
+    {
+      case 0:
+        mpm = std::make_unique<llvm::ModulePassManager>(
+          pb->buildO0DefaultPipeline(llvm::OptimizationLevel::O0));
+        break;
+      case 1:
+        mpm = std::make_unique<llvm::ModulePassManager>(
+          pb->buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O1));
+        break;
+      case 2:
+        mpm = std::make_unique<llvm::ModulePassManager>(
+          pb->buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O2));
+        break;
+      default:
+        mpm = std::make_unique<llvm::ModulePassManager>(
+          pb->buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O3));
+        break;
+    }
   }
 
   llvm_processor::llvm_processor(expr::function_ptr const expr,
@@ -193,6 +207,13 @@ namespace jank::codegen
     {
       /* TODO: Add profiling to the fn body? Need to exit on every return. */
       create_function(arity);
+
+      llvm::Value *alloc_previous_fn{};
+      if(profile::allocation::is_enabled())
+      {
+        alloc_previous_fn = gen_alloc_profile_push();
+      }
+
       for(auto const form : arity.body->values)
       {
         gen(form, arity);
@@ -203,6 +224,11 @@ namespace jank::codegen
       {
         ctx->builder->CreateRet(gen_global(obj::nil::nil_const()));
       }
+
+      if(alloc_previous_fn)
+      {
+        gen_alloc_profile_pops(alloc_previous_fn);
+      }
     }
 
     if(target == compilation_target::eval)
@@ -210,9 +236,6 @@ namespace jank::codegen
       //to_string();
     }
 
-    /* Run our optimization passes on the function, mutating it. */
-    ctx->fpm->run(*fn, *ctx->fam);
-
     if(target != compilation_target::function)
     {
       llvm::IRBuilder<>::InsertPointGuard const guard{ *ctx->builder };
@@ -229,6 +252,9 @@ namespace jank::codegen
       }
 
       ctx->builder->CreateRetVoid();
+
+      /* Nested functions share our module, so by now it's complete. */
+      optimize();
     }
 
     return ok();
@@ -328,42 +354,323 @@ namespace jank::codegen
     return var;
   }
 
-  static native_persistent_string arity_to_call_fn(size_t const arity)
+  /* Dynamic calls go through the jank_callN which matches their arity. Beyond max_params, the
+   * args are spilled into an array on the stack, which is passed along with its size. The
+   * handles start with the callee. */
+  static llvm::CallInst *
+  gen_dynamic_call(reusable_context &ctx, llvm::ArrayRef<llvm::Value *> const handles)
   {
-    /* Anything max_params + 1 or higher gets packed into a list so we
-     * just end up calling max_params + 1 at most. */
-    switch(arity)
+    auto const ptr_type(ctx.builder->getPtrTy());
+    auto const arg_count(handles.size() - 1);
+    if(arg_count <= runtime::max_params)
     {
-      case 0 ... runtime::max_params:
-        return fmt::format("jank_call{}", arity);
-      default:
-        return fmt::format("jank_call{}", runtime::max_params + 1);
+      std::vector<llvm::Type *> const arg_types{ handles.size(), ptr_type };
+      auto const fn_type(llvm::FunctionType::get(ptr_type, arg_types, false));
+      auto const fn(
+        ctx.module->getOrInsertFunction(fmt::format("jank_call{}", arg_count), fn_type));
+      return ctx.builder->CreateCall(fn, handles);
+    }
+
+    /* The array goes in the entry block, so calls within loops reuse the same stack slot. */
+    auto &entry(ctx.builder->GetInsertBlock()->getParent()->getEntryBlock());
+    llvm::IRBuilder<> entry_builder{ &entry, entry.getFirstInsertionPt() };
+    auto const array_type(llvm::ArrayType::get(ptr_type, arg_count));
+    auto const args(entry_builder.CreateAlloca(array_type, nullptr, "call_args"));
+    for(size_t i{}; i < arg_count; ++i)
+    {
+      ctx.builder->CreateStore(handles[i + 1],
+                               ctx.builder->CreateConstInBoundsGEP2_64(array_type, args, 0, i));
+    }
+
+    auto const fn_type(llvm::FunctionType::get(
+      ptr_type,
+      { ptr_type, ptr_type, ctx.builder->getInt64Ty() },
+      false));
+    auto const fn(ctx.module->getOrInsertFunction("jank_call_array", fn_type));
+    return ctx.builder->CreateCall(fn,
+                                   { handles[0], args, ctx.builder->getInt64(arg_count) });
+  }
+
+  /* Calls to vars which currently hold multimethods or protocol fns get their own inline
+   * cache. If the var is later redefined as something else, the cache is just skipped at
+   * runtime. Protocol fns dispatch on their first arg, so they need at least one. */
+  static option<object_type> cached_call_type(expr::call_ptr const expr)
+  {
+    if(expr->arg_exprs.size() > runtime::max_params)
+    {
+      return none;
+    }
+
+    auto const var_deref(llvm::dyn_cast<expr::var_deref>(expr->source_expr.data));
+    if(!var_deref || !var_deref->var->is_bound())
+    {
+      return none;
+    }
+
+    auto const type(var_deref->var->deref()->type);
+    if(type == object_type::multi_function
+       || (type == object_type::protocol_function && !expr->arg_exprs.empty()))
+    {
+      return type;
+    }
+    return none;
+  }
+
+  /* Direct linking bakes in what a var holds when the call is compiled, which isn't safe for
+   * vars which are dynamic or marked ^:redef. */
+  static native_bool is_linkable(runtime::var_ptr const var)
+  {
+    if(!var->is_bound() || var->dynamic.load())
+    {
+      return false;
+    }
+    return var->meta.is_none()
+      || !truthy(get(var->meta.unwrap(), __rt_ctx->intern_keyword("redef").expect_ok()));
+  }
+
+  /* Keyword lookups, either by calling a constant keyword or, with direct linking, by calling
+   * clojure.core/get with one, get their own cache of where that keyword's field is in the
+   * last record type seen. Anything other than a record just goes through get. */
+  struct keyword_lookup
+  {
+    expression_ptr key;
+    expression_ptr target;
+    option<expression_ptr> fallback;
+  };
+
+  static option<keyword_lookup> keyword_lookup_args(expr::call_ptr const expr)
+  {
+    auto const is_keyword([](expression_ptr const e) {
+      auto const literal(llvm::dyn_cast<expr::primitive_literal>(e.data));
+      return literal && literal->data->type == object_type::keyword;
+    });
+    auto const arg_count(expr->arg_exprs.size());
+
+    if(is_keyword(expr->source_expr) && (arg_count == 1 || arg_count == 2))
+    {
+      keyword_lookup ret{ expr->source_expr, expr->arg_exprs[0] };
+      if(arg_count == 2)
+      {
+        ret.fallback = expr->arg_exprs[1];
+      }
+      return ret;
     }
+
+    auto const var_deref(llvm::dyn_cast<expr::var_deref>(expr->source_expr.data));
+    if(!__rt_ctx->jit_prc.direct_linking || !var_deref || (arg_count != 2 && arg_count != 3)
+       || !is_keyword(expr->arg_exprs[1]))
+    {
+      return none;
+    }
+    auto const &var(var_deref->var);
+    if(var->n->name->name != "clojure.core" || var->name->name != "get" || !is_linkable(var))
+    {
+      return none;
+    }
+    keyword_lookup ret{ expr->arg_exprs[1], expr->arg_exprs[0] };
+    if(arg_count == 3)
+    {
+      ret.fallback = expr->arg_exprs[2];
+    }
+    return ret;
+  }
+
+  /* With direct linking, a call to a var which currently holds a plain function calls the
+   * generated code for that arity, skipping both the var and the function object. This
+   * means that redefining the var won't affect the caller, so vars which are dynamic or
+   * marked ^:redef are always called through the var. Variadic arities need their rest
+   * args packed, so they still go through the function object. */
+  static option<native_persistent_string>
+  direct_link_target(expr::call_ptr const expr, reusable_context &ctx, compilation_target target)
+  {
+    if(!__rt_ctx->jit_prc.direct_linking || expr->arg_exprs.size() > runtime::max_params)
+    {
+      return none;
+    }
+
+    auto const var_deref(llvm::dyn_cast<expr::var_deref>(expr->source_expr.data));
+    if(!var_deref || !is_linkable(var_deref->var))
+    {
+      return none;
+    }
+
+    auto const value(var_deref->var->deref());
+    if(value->type != object_type::jit_function)
+    {
+      return none;
+    }
+    auto const fn(expect_object<obj::jit_function>(value));
+    auto const arg_count(expr->arg_exprs.size());
+    auto const flags(behavior::callable::extract_variadic_arity_mask(fn->get_arity_flags()));
+    auto const is_variadic((flags & 0b10000000) != 0);
+    auto const required_args(static_cast<size_t>(flags & 0b00001111));
+    if(fn->name == nullptr || (is_variadic && arg_count >= required_args))
+    {
+      return none;
+    }
+
+    native_bool has_arity{};
+    switch(arg_count)
+    {
+      case 0:
+        has_arity = fn->arity_0;
+        break;
+      case 1:
+        has_arity = fn->arity_1;
+        break;
+      case 2:
+        has_arity = fn->arity_2;
+        break;
+      case 3:
+        has_arity = fn->arity_3;
+        break;
+      case 4:
+        has_arity = fn->arity_4;
+        break;
+      case 5:
+        has_arity = fn->arity_5;
+        break;
+      case 6:
+        has_arity = fn->arity_6;
+        break;
+      case 7:
+        has_arity = fn->arity_7;
+        break;
+      case 8:
+        has_arity = fn->arity_8;
+        break;
+      case 9:
+        has_arity = fn->arity_9;
+        break;
+      case 10:
+        has_arity = fn->arity_10;
+        break;
+    }
+    if(!has_arity)
+    {
+      return none;
+    }
+
+    /* The callee's module can be unloaded once its function objects are gone, which we're
+     * about to stop referencing. Code we're compiling to a file isn't loaded here, though. */
+    if(fn->owner)
+    {
+      if(ctx.code_owner)
+      {
+        ctx.code_owner->depend_on(fn->owner);
+      }
+      else if(target != compilation_target::module)
+      {
+        return none;
+      }
+    }
+
+    return fmt::format("{}_{}", fn->name, arg_count);
   }
 
   llvm::Value *llvm_processor::gen(expr::call_ptr const expr, expr::function_arity const &arity)
   {
+    if(auto const direct(direct_link_target(expr, *ctx, target)); direct.is_some())
+    {
+      llvm::SmallVector<llvm::Value *> arg_handles;
+      arg_handles.reserve(expr->arg_exprs.size());
+      for(auto const &arg_expr : expr->arg_exprs)
+      {
+        arg_handles.emplace_back(gen(arg_expr, arity));
+      }
+
+      std::vector<llvm::Type *> const arg_types{ arg_handles.size(), ctx->builder->getPtrTy() };
+      auto const fn_type(llvm::FunctionType::get(ctx->builder->getPtrTy(), arg_types, false));
+      auto const fn(ctx->module->getOrInsertFunction(direct.unwrap().c_str(), fn_type));
+      auto const call(ctx->builder->CreateCall(fn, arg_handles));
+
+      if(expr->position == expression_position::tail)
+      {
+        return ctx->builder->CreateRet(call);
+      }
+      return call;
+    }
+
+    if(auto const lookup(keyword_lookup_args(expr)); lookup.is_some())
+    {
+      /* Zeroed storage for a record::lookup_site. */
+      static_assert(sizeof(obj::record::lookup_site) == sizeof(uint64_t));
+      auto const site(new llvm::GlobalVariable{ ctx->builder->getInt64Ty(),
+                                                false,
+                                                llvm::GlobalVariable::InternalLinkage,
+                                                ctx->builder->getInt64(0),
+                                                "keyword_lookup_site" });
+      site->setAlignment(llvm::Align{ alignof(uint64_t) });
+      ctx->module->insertGlobalVariable(site);
+
+      auto const &args(lookup.unwrap());
+      auto const key(gen(args.key, arity));
+      auto const target(gen(args.target, arity));
+      auto const fallback(args.fallback.is_some()
+                            ? gen(args.fallback.unwrap(), arity)
+                            : llvm::ConstantPointerNull::get(ctx->builder->getPtrTy()));
+
+      auto const fn_type(
+        llvm::FunctionType::get(ctx->builder->getPtrTy(),
+                                { ctx->builder->getPtrTy(),
+                                  ctx->builder->getPtrTy(),
+                                  ctx->builder->getPtrTy(),
+                                  ctx->builder->getPtrTy() },
+                                false));
+      auto const fn(ctx->module->getOrInsertFunction("jank_keyword_lookup_site", fn_type));
+      auto const call(ctx->builder->CreateCall(fn, { site, key, target, fallback }));
+
+      if(expr->position == expression_position::tail)
+      {
+        return ctx->builder->CreateRet(call);
+      }
+      return call;
+    }
+
     auto const callee(gen(expr->source_expr, arity));
 
     llvm::SmallVector<llvm::Value *> arg_handles;
-    llvm::SmallVector<llvm::Type *> arg_types;
     arg_handles.reserve(expr->arg_exprs.size() + 1);
-    arg_types.reserve(expr->arg_exprs.size() + 1);
-
     arg_handles.emplace_back(callee);
-    arg_types.emplace_back(ctx->builder->getPtrTy());
 
     for(auto const &arg_expr : expr->arg_exprs)
     {
       arg_handles.emplace_back(gen(arg_expr, arity));
-      arg_types.emplace_back(ctx->builder->getPtrTy());
     }
 
-    auto const call_fn_name(arity_to_call_fn(expr->arg_exprs.size()));
-
-    auto const fn_type(llvm::FunctionType::get(ctx->builder->getPtrTy(), arg_types, false));
-    auto const fn(ctx->module->getOrInsertFunction(call_fn_name.c_str(), fn_type));
-    auto const call(ctx->builder->CreateCall(fn, arg_handles));
+    llvm::CallInst *call{};
+    if(auto const cached_type(cached_call_type(expr)); cached_type.is_some())
+    {
+      /* Zeroed storage for the call_site of a multi_function or protocol_function. */
+      static_assert(sizeof(obj::multi_function::call_site) == 5 * sizeof(uint64_t));
+      static_assert(sizeof(obj::protocol_function::call_site) == 8 * sizeof(uint64_t));
+      auto const is_multi(cached_type.unwrap() == object_type::multi_function);
+      auto const site_type(llvm::ArrayType::get(ctx->builder->getInt64Ty(), is_multi ? 5 : 8));
+      auto const site(new llvm::GlobalVariable{ site_type,
+                                                false,
+                                                llvm::GlobalVariable::InternalLinkage,
+                                                llvm::ConstantAggregateZero::get(site_type),
+                                                is_multi ? "multi_call_site"
+                                                         : "protocol_call_site" });
+      site->setAlignment(llvm::Align{ alignof(uint64_t) });
+      ctx->module->insertGlobalVariable(site);
+
+      arg_handles.insert(arg_handles.begin() + 1, ctx->builder->getInt64(expr->arg_exprs.size()));
+      arg_handles.insert(arg_handles.begin(), site);
+
+      auto const fn_type(llvm::FunctionType::get(
+        ctx->builder->getPtrTy(),
+        { ctx->builder->getPtrTy(), ctx->builder->getPtrTy(), ctx->builder->getInt64Ty() },
+        true));
+      auto const fn(ctx->module->getOrInsertFunction(
+        is_multi ? "jank_call_site" : "jank_protocol_call_site",
+        fn_type));
+      call = ctx->builder->CreateCall(fn, arg_handles);
+    }
+    else
+    {
+      call = gen_dynamic_call(*ctx, arg_handles);
+    }
 
     if(expr->position == expression_position::tail)
     {
@@ -719,10 +1026,7 @@ namespace jank::codegen
     llvm::Value *call{};
     if(arity.fn_ctx->is_variadic)
     {
-      auto const call_fn_name(arity_to_call_fn(expr->arg_exprs.size()));
-      auto const fn_type(llvm::FunctionType::get(ctx->builder->getPtrTy(), arg_types, false));
-      auto const fn(ctx->module->getOrInsertFunction(call_fn_name.c_str(), fn_type));
-      call = ctx->builder->CreateCall(fn, arg_handles);
+      call = gen_dynamic_call(*ctx, arg_handles);
     }
     else
     {
@@ -928,20 +1232,68 @@ namespace jank::codegen
     auto const position{ expr->position };
     auto const value(gen(expr->value_expr, arity));
     auto const is_return{ position == expression_position::tail };
-    auto const integer_fn_type(llvm::FunctionType::get(
-      ctx->builder->getInt64Ty(),
-      { ctx->builder->getPtrTy(), ctx->builder->getInt64Ty(), ctx->builder->getInt64Ty() },
-      false));
-    auto const fn(
-      ctx->module->getOrInsertFunction("jank_shift_mask_case_integer", integer_fn_type));
-    llvm::SmallVector<llvm::Value *, 3> const args{
-      value,
-      llvm::ConstantInt::getSigned(ctx->builder->getInt64Ty(), expr->shift),
-      llvm::ConstantInt::getSigned(ctx->builder->getInt64Ty(), expr->mask)
-    };
-    auto const call(ctx->builder->CreateCall(fn, args));
-    auto const switch_val(ctx->builder->CreateIntCast(call, ctx->builder->getInt64Ty(), true));
     auto const default_block{ llvm::BasicBlock::Create(*ctx->llvm_ctx, "default", current_fn) };
+
+    /* For integer and keyword tests, we can get the key straight from the object, rather
+     * than calling into the runtime. Nothing but an integer can equal an integer and
+     * nothing but a keyword can be identical to a keyword, so anything else is the
+     * default. */
+    llvm::Value *switch_val{};
+    llvm::Value *integer_val{};
+    if(expr->test_type == expr::case_test_type::integer
+       || expr->test_type == expr::case_test_type::keyword)
+    {
+      auto const is_integer{ expr->test_type == expr::case_test_type::integer };
+      auto const expected_type(is_integer ? object_type::integer : object_type::keyword);
+      auto const type(ctx->builder->CreateLoad(ctx->builder->getInt8Ty(), value));
+      auto const is_expected_type(ctx->builder->CreateICmpEQ(
+        type,
+        ctx->builder->getInt8(static_cast<uint8_t>(expected_type))));
+      auto const typed_block{ llvm::BasicBlock::Create(*ctx->llvm_ctx, "typed", current_fn) };
+      ctx->builder->CreateCondBr(is_expected_type, typed_block, default_block);
+      ctx->builder->SetInsertPoint(typed_block);
+
+      if(is_integer)
+      {
+        auto const offset(offsetof(obj::integer, data) - offsetof(obj::integer, base));
+        auto const data_ptr(
+          ctx->builder->CreateConstInBoundsGEP1_64(ctx->builder->getInt8Ty(), value, offset));
+        integer_val = ctx->builder->CreateLoad(ctx->builder->getInt64Ty(), data_ptr);
+        switch_val = integer_val;
+      }
+      else
+      {
+        auto const offset(offsetof(obj::keyword, hash) - offsetof(obj::keyword, base));
+        auto const hash_ptr(
+          ctx->builder->CreateConstInBoundsGEP1_64(ctx->builder->getInt8Ty(), value, offset));
+        auto const hash(ctx->builder->CreateLoad(ctx->builder->getInt32Ty(), hash_ptr));
+        switch_val = ctx->builder->CreateZExt(hash, ctx->builder->getInt64Ty());
+      }
+
+      if(expr->mask != 0)
+      {
+        switch_val = ctx->builder->CreateAnd(
+          ctx->builder->CreateAShr(switch_val, static_cast<uint64_t>(expr->shift)),
+          static_cast<uint64_t>(expr->mask));
+      }
+    }
+    else
+    {
+      auto const integer_fn_type(llvm::FunctionType::get(
+        ctx->builder->getInt64Ty(),
+        { ctx->builder->getPtrTy(), ctx->builder->getInt64Ty(), ctx->builder->getInt64Ty() },
+        false));
+      auto const fn(
+        ctx->module->getOrInsertFunction("jank_shift_mask_case_integer", integer_fn_type));
+      llvm::SmallVector<llvm::Value *, 3> const args{
+        value,
+        llvm::ConstantInt::getSigned(ctx->builder->getInt64Ty(), expr->shift),
+        llvm::ConstantInt::getSigned(ctx->builder->getInt64Ty(), expr->mask)
+      };
+      auto const call(ctx->builder->CreateCall(fn, args));
+      switch_val = ctx->builder->CreateIntCast(call, ctx->builder->getInt64Ty(), true);
+    }
+
     auto const switch_{ ctx->builder->CreateSwitch(switch_val, default_block, expr->keys.size()) };
     auto const merge_block{ is_return
                               ? nullptr
@@ -966,6 +1318,53 @@ namespace jank::codegen
         block);
 
       ctx->builder->SetInsertPoint(block);
+
+      /* Several values can share a key, so the value still needs to be checked against the
+       * test. An unmasked integer key is the value itself, though. */
+      auto const &test(expr->tests[block_counter]);
+      llvm::Value *matches{};
+      switch(expr->test_type)
+      {
+        case expr::case_test_type::unchecked:
+          break;
+        case expr::case_test_type::integer:
+          if(expr->mask != 0 && test.is_some())
+          {
+            auto const literal(runtime::static_box_cast<expr::primitive_literal>(test.unwrap()));
+            auto const test_val(expect_object<obj::integer>(literal->data)->data);
+            matches = ctx->builder->CreateICmpEQ(
+              integer_val,
+              llvm::ConstantInt::getSigned(ctx->builder->getInt64Ty(), test_val));
+          }
+          break;
+        case expr::case_test_type::keyword:
+          if(test.is_some())
+          {
+            matches = ctx->builder->CreateICmpEQ(value, gen(test.unwrap(), arity));
+          }
+          break;
+        case expr::case_test_type::hash:
+          if(test.is_some())
+          {
+            auto const equal_fn_type(
+              llvm::FunctionType::get(ctx->builder->getInt8Ty(),
+                                      { ctx->builder->getPtrTy(), ctx->builder->getPtrTy() },
+                                      false));
+            auto const fn(ctx->module->getOrInsertFunction("jank_equal", equal_fn_type));
+            llvm::SmallVector<llvm::Value *, 2> const args{ value, gen(test.unwrap(), arity) };
+            auto const call(ctx->builder->CreateCall(fn, args));
+            matches = ctx->builder->CreateICmpEQ(call, ctx->builder->getInt8(1));
+          }
+          break;
+      }
+      if(matches)
+      {
+        auto const match_name{ fmt::format("match_{}", block_counter) };
+        auto const match_block{ llvm::BasicBlock::Create(*ctx->llvm_ctx, match_name, current_fn) };
+        ctx->builder->CreateCondBr(matches, match_block, default_block);
+        ctx->builder->SetInsertPoint(match_block);
+      }
+
       auto const case_val{ gen(expr->exprs[block_counter], arity) };
       case_values.push_back(case_val);
       if(!is_return)
@@ -1488,10 +1887,13 @@ namespace jank::codegen
     if(!is_closure)
     {
       auto const create_fn_type(
-        llvm::FunctionType::get(ctx->builder->getPtrTy(), { ctx->builder->getInt8Ty() }, false));
+        llvm::FunctionType::get(ctx->builder->getPtrTy(),
+                                { ctx->builder->getInt8Ty(), ctx->builder->getPtrTy() },
+                                false));
       auto const create_fn(
         ctx->module->getOrInsertFunction("jank_function_create", create_fn_type));
-      fn_obj = ctx->builder->CreateCall(create_fn, { arity_flags });
+      fn_obj = ctx->builder->CreateCall(create_fn,
+                                        { arity_flags, gen_c_string(munge(expr->unique_name)) });
     }
     else
     {
@@ -1527,6 +1929,20 @@ namespace jank::codegen
       fn_obj = ctx->builder->CreateCall(create_fn, { arity_flags, closure_obj });
     }
 
+    if(ctx->code_owner)
+    {
+      auto const set_owner_fn_type(
+        llvm::FunctionType::get(ctx->builder->getVoidTy(),
+                                { ctx->builder->getPtrTy(), ctx->builder->getPtrTy() },
+                                false));
+      auto const set_owner_fn(
+        ctx->module->getOrInsertFunction("jank_function_set_code_owner", set_owner_fn_type));
+      auto const owner(llvm::ConstantExpr::getIntToPtr(
+        ctx->builder->getInt64(reinterpret_cast<uint64_t>(ctx->code_owner)),
+        ctx->builder->getPtrTy()));
+      ctx->builder->CreateCall(set_owner_fn, { fn_obj, owner });
+    }
+
     for(auto const &arity : expr->arities)
     {
       auto const set_arity_fn_type(
@@ -1564,6 +1980,12 @@ namespace jank::codegen
     return fn_obj;
   }
 
+  void llvm_processor::optimize() const
+  {
+    profile::timer const timer{ fmt::format("ir optimize {}", ctx->module_name) };
+    ctx->mpm->run(*ctx->module, *ctx->mam);
+  }
+
   void llvm_processor::create_global_ctor() const
   {
     auto const init_type(llvm::FunctionType::get(ctx->builder->getVoidTy(), false));
@@ -1594,6 +2016,51 @@ namespace jank::codegen
     }
   }
 
+  /* The function's handle is interned by the global ctor, once per load, rather than on
+   * every call. */
+  llvm::Value *llvm_processor::gen_alloc_profile_push() const
+  {
+    auto const fn_type(
+      llvm::FunctionType::get(ctx->builder->getPtrTy(), { ctx->builder->getPtrTy() }, false));
+
+    auto const handle(create_global_var("alloc_fn"));
+    ctx->module->insertGlobalVariable(handle);
+    {
+      llvm::IRBuilder<>::InsertPointGuard const guard{ *ctx->builder };
+      ctx->builder->SetInsertPoint(ctx->global_ctor_block);
+
+      auto const intern_fn(ctx->module->getOrInsertFunction("jank_profile_alloc_intern", fn_type));
+      auto const call(ctx->builder->CreateCall(
+        intern_fn,
+        { gen_c_string(fmt::format("{}/{}", ctx->module_name, root_fn->name)) }));
+      ctx->builder->CreateStore(call, handle);
+    }
+
+    auto const push_fn(ctx->module->getOrInsertFunction("jank_profile_alloc_push", fn_type));
+    return ctx->builder->CreateCall(
+      push_fn,
+      { ctx->builder->CreateLoad(ctx->builder->getPtrTy(), handle) });
+  }
+
+  /* Functions can return from many places, depending on where their tail positions are,
+   * so we add the pops after codegen is done, rather than at each return. */
+  void llvm_processor::gen_alloc_profile_pops(llvm::Value * const previous_fn) const
+  {
+    llvm::IRBuilder<>::InsertPointGuard const guard{ *ctx->builder };
+    auto const fn_type(
+      llvm::FunctionType::get(ctx->builder->getVoidTy(), { ctx->builder->getPtrTy() }, false));
+    auto const pop_fn(ctx->module->getOrInsertFunction("jank_profile_alloc_pop", fn_type));
+
+    for(auto &block : *fn)
+    {
+      if(auto * const ret = llvm::dyn_cast_or_null<llvm::ReturnInst>(block.getTerminator()))
+      {
+        ctx->builder->SetInsertPoint(ret);
+        ctx->builder->CreateCall(pop_fn, { previous_fn });
+      }
+    }
+  }
+
   llvm::GlobalVariable *
   llvm_processor::create_global_var(native_persistent_string const &name) const
   {
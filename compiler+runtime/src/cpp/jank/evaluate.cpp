@@ -1,8 +1,11 @@
+#include <algorithm>
+
 #include <llvm/ExecutionEngine/Orc/LLJIT.h>
 
 #include <fmt/format.h>
 
 #include <jank/native_persistent_string/fmt.hpp>
+#include <jank/c_api.h>
 #include <jank/runtime/context.hpp>
 #include <jank/runtime/ns.hpp>
 #include <jank/runtime/visit.hpp>
@@ -12,6 +15,7 @@
 #include <jank/codegen/llvm_processor.hpp>
 #include <jank/jit/processor.hpp>
 #include <jank/evaluate.hpp>
+#include <jank/profile/allocation.hpp>
 #include <jank/profile/time.hpp>
 #include <jank/util/scope_exit.hpp>
 
@@ -107,6 +111,15 @@ namespace jank::evaluate
         walk(form.second, f);
       }
     }
+    else if constexpr(std::same_as<T, expr::case_>)
+    {
+      walk(expr.value_expr, f);
+      walk(expr.default_expr, f);
+      for(auto const &form : expr.exprs)
+      {
+        walk(form, f);
+      }
+    }
     /* TODO: function */
 
     f(expr);
@@ -309,91 +322,7 @@ namespace jank::evaluate
             arg_vals.emplace_back(eval(arg_expr));
           }
 
-          switch(arg_vals.size())
-          {
-            case 0:
-              return dynamic_call(source);
-            case 1:
-              return dynamic_call(source, arg_vals[0]);
-            case 2:
-              return dynamic_call(source, arg_vals[0], arg_vals[1]);
-            case 3:
-              return dynamic_call(source, arg_vals[0], arg_vals[1], arg_vals[2]);
-            case 4:
-              return dynamic_call(source, arg_vals[0], arg_vals[1], arg_vals[2], arg_vals[3]);
-            case 5:
-              return dynamic_call(source,
-                                  arg_vals[0],
-                                  arg_vals[1],
-                                  arg_vals[2],
-                                  arg_vals[3],
-                                  arg_vals[4]);
-            case 6:
-              return dynamic_call(source,
-                                  arg_vals[0],
-                                  arg_vals[1],
-                                  arg_vals[2],
-                                  arg_vals[3],
-                                  arg_vals[4],
-                                  arg_vals[5]);
-            case 7:
-              return dynamic_call(source,
-                                  arg_vals[0],
-                                  arg_vals[1],
-                                  arg_vals[2],
-                                  arg_vals[3],
-                                  arg_vals[4],
-                                  arg_vals[5],
-                                  arg_vals[6]);
-            case 8:
-              return dynamic_call(source,
-                                  arg_vals[0],
-                                  arg_vals[1],
-                                  arg_vals[2],
-                                  arg_vals[3],
-                                  arg_vals[4],
-                                  arg_vals[5],
-                                  arg_vals[6],
-                                  arg_vals[7]);
-            case 9:
-              return dynamic_call(source,
-                                  arg_vals[0],
-                                  arg_vals[1],
-                                  arg_vals[2],
-                                  arg_vals[3],
-                                  arg_vals[4],
-                                  arg_vals[5],
-                                  arg_vals[6],
-                                  arg_vals[7],
-                                  arg_vals[8]);
-            case 10:
-              return dynamic_call(source,
-                                  arg_vals[0],
-                                  arg_vals[1],
-                                  arg_vals[2],
-                                  arg_vals[3],
-                                  arg_vals[4],
-                                  arg_vals[5],
-                                  arg_vals[6],
-                                  arg_vals[7],
-                                  arg_vals[8],
-                                  arg_vals[9]);
-            default:
-              {
-                return dynamic_call(source,
-                                    arg_vals[0],
-                                    arg_vals[1],
-                                    arg_vals[2],
-                                    arg_vals[3],
-                                    arg_vals[4],
-                                    arg_vals[5],
-                                    arg_vals[6],
-                                    arg_vals[7],
-                                    arg_vals[8],
-                                    arg_vals[9],
-                                    try_object<obj::persistent_list>(arg_vals[10]));
-              }
-          }
+          return dynamic_call(source, arg_vals.data(), arg_vals.size());
         }
         else if constexpr(std::same_as<T, obj::persistent_hash_set>
                           || std::same_as<T, obj::transient_vector>)
@@ -557,18 +486,25 @@ namespace jank::evaluate
 
     auto const wrapped_expr(evaluate::wrap_expression(expr, "repl_fn", {}));
     codegen::llvm_processor cg_prc{ wrapped_expr, module, codegen::compilation_target::eval };
+    /* The module is unloaded once nothing references the code it contains. Until the
+     * function objects it creates take over, the owner is kept alive by this frame. */
+    auto const owner(__rt_ctx->jit_prc.unloadable_code.create_owner());
+    cg_prc.ctx->code_owner = owner;
     cg_prc.gen().expect_ok();
 
     {
       profile::timer const timer{ fmt::format("ir jit compile {}", expr->name) };
       __rt_ctx->jit_prc.load_ir_module(std::move(cg_prc.ctx->module),
-                                       std::move(cg_prc.ctx->llvm_ctx));
+                                       std::move(cg_prc.ctx->llvm_ctx),
+                                       *owner);
 
       auto const fn(
         __rt_ctx->jit_prc
           .find_symbol<object *(*)()>(fmt::format("{}_0", munge(cg_prc.root_fn->unique_name)))
           .expect_ok());
-      return fn();
+      auto const ret(fn());
+      GC_reachable_here(owner);
+      return ret;
     }
   }
 
@@ -639,6 +575,7 @@ namespace jank::evaluate
     }
     try
     {
+      profile::allocation::function_scope const alloc_fn;
       return eval(expr->body);
     }
     catch(object_ptr const e)
@@ -650,8 +587,56 @@ namespace jank::evaluate
     }
   }
 
+  /* This needs to find the same keys as the generated code does, since the keys were
+   * chosen by the case macro either way. */
+  static option<native_integer> case_key(expr::case_ const &expr, object_ptr const value)
+  {
+    native_integer key{};
+    switch(expr.test_type)
+    {
+      case expr::case_test_type::integer:
+        if(value->type != object_type::integer)
+        {
+          return none;
+        }
+        key = expect_object<obj::integer>(value)->data;
+        break;
+      case expr::case_test_type::keyword:
+        if(value->type != object_type::keyword)
+        {
+          return none;
+        }
+        key = expect_object<obj::keyword>(value)->hash;
+        break;
+      case expr::case_test_type::unchecked:
+      case expr::case_test_type::hash:
+        return jank_shift_mask_case_integer(value.data, expr.shift, expr.mask);
+    }
+
+    if(expr.mask != 0)
+    {
+      key = (key >> expr.shift) & expr.mask;
+    }
+    return key;
+  }
+
   object_ptr eval(expr::case_ptr const expr)
   {
-    return dynamic_call(eval(wrap_expression(expr, "case", {})));
+    auto const value(eval(expr->value_expr));
+    auto const key(case_key(*expr, value));
+    if(key.is_some())
+    {
+      auto const found(std::ranges::find(expr->keys, key.unwrap()));
+      if(found != expr->keys.end())
+      {
+        auto const index(static_cast<size_t>(std::distance(expr->keys.begin(), found)));
+        auto const &test(expr->tests[index]);
+        if(test.is_none() || equal(value, eval(test.unwrap())))
+        {
+          return eval(expr->exprs[index]);
+        }
+      }
+    }
+    return eval(expr->default_expr);
   }
 }
@@ -0,0 +1,58 @@
+#include <jank/gc_native.hpp>
+#include <jank/runtime/convert.hpp>
+#include <jank/runtime/context.hpp>
+#include <jank/runtime/collector.hpp>
+#include <jank/runtime/obj/native_function_wrapper.hpp>
+#include <jank/runtime/obj/persistent_array_map.hpp>
+#include <jank/runtime/obj/persistent_hash_map.hpp>
+#include <jank/runtime/obj/keyword.hpp>
+
+namespace jank::gc_native
+{
+  using namespace jank;
+  using namespace jank::runtime;
+
+  static object_ptr stats()
+  {
+    auto const s(collector::current_stats());
+    auto const kw([](native_persistent_string_view const &name) {
+      return __rt_ctx->intern_keyword(name).expect_ok();
+    });
+
+    return obj::persistent_hash_map::create_unique(
+      std::make_pair(kw("collections"), make_box(s.collections)),
+      std::make_pair(kw("pause-count"), make_box(s.pause_count)),
+      std::make_pair(kw("pause-total-ns"), make_box(s.pause_total_ns)),
+      std::make_pair(kw("pause-max-ns"), make_box(s.pause_max_ns)),
+      std::make_pair(kw("heap-size"), make_box(s.heap_size)),
+      std::make_pair(kw("free-bytes"), make_box(s.free_bytes)),
+      std::make_pair(kw("bytes-since-gc"), make_box(s.bytes_since_gc)),
+      std::make_pair(kw("total-bytes"), make_box(s.total_bytes)));
+  }
+
+  static object_ptr collect()
+  {
+    collector::collect();
+    return obj::nil::nil_const();
+  }
+}
+
+jank_object_ptr jank_load_jank_gc_native()
+{
+  using namespace jank;
+  using namespace jank::runtime;
+
+  auto const ns(__rt_ctx->intern_ns("jank.gc-native"));
+
+  auto const intern_fn([=](native_persistent_string const &name, auto const fn) {
+    ns->intern_var(name)->bind_root(
+      make_box<obj::native_function_wrapper>(convert_function(fn))
+        ->with_meta(obj::persistent_hash_map::create_unique(std::make_pair(
+          __rt_ctx->intern_keyword("name").expect_ok(),
+          make_box(obj::symbol{ __rt_ctx->current_ns()->to_string(), name }.to_string())))));
+  });
+  intern_fn("stats", &gc_native::stats);
+  intern_fn("collect", &gc_native::collect);
+
+  return erase(obj::nil::nil_const());
+}
@@ -0,0 +1,99 @@
+#include <llvm/Support/Error.h>
+
+#include <jank/jit/code_owner.hpp>
+
+namespace jank::jit
+{
+  code_owner::code_owner(code_registry &registry, size_t const id)
+    : registry{ registry }
+    , id{ id }
+  {
+  }
+
+  code_owner::~code_owner()
+  {
+    registry.release(id);
+  }
+
+  void code_owner::depend_on(code_owner * const other)
+  {
+    if(other == this)
+    {
+      return;
+    }
+    for(auto it(dependencies); it != nullptr; it = it->next)
+    {
+      if(it->owner == other)
+      {
+        return;
+      }
+    }
+    dependencies = new(GC) dependency{ other, dependencies };
+  }
+
+  code_owner *code_registry::create_owner()
+  {
+    size_t id{};
+    {
+      std::lock_guard<std::mutex> const lock{ mutex };
+      id = next_id++;
+    }
+    /* Not pointer free, since the dependencies need to be traced. */
+    return new(GC) code_owner{ *this, id };
+  }
+
+  void code_registry::track(code_owner const &owner, llvm::orc::ResourceTrackerSP tracker)
+  {
+    std::lock_guard<std::mutex> const lock{ mutex };
+    trackers.emplace(owner.id, std::move(tracker));
+  }
+
+  void code_registry::release(size_t const id)
+  {
+    std::lock_guard<std::mutex> const lock{ mutex };
+    pending.push_back(id);
+  }
+
+  size_t code_registry::reclaim()
+  {
+    std::vector<llvm::orc::ResourceTrackerSP> to_remove;
+    {
+      std::lock_guard<std::mutex> const lock{ mutex };
+      for(auto const id : pending)
+      {
+        auto const found(trackers.find(id));
+        /* If loading the module failed, we never started tracking it. */
+        if(found != trackers.end())
+        {
+          to_remove.emplace_back(std::move(found->second));
+          trackers.erase(found);
+        }
+      }
+      pending.clear();
+      total_reclaimed += to_remove.size();
+    }
+
+    /* Removal takes the JIT session lock, so we don't want to be holding ours, since
+     * finalizers may need it. */
+    for(auto const &tracker : to_remove)
+    {
+      llvm::logAllUnhandledErrors(tracker->remove(),
+                                  llvm::errs(),
+                                  "Unable to unload JIT compiled code: ");
+    }
+
+    return to_remove.size();
+  }
+
+  size_t code_registry::tracked_count()
+  {
+    std::lock_guard<std::mutex> const lock{ mutex };
+    return trackers.size();
+  }
+
+  size_t code_registry::reclaimed_count()
+  {
+    std::lock_guard<std::mutex> const lock{ mutex };
+    return total_reclaimed;
+  }
+}
@@ -0,0 +1,260 @@
+#include <unistd.h>
+
+#include <llvm/ExecutionEngine/JITEventListener.h>
+#include <llvm/ExecutionEngine/JITLink/JITLink.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ObjectLinkingLayer.h>
+#include <llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h>
+#include <llvm/ExecutionEngine/Orc/Debugging/DebuggerSupport.h>
+#include <llvm/Object/SymbolSize.h>
+
+#include <fmt/format.h>
+
+#include <jank/native_persistent_string/fmt.hpp>
+#include <jank/jit/perf_map.hpp>
+#include <jank/runtime/context.hpp>
+#include <jank/runtime/core/munge.hpp>
+
+namespace jank::jit
+{
+  perf_map::perf_map()
+  {
+    auto const path{ fmt::format("/tmp/perf-{}.map", getpid()) };
+    file = std::fopen(path.c_str(), "w");
+    if(!file)
+    {
+      fmt::println(stderr, "Unable to open perf map file: {}", path);
+    }
+  }
+
+  perf_map::~perf_map()
+  {
+    if(file)
+    {
+      std::fclose(file);
+    }
+  }
+
+  void perf_map::write(uintptr_t const address,
+                       size_t const size,
+                       native_persistent_string_view const &name)
+  {
+    if(!file || size == 0)
+    {
+      return;
+    }
+
+    auto const demunged{ demunge_symbol(name) };
+    std::lock_guard<std::mutex> const lock{ mutex };
+    fmt::println(file, "{:x} {:x} {}", address, size, demunged);
+    /* perf may read this at any point, including after we've crashed, so we don't
+     * want anything sitting in a buffer. */
+    std::fflush(file);
+  }
+
+  /* Strips a trailing `_<digits>` from the string, if there is one. */
+  static option<native_persistent_string_view>
+  strip_numeric_suffix(native_persistent_string_view &s)
+  {
+    auto const underscore{ s.rfind('_') };
+    if(underscore == native_persistent_string_view::npos || underscore + 1 == s.size())
+    {
+      return none;
+    }
+
+    auto const digits{ s.substr(underscore + 1) };
+    for(auto const c : digits)
+    {
+      if(c < '0' || '9' < c)
+      {
+        return none;
+      }
+    }
+
+    s = s.substr(0, underscore);
+    return digits;
+  }
+
+  native_persistent_string demunge_symbol(native_persistent_string_view const &name)
+  {
+    /* Function names are built from context::unique_string, which means they have the
+     * form `<ns>-<name>-<counter>`, with the ns dots turned into underscores. Codegen
+     * then munges that and adds `_<arity>` for each arity. Munging isn't reversible
+     * for the ns part, so we find the longest ns we know about which prefixes the symbol. */
+    native_persistent_string_view rest{ name };
+    native_persistent_string ns_name;
+    if(runtime::__rt_ctx)
+    {
+      static native_persistent_string const dot{ "\\." };
+      size_t longest{};
+      auto const locked_namespaces{ runtime::__rt_ctx->namespaces.rlock() };
+      for(auto const &pair : *locked_namespaces)
+      {
+        auto const &candidate{ pair.first->name };
+        auto const prefix{ runtime::munge(runtime::munge_extra(candidate, dot, "_")) };
+        if(longest < prefix.size() && prefix.size() < name.size()
+           && name.starts_with(static_cast<native_persistent_string_view>(prefix))
+           && name[prefix.size()] == '_')
+        {
+          longest = prefix.size();
+          ns_name = candidate;
+        }
+      }
+
+      if(longest != 0)
+      {
+        rest = rest.substr(longest + 1);
+      }
+    }
+
+    if(ns_name.empty())
+    {
+      return runtime::demunge(name);
+    }
+
+    /* Module load functions have only the counter, whereas arity functions have the counter
+     * and then the arity. */
+    option<native_persistent_string_view> arity;
+    auto const first_suffix{ strip_numeric_suffix(rest) };
+    if(first_suffix.is_some() && strip_numeric_suffix(rest).is_some())
+    {
+      arity = first_suffix;
+    }
+
+    auto const fn_name{ runtime::demunge(rest) };
+    if(arity.is_some())
+    {
+      return fmt::format("{}/{} [arity {}]", ns_name, fn_name, arity.unwrap());
+    }
+    return fmt::format("{}/{}", ns_name, fn_name);
+  }
+
+  /* JITLink gives us the final layout of each linked graph, which includes the size of
+   * every symbol, so we just walk the callable symbols once everything is fixed up. */
+  struct perf_map_plugin : llvm::orc::ObjectLinkingLayer::Plugin
+  {
+    perf_map_plugin(perf_map &map)
+      : map{ map }
+    {
+    }
+
+    void modifyPassConfig(llvm::orc::MaterializationResponsibility &,
+                          llvm::jitlink::LinkGraph &,
+                          llvm::jitlink::PassConfiguration &config) override
+    {
+      config.PostFixupPasses.emplace_back([this](llvm::jitlink::LinkGraph &graph) {
+        for(auto const * const sym : graph.defined_symbols())
+        {
+          if(!sym->hasName() || !sym->isCallable())
+          {
+            continue;
+          }
+          map.write(sym->getAddress().getValue(), sym->getSize(), sym->getName());
+        }
+        return llvm::Error::success();
+      });
+    }
+
+    llvm::Error notifyFailed(llvm::orc::MaterializationResponsibility &) override
+    {
+      return llvm::Error::success();
+    }
+
+    llvm::Error notifyRemovingResources(llvm::orc::JITDylib &, llvm::orc::ResourceKey) override
+    {
+      return llvm::Error::success();
+    }
+
+    void notifyTransferringResources(llvm::orc::JITDylib &,
+                                     llvm::orc::ResourceKey,
+                                     llvm::orc::ResourceKey) override
+    {
+    }
+
+    perf_map &map;
+  };
+
+  /* RuntimeDyld doesn't keep symbol sizes around, so we compute them from the relocated
+   * debug object, the same way LLVM's own perf listener does. */
+  struct perf_map_listener : llvm::JITEventListener
+  {
+    perf_map_listener(perf_map &map)
+      : map{ map }
+    {
+    }
+
+    void notifyObjectLoaded(ObjectKey,
+                            llvm::object::ObjectFile const &obj,
+                            llvm::RuntimeDyld::LoadedObjectInfo const &info) override
+    {
+      auto const debug_obj_owner{ info.getObjectForDebug(obj) };
+      auto const * const debug_obj{ debug_obj_owner.getBinary() };
+      if(!debug_obj)
+      {
+        return;
+      }
+
+      for(auto const &[sym, size] : llvm::object::computeSymbolSizes(*debug_obj))
+      {
+        auto type{ sym.getType() };
+        if(!type)
+        {
+          llvm::consumeError(type.takeError());
+          continue;
+        }
+        if(*type != llvm::object::SymbolRef::ST_Function)
+        {
+          continue;
+        }
+
+        auto sym_name{ sym.getName() };
+        auto address{ sym.getAddress() };
+        if(!sym_name || !address)
+        {
+          llvm::consumeError(sym_name.takeError());
+          llvm::consumeError(address.takeError());
+          continue;
+        }
+
+        map.write(*address, size, *sym_name);
+      }
+    }
+
+    perf_map &map;
+  };
+
+  void register_perf_map(llvm::orc::LLJIT &jit, perf_map &map)
+  {
+    auto &layer{ jit.getObjLinkingLayer() };
+    if(auto * const jitlink_layer = llvm::dyn_cast<llvm::orc::ObjectLinkingLayer>(&layer))
+    {
+      jitlink_layer->addPlugin(std::make_unique<perf_map_plugin>(map));
+    }
+    else if(auto * const rtdyld_layer
+            = llvm::dyn_cast<llvm::orc::RTDyldObjectLinkingLayer>(&layer))
+    {
+      /* The layer only keeps a reference to its listeners, and this lives as long as the JIT. */
+      /* NOLINTNEXTLINE(cppcoreguidelines-owning-memory) */
+      rtdyld_layer->registerJITEventListener(*new perf_map_listener{ map });
+    }
+    else
+    {
+      fmt::println(stderr, "Unsupported JIT linking layer; perf map will be empty.");
+    }
+  }
+
+  void register_debugger_support(llvm::orc::LLJIT &jit)
+  {
+    auto &layer{ jit.getObjLinkingLayer() };
+    if(auto * const rtdyld_layer = llvm::dyn_cast<llvm::orc::RTDyldObjectLinkingLayer>(&layer))
+    {
+      rtdyld_layer->registerJITEventListener(
+        *llvm::JITEventListener::createGDBRegistrationListener());
+      return;
+    }
+
+    llvm::logAllUnhandledErrors(llvm::orc::enableDebuggerSupport(jit),
+                                llvm::errs(),
+                                "Unable to enable JIT debugger support: ");
+  }
+}
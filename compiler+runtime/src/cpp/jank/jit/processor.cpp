@@ -9,7 +9,9 @@
 #include <llvm/IR/Verifier.h>
 #include <llvm/Support/Signals.h>
 #include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
 #include <llvm/IRReader/IRReader.h>
+#include <llvm/TargetParser/Host.h>
 
 #include <fmt/ranges.h>
 
@@ -50,8 +52,51 @@ namespace jank::jit
     std::exit(gen_crash_diag ? 70 : 1);
   }
 
+  static llvm::CodeGenOptLevel codegen_opt_level(native_integer const optimization_level)
+  {
+    switch(optimization_level)
+    {
+      case 0:
+        return llvm::CodeGenOptLevel::None;
+      case 1:
+        return llvm::CodeGenOptLevel::Less;
+      case 2:
+        return llvm::CodeGenOptLevel::Default;
+      default:
+        return llvm::CodeGenOptLevel::Aggressive;
+    }
+  }
+
+  static std::unique_ptr<llvm::TargetMachine>
+  create_target_machine(native_transient_string const &cpu,
+                        native_integer const optimization_level)
+  {
+    /* Detecting the host also gives us its features, which we need for native. */
+    auto builder(cpu == "native"
+                   ? llvm::cantFail(llvm::orc::JITTargetMachineBuilder::detectHost())
+                   : llvm::orc::JITTargetMachineBuilder{
+                       llvm::Triple{ llvm::sys::getDefaultTargetTriple() } });
+    if(cpu != "native")
+    {
+      builder.setCPU(cpu.empty() ? "generic" : cpu);
+    }
+    /* Object files we write may end up in shared libraries. */
+    builder.setRelocationModel(llvm::Reloc::PIC_);
+    builder.setCodeGenOptLevel(codegen_opt_level(optimization_level));
+
+    auto target_machine(builder.createTargetMachine());
+    if(!target_machine)
+    {
+      throw std::runtime_error{ fmt::format("unable to create target machine for CPU {}: {}",
+                                            cpu,
+                                            llvm::toString(target_machine.takeError())) };
+    }
+    return std::move(target_machine.get());
+  }
+
   processor::processor(util::cli::options const &opts)
     : optimization_level{ opts.optimization_level }
+    , direct_linking{ opts.direct_linking }
   {
     profile::timer const timer{ "jit ctor" };
 
@@ -92,6 +137,15 @@ namespace jank::jit
     }
     args.emplace_back(strdup(O.c_str()));
 
+    if(!opts.target_cpu.empty())
+    {
+#if defined(__x86_64__) || defined(__i386__)
+      args.emplace_back(strdup(fmt::format("-march={}", opts.target_cpu).c_str()));
+#else
+      args.emplace_back(strdup(fmt::format("-mcpu={}", opts.target_cpu).c_str()));
+#endif
+    }
+
     for(auto const &include_path : opts.include_dirs)
     {
       args.emplace_back(strdup(fmt::format("-I{}", include_path).c_str()));
@@ -119,6 +173,23 @@ namespace jank::jit
 
     interpreter = llvm::cantFail(clang::Interpreter::create(std::move(compiler_instance)));
 
+    /* Neither perf nor the debugger can learn about code which has already been loaded.
+     * Creating the interpreter has linked its own startup code by now, so that's missed,
+     * but these are registered before we load any libraries, objects, or jank code. */
+    auto &ee(interpreter->getExecutionEngine().get());
+    if(opts.perf_map_enabled)
+    {
+      perf_symbols = std::make_unique<perf_map>();
+      register_perf_map(ee, *perf_symbols);
+    }
+    if(opts.jit_debug_enabled)
+    {
+      register_debugger_support(ee);
+    }
+
+    target_machine = create_target_machine(opts.target_cpu, optimization_level);
+    target_cpu = target_machine->getTargetCPU().str();
+
     auto const &load_result{ load_dynamic_libs(opts.libs) };
     if(load_result.is_err())
     {
@@ -153,13 +224,40 @@ namespace jank::jit
     llvm::cantFail(ee.addObjectFile(std::move(file.get())));
   }
 
-  void processor::load_ir_module(std::unique_ptr<llvm::Module> m,
-                                 std::unique_ptr<llvm::LLVMContext> llvm_ctx) const
+  /* clang::Interpreter builds its own JIT, from the triple alone, and gives us no way to
+   * set its CPU. So we put our CPU and features on each function we give it, which is what
+   * clang does for the C++ it compiles with -march. The JIT's code generator prefers these
+   * to its own defaults. */
+  static void set_target(llvm::Module &m, llvm::TargetMachine const &target_machine)
+  {
+    auto const cpu(target_machine.getTargetCPU());
+    auto const features(target_machine.getTargetFeatureString());
+    for(auto &fn : m)
+    {
+      if(fn.isDeclaration())
+      {
+        continue;
+      }
+      fn.addFnAttr("target-cpu", cpu);
+      if(!features.empty())
+      {
+        fn.addFnAttr("target-features", features);
+      }
+    }
+  }
+
+  /* Verifies the module, when debugging, and adds it to the JIT, tracked by the given
+   * resource tracker, if any. */
+  static void add_ir_module(llvm::orc::LLJIT &ee,
+                            llvm::TargetMachine const &target_machine,
+                            std::unique_ptr<llvm::Module> m,
+                            std::unique_ptr<llvm::LLVMContext> llvm_ctx,
+                            llvm::orc::ResourceTrackerSP const &tracker)
   {
-    profile::timer const timer{ fmt::format("jit ir module {}",
-                                            static_cast<std::string_view>(m->getName())) };
     //m->print(llvm::outs(), nullptr);
 
+    set_target(*m, target_machine);
+
 #if JANK_DEBUG
     if(llvm::verifyModule(*m, &llvm::errs()))
     {
@@ -169,12 +267,47 @@ namespace jank::jit
     }
 #endif
 
-    auto &ee(interpreter->getExecutionEngine().get());
-    llvm::cantFail(
-      ee.addIRModule(llvm::orc::ThreadSafeModule{ std::move(m), std::move(llvm_ctx) }));
+    llvm::orc::ThreadSafeModule tsm{ std::move(m), std::move(llvm_ctx) };
+    if(tracker)
+    {
+      llvm::cantFail(ee.addIRModule(tracker, std::move(tsm)));
+    }
+    else
+    {
+      llvm::cantFail(ee.addIRModule(std::move(tsm)));
+    }
     llvm::cantFail(ee.initialize(ee.getMainJITDylib()));
   }
 
+  void processor::load_ir_module(std::unique_ptr<llvm::Module> m,
+                                 std::unique_ptr<llvm::LLVMContext> llvm_ctx) const
+  {
+    profile::timer const timer{ fmt::format("jit ir module {}",
+                                            static_cast<std::string_view>(m->getName())) };
+    add_ir_module(interpreter->getExecutionEngine().get(),
+                  *target_machine,
+                  std::move(m),
+                  std::move(llvm_ctx),
+                  {});
+  }
+
+  void processor::load_ir_module(std::unique_ptr<llvm::Module> m,
+                                 std::unique_ptr<llvm::LLVMContext> llvm_ctx,
+                                 code_owner const &owner) const
+  {
+    profile::timer const timer{ fmt::format("jit ir module {}",
+                                            static_cast<std::string_view>(m->getName())) };
+
+    /* This is a safe point to drop old code, since we're not within any linking and
+     * any code which is still running is being kept alive by its function object. */
+    unloadable_code.reclaim();
+
+    auto &ee(interpreter->getExecutionEngine().get());
+    auto tracker(ee.getMainJITDylib().createResourceTracker());
+    add_ir_module(ee, *target_machine, std::move(m), std::move(llvm_ctx), tracker);
+    unloadable_code.track(owner, std::move(tracker));
+  }
+
   void processor::load_bitcode(native_persistent_string const &module,
                                native_persistent_string_view const &bitcode) const
   {
@@ -22,6 +22,8 @@ jank_object_ptr jank_load_jank_perf_native()
           make_box(obj::symbol{ __rt_ctx->current_ns()->to_string(), name }.to_string())))));
   });
   intern_fn("benchmark", &perf::benchmark);
+  intern_fn("allocations", &perf::allocations);
+  intern_fn("reset-allocations!", &perf::reset_allocations);
 
   return erase(obj::nil::nil_const());
 }
@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <mutex>
+
+#include <fmt/format.h>
+
+#include <jank/native_persistent_string/fmt.hpp>
+#include <jank/profile/allocation.hpp>
+#include <jank/runtime/object.hpp>
+#include <jank/util/cli.hpp>
+
+namespace jank::profile::allocation
+{
+  struct atomic_stats
+  {
+    std::atomic<uint64_t> count{};
+    std::atomic<uint64_t> bytes{};
+  };
+
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  std::atomic<native_bool> enabled{};
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static uint64_t sample_rate{ 1 };
+  /* object_type is a uint8_t, so this covers every possible type. */
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static std::array<atomic_stats, 256> types;
+
+  /* Per-function stats are only touched on sampled allocations and when modules are
+   * loaded, so a lock is fine here. The map is node based, so handles into it stay valid
+   * as it grows. */
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static std::mutex functions_mutex;
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static native_unordered_map<native_persistent_string, function_stats> functions;
+
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static thread_local uint64_t countdown{ 1 };
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static thread_local function_handle current_fn{};
+
+  void configure(util::cli::options const &opts)
+  {
+    if(!opts.alloc_profiler_enabled)
+    {
+      return;
+    }
+
+    sample_rate = std::max<native_integer>(opts.alloc_profiler_sample_rate, 1);
+    countdown = sample_rate;
+    enabled.store(true);
+
+    std::atexit(report);
+  }
+
+  native_bool is_enabled()
+  {
+    return enabled.load(std::memory_order_relaxed);
+  }
+
+  void record(runtime::object_type const type, size_t const size)
+  {
+    if(--countdown != 0)
+    {
+      return;
+    }
+    countdown = sample_rate;
+
+    auto &s(types[static_cast<uint8_t>(type)]);
+    s.count.fetch_add(sample_rate, std::memory_order_relaxed);
+    s.bytes.fetch_add(sample_rate * size, std::memory_order_relaxed);
+
+    if(current_fn)
+    {
+      std::lock_guard<std::mutex> const lock{ functions_mutex };
+      current_fn->totals.count += sample_rate;
+      current_fn->totals.bytes += sample_rate * size;
+    }
+  }
+
+  function_handle intern_function(char const * const name)
+  {
+    native_persistent_string const key{ name };
+    std::lock_guard<std::mutex> const lock{ functions_mutex };
+    auto &f(functions[key]);
+    if(f.name.empty())
+    {
+      f.name = key;
+    }
+    return &f;
+  }
+
+  function_handle push_function(function_handle const fn)
+  {
+    auto const previous(current_fn);
+    current_fn = fn;
+    return previous;
+  }
+
+  void pop_function(function_handle const previous)
+  {
+    current_fn = previous;
+  }
+
+  function_handle current_function()
+  {
+    return current_fn;
+  }
+
+  function_scope::function_scope()
+    : previous{ current_fn }
+  {
+  }
+
+  function_scope::~function_scope()
+  {
+    current_fn = previous;
+  }
+
+  stats type_stats(runtime::object_type const type)
+  {
+    auto const &s(types[static_cast<uint8_t>(type)]);
+    return { s.count.load(std::memory_order_relaxed), s.bytes.load(std::memory_order_relaxed) };
+  }
+
+  native_vector<function_stats> all_function_stats()
+  {
+    native_vector<function_stats> ret;
+    {
+      std::lock_guard<std::mutex> const lock{ functions_mutex };
+      ret.reserve(functions.size());
+      for(auto const &pair : functions)
+      {
+        if(pair.second.totals.count != 0)
+        {
+          ret.emplace_back(pair.second);
+        }
+      }
+    }
+    std::sort(ret.begin(), ret.end(), [](auto const &l, auto const &r) {
+      return l.totals.bytes > r.totals.bytes;
+    });
+    return ret;
+  }
+
+  void reset()
+  {
+    for(auto &s : types)
+    {
+      s.count.store(0, std::memory_order_relaxed);
+      s.bytes.store(0, std::memory_order_relaxed);
+    }
+
+    /* Generated code holds handles into the map, so we only zero the stats. */
+    std::lock_guard<std::mutex> const lock{ functions_mutex };
+    for(auto &pair : functions)
+    {
+      pair.second.totals = {};
+    }
+  }
+
+  void report()
+  {
+    struct entry
+    {
+      char const *name{};
+      stats totals;
+    };
+
+    native_vector<entry> entries;
+    for(size_t i{}; i < types.size(); ++i)
+    {
+      auto const type(static_cast<runtime::object_type>(i));
+      auto const s(type_stats(type));
+      if(s.count != 0)
+      {
+        entries.push_back({ runtime::object_type_str(type), s });
+      }
+    }
+    std::sort(entries.begin(), entries.end(), [](auto const &l, auto const &r) {
+      return l.totals.bytes > r.totals.bytes;
+    });
+
+    fmt::println(stderr, "allocations by type (sample rate {}):", sample_rate);
+    fmt::println(stderr, "  {:>14} {:>16}  {}", "count", "bytes", "type");
+    for(auto const &e : entries)
+    {
+      fmt::println(stderr, "  {:>14} {:>16}  {}", e.totals.count, e.totals.bytes, e.name);
+    }
+
+    auto const fns(all_function_stats());
+    if(!fns.empty())
+    {
+      fmt::println(stderr, "allocations by function:");
+      fmt::println(stderr, "  {:>14} {:>16}  {}", "count", "bytes", "function");
+      for(auto const &f : fns)
+      {
+        fmt::println(stderr, "  {:>14} {:>16}  {}", f.totals.count, f.totals.bytes, f.name);
+      }
+    }
+  }
+}
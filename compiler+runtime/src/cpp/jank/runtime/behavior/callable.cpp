@@ -1,3 +1,5 @@
+#include <array>
+
 #include <fmt/core.h>
 
 #include <jank/native_persistent_string/fmt.hpp>
@@ -11,6 +13,16 @@ namespace jank::runtime
 {
   using namespace behavior;
 
+  /* Arities are compiled against a seq rest param, so the args which land in it need to be
+   * put in a seq which the callee can hold onto. That's the one allocation a variadic call
+   * makes, however many args it has. */
+  template <typename... Args>
+  static obj::native_array_sequence_ptr pack_rest(Args const... args)
+  {
+    std::array<object_ptr, sizeof...(Args)> const values{ args... };
+    return obj::native_array_sequence::create(values.data(), values.size());
+  }
+
   object_ptr dynamic_call(object_ptr source)
   {
     if(source->type == object_type::var)
@@ -62,7 +74,7 @@ namespace jank::runtime
           switch(mask)
           {
             case callable::mask_variadic_arity(0):
-              return typed_source->call(make_box<obj::native_array_sequence>(a1));
+              return typed_source->call(pack_rest(a1));
             case callable::mask_variadic_arity(1):
               if(!callable::is_variadic_ambiguous(arity_flags))
               {
@@ -109,9 +121,9 @@ namespace jank::runtime
           switch(mask)
           {
             case callable::mask_variadic_arity(0):
-              return typed_source->call(make_box<obj::native_array_sequence>(a1, a2));
+              return typed_source->call(pack_rest(a1, a2));
             case callable::mask_variadic_arity(1):
-              return typed_source->call(a1, make_box<obj::native_array_sequence>(a2));
+              return typed_source->call(a1, pack_rest(a2));
             case callable::mask_variadic_arity(2):
               if(!callable::is_variadic_ambiguous(arity_flags))
               {
@@ -157,11 +169,11 @@ namespace jank::runtime
           switch(mask)
           {
             case callable::mask_variadic_arity(0):
-              return typed_source->call(make_box<obj::native_array_sequence>(a1, a2, a3));
+              return typed_source->call(pack_rest(a1, a2, a3));
             case callable::mask_variadic_arity(1):
-              return typed_source->call(a1, make_box<obj::native_array_sequence>(a2, a3));
+              return typed_source->call(a1, pack_rest(a2, a3));
             case callable::mask_variadic_arity(2):
-              return typed_source->call(a1, a2, make_box<obj::native_array_sequence>(a3));
+              return typed_source->call(a1, a2, pack_rest(a3));
             case callable::mask_variadic_arity(3):
               if(!callable::is_variadic_ambiguous(arity_flags))
               {
@@ -203,13 +215,13 @@ namespace jank::runtime
           switch(mask)
           {
             case callable::mask_variadic_arity(0):
-              return typed_source->call(make_box<obj::native_array_sequence>(a1, a2, a3, a4));
+              return typed_source->call(pack_rest(a1, a2, a3, a4));
             case callable::mask_variadic_arity(1):
-              return typed_source->call(a1, make_box<obj::native_array_sequence>(a2, a3, a4));
+              return typed_source->call(a1, pack_rest(a2, a3, a4));
             case callable::mask_variadic_arity(2):
-              return typed_source->call(a1, a2, make_box<obj::native_array_sequence>(a3, a4));
+              return typed_source->call(a1, a2, pack_rest(a3, a4));
             case callable::mask_variadic_arity(3):
-              return typed_source->call(a1, a2, a3, make_box<obj::native_array_sequence>(a4));
+              return typed_source->call(a1, a2, a3, pack_rest(a4));
             case callable::mask_variadic_arity(4):
               if(!callable::is_variadic_ambiguous(arity_flags))
               {
@@ -252,15 +264,15 @@ namespace jank::runtime
           switch(mask)
           {
             case callable::mask_variadic_arity(0):
-              return typed_source->call(make_box<obj::native_array_sequence>(a1, a2, a3, a4, a5));
+              return typed_source->call(pack_rest(a1, a2, a3, a4, a5));
             case callable::mask_variadic_arity(1):
-              return typed_source->call(a1, make_box<obj::native_array_sequence>(a2, a3, a4, a5));
+              return typed_source->call(a1, pack_rest(a2, a3, a4, a5));
             case callable::mask_variadic_arity(2):
-              return typed_source->call(a1, a2, make_box<obj::native_array_sequence>(a3, a4, a5));
+              return typed_source->call(a1, a2, pack_rest(a3, a4, a5));
             case callable::mask_variadic_arity(3):
-              return typed_source->call(a1, a2, a3, make_box<obj::native_array_sequence>(a4, a5));
+              return typed_source->call(a1, a2, a3, pack_rest(a4, a5));
             case callable::mask_variadic_arity(4):
-              return typed_source->call(a1, a2, a3, a4, make_box<obj::native_array_sequence>(a5));
+              return typed_source->call(a1, a2, a3, a4, pack_rest(a5));
             case callable::mask_variadic_arity(5):
               if(!callable::is_variadic_ambiguous(arity_flags))
               {
@@ -304,29 +316,17 @@ namespace jank::runtime
           switch(mask)
           {
             case callable::mask_variadic_arity(0):
-              return typed_source->call(
-                make_box<obj::native_array_sequence>(a1, a2, a3, a4, a5, a6));
+              return typed_source->call(pack_rest(a1, a2, a3, a4, a5, a6));
             case callable::mask_variadic_arity(1):
-              return typed_source->call(a1,
-                                        make_box<obj::native_array_sequence>(a2, a3, a4, a5, a6));
+              return typed_source->call(a1, pack_rest(a2, a3, a4, a5, a6));
             case callable::mask_variadic_arity(2):
-              return typed_source->call(a1,
-                                        a2,
-                                        make_box<obj::native_array_sequence>(a3, a4, a5, a6));
+              return typed_source->call(a1, a2, pack_rest(a3, a4, a5, a6));
             case callable::mask_variadic_arity(3):
-              return typed_source->call(a1,
-                                        a2,
-                                        a3,
-                                        make_box<obj::native_array_sequence>(a4, a5, a6));
+              return typed_source->call(a1, a2, a3, pack_rest(a4, a5, a6));
             case callable::mask_variadic_arity(4):
-              return typed_source->call(a1,
-                                        a2,
-                                        a3,
-                                        a4,
-                                        make_box<obj::native_array_sequence>(a5, a6));
+              return typed_source->call(a1, a2, a3, a4, pack_rest(a5, a6));
             case callable::mask_variadic_arity(5):
-              return typed_source
-                ->call(a1, a2, a3, a4, a5, make_box<obj::native_array_sequence>(a6));
+              return typed_source->call(a1, a2, a3, a4, a5, pack_rest(a6));
             case callable::mask_variadic_arity(6):
               if(!callable::is_variadic_ambiguous(arity_flags))
               {
@@ -371,33 +371,19 @@ namespace jank::runtime
           switch(mask)
           {
             case callable::mask_variadic_arity(0):
-              return typed_source->call(
-                make_box<obj::native_array_sequence>(a1, a2, a3, a4, a5, a6, a7));
+              return typed_source->call(pack_rest(a1, a2, a3, a4, a5, a6, a7));
             case callable::mask_variadic_arity(1):
-              return typed_source->call(
-                a1,
-                make_box<obj::native_array_sequence>(a2, a3, a4, a5, a6, a7));
+              return typed_source->call(a1, pack_rest(a2, a3, a4, a5, a6, a7));
             case callable::mask_variadic_arity(2):
-              return typed_source->call(a1,
-                                        a2,
-                                        make_box<obj::native_array_sequence>(a3, a4, a5, a6, a7));
+              return typed_source->call(a1, a2, pack_rest(a3, a4, a5, a6, a7));
             case callable::mask_variadic_arity(3):
-              return typed_source->call(a1,
-                                        a2,
-                                        a3,
-                                        make_box<obj::native_array_sequence>(a4, a5, a6, a7));
+              return typed_source->call(a1, a2, a3, pack_rest(a4, a5, a6, a7));
             case callable::mask_variadic_arity(4):
-              return typed_source->call(a1,
-                                        a2,
-                                        a3,
-                                        a4,
-                                        make_box<obj::native_array_sequence>(a5, a6, a7));
+              return typed_source->call(a1, a2, a3, a4, pack_rest(a5, a6, a7));
             case callable::mask_variadic_arity(5):
-              return typed_source
-                ->call(a1, a2, a3, a4, a5, make_box<obj::native_array_sequence>(a6, a7));
+              return typed_source->call(a1, a2, a3, a4, a5, pack_rest(a6, a7));
             case callable::mask_variadic_arity(6):
-              return typed_source
-                ->call(a1, a2, a3, a4, a5, a6, make_box<obj::native_array_sequence>(a7));
+              return typed_source->call(a1, a2, a3, a4, a5, a6, pack_rest(a7));
             case callable::mask_variadic_arity(7):
               if(!callable::is_variadic_ambiguous(arity_flags))
               {
@@ -443,37 +429,21 @@ namespace jank::runtime
           switch(mask)
           {
             case callable::mask_variadic_arity(0):
-              return typed_source->call(
-                make_box<obj::native_array_sequence>(a1, a2, a3, a4, a5, a6, a7, a8));
+              return typed_source->call(pack_rest(a1, a2, a3, a4, a5, a6, a7, a8));
             case callable::mask_variadic_arity(1):
-              return typed_source->call(
-                a1,
-                make_box<obj::native_array_sequence>(a2, a3, a4, a5, a6, a7, a8));
+              return typed_source->call(a1, pack_rest(a2, a3, a4, a5, a6, a7, a8));
             case callable::mask_variadic_arity(2):
-              return typed_source->call(
-                a1,
-                a2,
-                make_box<obj::native_array_sequence>(a3, a4, a5, a6, a7, a8));
+              return typed_source->call(a1, a2, pack_rest(a3, a4, a5, a6, a7, a8));
             case callable::mask_variadic_arity(3):
-              return typed_source->call(a1,
-                                        a2,
-                                        a3,
-                                        make_box<obj::native_array_sequence>(a4, a5, a6, a7, a8));
+              return typed_source->call(a1, a2, a3, pack_rest(a4, a5, a6, a7, a8));
             case callable::mask_variadic_arity(4):
-              return typed_source->call(a1,
-                                        a2,
-                                        a3,
-                                        a4,
-                                        make_box<obj::native_array_sequence>(a5, a6, a7, a8));
+              return typed_source->call(a1, a2, a3, a4, pack_rest(a5, a6, a7, a8));
             case callable::mask_variadic_arity(5):
-              return typed_source
-                ->call(a1, a2, a3, a4, a5, make_box<obj::native_array_sequence>(a6, a7, a8));
+              return typed_source->call(a1, a2, a3, a4, a5, pack_rest(a6, a7, a8));
             case callable::mask_variadic_arity(6):
-              return typed_source
-                ->call(a1, a2, a3, a4, a5, a6, make_box<obj::native_array_sequence>(a7, a8));
+              return typed_source->call(a1, a2, a3, a4, a5, a6, pack_rest(a7, a8));
             case callable::mask_variadic_arity(7):
-              return typed_source
-                ->call(a1, a2, a3, a4, a5, a6, a7, make_box<obj::native_array_sequence>(a8));
+              return typed_source->call(a1, a2, a3, a4, a5, a6, a7, pack_rest(a8));
             case callable::mask_variadic_arity(8):
               if(!callable::is_variadic_ambiguous(arity_flags))
               {
@@ -520,38 +490,23 @@ namespace jank::runtime
           switch(mask)
           {
             case callable::mask_variadic_arity(0):
-              return typed_source->call(
-                make_box<obj::native_array_sequence>(a1, a2, a3, a4, a5, a6, a7, a8, a9));
+              return typed_source->call(pack_rest(a1, a2, a3, a4, a5, a6, a7, a8, a9));
             case callable::mask_variadic_arity(1):
-              return typed_source->call(
-                a1,
-                make_box<obj::native_array_sequence>(a2, a3, a4, a5, a6, a7, a8, a9));
+              return typed_source->call(a1, pack_rest(a2, a3, a4, a5, a6, a7, a8, a9));
             case callable::mask_variadic_arity(2):
-              return typed_source->call(
-                a1,
-                a2,
-                make_box<obj::native_array_sequence>(a3, a4, a5, a6, a7, a8, a9));
+              return typed_source->call(a1, a2, pack_rest(a3, a4, a5, a6, a7, a8, a9));
             case callable::mask_variadic_arity(3):
-              return typed_source
-                ->call(a1, a2, a3, make_box<obj::native_array_sequence>(a4, a5, a6, a7, a8, a9));
+              return typed_source->call(a1, a2, a3, pack_rest(a4, a5, a6, a7, a8, a9));
             case callable::mask_variadic_arity(4):
-              return typed_source->call(a1,
-                                        a2,
-                                        a3,
-                                        a4,
-                                        make_box<obj::native_array_sequence>(a5, a6, a7, a8, a9));
+              return typed_source->call(a1, a2, a3, a4, pack_rest(a5, a6, a7, a8, a9));
             case callable::mask_variadic_arity(5):
-              return typed_source
-                ->call(a1, a2, a3, a4, a5, make_box<obj::native_array_sequence>(a6, a7, a8, a9));
+              return typed_source->call(a1, a2, a3, a4, a5, pack_rest(a6, a7, a8, a9));
             case callable::mask_variadic_arity(6):
-              return typed_source
-                ->call(a1, a2, a3, a4, a5, a6, make_box<obj::native_array_sequence>(a7, a8, a9));
+              return typed_source->call(a1, a2, a3, a4, a5, a6, pack_rest(a7, a8, a9));
             case callable::mask_variadic_arity(7):
-              return typed_source
-                ->call(a1, a2, a3, a4, a5, a6, a7, make_box<obj::native_array_sequence>(a8, a9));
+              return typed_source->call(a1, a2, a3, a4, a5, a6, a7, pack_rest(a8, a9));
             case callable::mask_variadic_arity(8):
-              return typed_source
-                ->call(a1, a2, a3, a4, a5, a6, a7, a8, make_box<obj::native_array_sequence>(a9));
+              return typed_source->call(a1, a2, a3, a4, a5, a6, a7, a8, pack_rest(a9));
             case callable::mask_variadic_arity(9):
               if(!callable::is_variadic_ambiguous(arity_flags))
               {
@@ -600,88 +555,29 @@ namespace jank::runtime
           switch(mask)
           {
             case callable::mask_variadic_arity(0):
-              return typed_source->call(
-                make_box<obj::native_array_sequence>(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10));
+              return typed_source->call(pack_rest(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10));
             case callable::mask_variadic_arity(1):
-              return typed_source->call(
-                a1,
-                make_box<obj::native_array_sequence>(a2, a3, a4, a5, a6, a7, a8, a9, a10));
+              return typed_source->call(a1, pack_rest(a2, a3, a4, a5, a6, a7, a8, a9, a10));
             case callable::mask_variadic_arity(2):
-              return typed_source->call(
-                a1,
-                a2,
-                make_box<obj::native_array_sequence>(a3, a4, a5, a6, a7, a8, a9, a10));
+              return typed_source->call(a1, a2, pack_rest(a3, a4, a5, a6, a7, a8, a9, a10));
             case callable::mask_variadic_arity(3):
-              return typed_source->call(
-                a1,
-                a2,
-                a3,
-                make_box<obj::native_array_sequence>(a4, a5, a6, a7, a8, a9, a10));
+              return typed_source->call(a1, a2, a3, pack_rest(a4, a5, a6, a7, a8, a9, a10));
             case callable::mask_variadic_arity(4):
-              return typed_source->call(
-                a1,
-                a2,
-                a3,
-                a4,
-                make_box<obj::native_array_sequence>(a5, a6, a7, a8, a9, a10));
+              return typed_source->call(a1, a2, a3, a4, pack_rest(a5, a6, a7, a8, a9, a10));
             case callable::mask_variadic_arity(5):
-              return typed_source->call(a1,
-                                        a2,
-                                        a3,
-                                        a4,
-                                        a5,
-                                        make_box<obj::native_array_sequence>(a6, a7, a8, a9, a10));
+              return typed_source->call(a1, a2, a3, a4, a5, pack_rest(a6, a7, a8, a9, a10));
             case callable::mask_variadic_arity(6):
-              return typed_source->call(a1,
-                                        a2,
-                                        a3,
-                                        a4,
-                                        a5,
-                                        a6,
-                                        make_box<obj::native_array_sequence>(a7, a8, a9, a10));
+              return typed_source->call(a1, a2, a3, a4, a5, a6, pack_rest(a7, a8, a9, a10));
             case callable::mask_variadic_arity(7):
-              return typed_source->call(a1,
-                                        a2,
-                                        a3,
-                                        a4,
-                                        a5,
-                                        a6,
-                                        a7,
-                                        make_box<obj::native_array_sequence>(a8, a9, a10));
+              return typed_source->call(a1, a2, a3, a4, a5, a6, a7, pack_rest(a8, a9, a10));
             case callable::mask_variadic_arity(8):
-              return typed_source->call(a1,
-                                        a2,
-                                        a3,
-                                        a4,
-                                        a5,
-                                        a6,
-                                        a7,
-                                        a8,
-                                        make_box<obj::native_array_sequence>(a9, a10));
+              return typed_source->call(a1, a2, a3, a4, a5, a6, a7, a8, pack_rest(a9, a10));
             case callable::mask_variadic_arity(9):
-              return typed_source->call(a1,
-                                        a2,
-                                        a3,
-                                        a4,
-                                        a5,
-                                        a6,
-                                        a7,
-                                        a8,
-                                        a9,
-                                        make_box<obj::native_array_sequence>(a10));
+              return typed_source->call(a1, a2, a3, a4, a5, a6, a7, a8, a9, pack_rest(a10));
             case callable::mask_variadic_arity(10):
               if(!callable::is_variadic_ambiguous(arity_flags))
               {
-                return typed_source->call(a1,
-                                          a2,
-                                          a3,
-                                          a4,
-                                          a5,
-                                          a6,
-                                          a7,
-                                          a8,
-                                          a9,
-                                          make_box<obj::native_array_sequence>(a10));
+                return typed_source->call(a1, a2, a3, a4, a5, a6, a7, a8, a9, pack_rest(a10));
               }
             default:
               return typed_source->call(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10);
@@ -696,271 +592,215 @@ namespace jank::runtime
       source);
   }
 
-  object_ptr dynamic_call(object_ptr source,
-                          object_ptr const a1,
-                          object_ptr const a2,
-                          object_ptr const a3,
-                          object_ptr const a4,
-                          object_ptr const a5,
-                          object_ptr const a6,
-                          object_ptr const a7,
-                          object_ptr const a8,
-                          object_ptr const a9,
-                          object_ptr const a10,
-                          obj::persistent_list_ptr const rest)
+  /* Only callables can have a variadic arity, so these are the only objects for which we hand
+   * over a rest seq ourselves, rather than having dynamic_call pack one. */
+  static callable *variadic_callable(object_ptr const source)
   {
-    /* TODO: Move call fns into var so we can remove these checks. */
-    if(source->type == object_type::var)
-    {
-      source = runtime::deref(source);
-    }
-
-    return visit_object(
-      [=](auto const typed_source) -> object_ptr {
+    auto const ret(visit_object(
+      [](auto const typed_source) -> callable * {
         using T = typename decltype(typed_source)::value_type;
 
-        if constexpr(function_like<T> || std::is_base_of_v<callable, T>)
+        if constexpr(std::is_base_of_v<callable, T>)
         {
-          auto const arity_flags(typed_source->get_arity_flags());
-          auto const mask(callable::extract_variadic_arity_mask(arity_flags));
-          switch(mask)
-          {
-            /* TODO: Optimize this with a faster seq? */
-            case callable::mask_variadic_arity(0):
-              {
-                native_vector<object_ptr> packed;
-                packed.reserve(10 + rest->count());
-                packed.insert(packed.end(), { a1, a2, a3, a4, a5, a6, a7, a8, a9, a10 });
-                std::copy(rest->data.begin(), rest->data.end(), std::back_inserter(packed));
-                return typed_source->call(make_box<obj::native_vector_sequence>(std::move(packed)));
-              }
-            case callable::mask_variadic_arity(1):
-              {
-                native_vector<object_ptr> packed;
-                packed.reserve(9 + rest->count());
-                packed.insert(packed.end(), { a2, a3, a4, a5, a6, a7, a8, a9, a10 });
-                std::copy(rest->data.begin(), rest->data.end(), std::back_inserter(packed));
-                return typed_source->call(a1,
-                                          make_box<obj::native_vector_sequence>(std::move(packed)));
-              }
-            case callable::mask_variadic_arity(2):
-              {
-                native_vector<object_ptr> packed;
-                packed.reserve(8 + rest->count());
-                packed.insert(packed.end(), { a3, a4, a5, a6, a7, a8, a9, a10 });
-                std::copy(rest->data.begin(), rest->data.end(), std::back_inserter(packed));
-                return typed_source->call(a1,
-                                          a2,
-                                          make_box<obj::native_vector_sequence>(std::move(packed)));
-              }
-            case callable::mask_variadic_arity(3):
-              {
-                native_vector<object_ptr> packed;
-                packed.reserve(7 + rest->count());
-                packed.insert(packed.end(), { a4, a5, a6, a7, a8, a9, a10 });
-                std::copy(rest->data.begin(), rest->data.end(), std::back_inserter(packed));
-                return typed_source->call(a1,
-                                          a2,
-                                          a3,
-                                          make_box<obj::native_vector_sequence>(std::move(packed)));
-              }
-            case callable::mask_variadic_arity(4):
-              {
-                native_vector<object_ptr> packed;
-                packed.reserve(6 + rest->count());
-                packed.insert(packed.end(), { a5, a6, a7, a8, a9, a10 });
-                std::copy(rest->data.begin(), rest->data.end(), std::back_inserter(packed));
-                return typed_source->call(a1,
-                                          a2,
-                                          a3,
-                                          a4,
-                                          make_box<obj::native_vector_sequence>(std::move(packed)));
-              }
-            case callable::mask_variadic_arity(5):
-              {
-                native_vector<object_ptr> packed;
-                packed.reserve(5 + rest->count());
-                packed.insert(packed.end(), { a6, a7, a8, a9, a10 });
-                std::copy(rest->data.begin(), rest->data.end(), std::back_inserter(packed));
-                return typed_source->call(a1,
-                                          a2,
-                                          a3,
-                                          a4,
-                                          a5,
-                                          make_box<obj::native_vector_sequence>(std::move(packed)));
-              }
-            case callable::mask_variadic_arity(6):
-              {
-                native_vector<object_ptr> packed;
-                packed.reserve(4 + rest->count());
-                packed.insert(packed.end(), { a7, a8, a9, a10 });
-                std::copy(rest->data.begin(), rest->data.end(), std::back_inserter(packed));
-                return typed_source->call(a1,
-                                          a2,
-                                          a3,
-                                          a4,
-                                          a5,
-                                          a6,
-                                          make_box<obj::native_vector_sequence>(std::move(packed)));
-              }
-            case callable::mask_variadic_arity(7):
-              {
-                native_vector<object_ptr> packed;
-                packed.reserve(3 + rest->count());
-                packed.insert(packed.end(), { a8, a9, a10 });
-                std::copy(rest->data.begin(), rest->data.end(), std::back_inserter(packed));
-                return typed_source->call(a1,
-                                          a2,
-                                          a3,
-                                          a4,
-                                          a5,
-                                          a6,
-                                          a7,
-                                          make_box<obj::native_vector_sequence>(std::move(packed)));
-              }
-            case callable::mask_variadic_arity(8):
-              {
-                native_vector<object_ptr> packed;
-                packed.reserve(2 + rest->count());
-                packed.insert(packed.end(), { a9, a10 });
-                std::copy(rest->data.begin(), rest->data.end(), std::back_inserter(packed));
-                return typed_source->call(a1,
-                                          a2,
-                                          a3,
-                                          a4,
-                                          a5,
-                                          a6,
-                                          a7,
-                                          a8,
-                                          make_box<obj::native_vector_sequence>(std::move(packed)));
-              }
-            case callable::mask_variadic_arity(9):
-              {
-                native_vector<object_ptr> packed;
-                packed.reserve(1 + rest->count());
-                packed.insert(packed.end(), { a10 });
-                std::copy(rest->data.begin(), rest->data.end(), std::back_inserter(packed));
-                return typed_source->call(a1,
-                                          a2,
-                                          a3,
-                                          a4,
-                                          a5,
-                                          a6,
-                                          a7,
-                                          a8,
-                                          a9,
-                                          make_box<obj::native_vector_sequence>(std::move(packed)));
-              }
-            default:
-              throw std::runtime_error{ fmt::format("unsupported arity: {}", 10 + rest->count()) };
-          }
+          return typed_source.data;
         }
         else
         {
-          throw std::runtime_error{ fmt::format("invalid call with {} args to: {}",
-                                                10 + sequence_length(rest),
-                                                typed_source->to_string()) };
+          return nullptr;
         }
       },
-      source);
+      source));
+
+    if(!ret || !(ret->get_arity_flags() & callable::mask_variadic_arity(0)))
+    {
+      return nullptr;
+    }
+    return ret;
+  }
+
+  static object_ptr call_with_rest(callable * const source,
+                                   object_ptr const * const fixed,
+                                   size_t const fixed_count,
+                                   object_ptr const rest)
+  {
+    switch(fixed_count)
+    {
+      case 0:
+        return source->call(rest);
+      case 1:
+        return source->call(fixed[0], rest);
+      case 2:
+        return source->call(fixed[0], fixed[1], rest);
+      case 3:
+        return source->call(fixed[0], fixed[1], fixed[2], rest);
+      case 4:
+        return source->call(fixed[0], fixed[1], fixed[2], fixed[3], rest);
+      case 5:
+        return source->call(fixed[0], fixed[1], fixed[2], fixed[3], fixed[4], rest);
+      case 6:
+        return source->call(fixed[0], fixed[1], fixed[2], fixed[3], fixed[4], fixed[5], rest);
+      case 7:
+        return source->call(fixed[0],
+                            fixed[1],
+                            fixed[2],
+                            fixed[3],
+                            fixed[4],
+                            fixed[5],
+                            fixed[6],
+                            rest);
+      case 8:
+        return source->call(fixed[0],
+                            fixed[1],
+                            fixed[2],
+                            fixed[3],
+                            fixed[4],
+                            fixed[5],
+                            fixed[6],
+                            fixed[7],
+                            rest);
+      case 9:
+        return source->call(fixed[0],
+                            fixed[1],
+                            fixed[2],
+                            fixed[3],
+                            fixed[4],
+                            fixed[5],
+                            fixed[6],
+                            fixed[7],
+                            fixed[8],
+                            rest);
+      default:
+        throw std::runtime_error{ fmt::format("unsupported arity: {}", fixed_count + 1) };
+    }
+  }
+
+  object_ptr dynamic_call(object_ptr source, object_ptr const * const args, size_t const arg_count)
+  {
+    switch(arg_count)
+    {
+      case 0:
+        return dynamic_call(source);
+      case 1:
+        return dynamic_call(source, args[0]);
+      case 2:
+        return dynamic_call(source, args[0], args[1]);
+      case 3:
+        return dynamic_call(source, args[0], args[1], args[2]);
+      case 4:
+        return dynamic_call(source, args[0], args[1], args[2], args[3]);
+      case 5:
+        return dynamic_call(source, args[0], args[1], args[2], args[3], args[4]);
+      case 6:
+        return dynamic_call(source, args[0], args[1], args[2], args[3], args[4], args[5]);
+      case 7:
+        return dynamic_call(source, args[0], args[1], args[2], args[3], args[4], args[5], args[6]);
+      case 8:
+        return dynamic_call(source,
+                            args[0],
+                            args[1],
+                            args[2],
+                            args[3],
+                            args[4],
+                            args[5],
+                            args[6],
+                            args[7]);
+      case 9:
+        return dynamic_call(source,
+                            args[0],
+                            args[1],
+                            args[2],
+                            args[3],
+                            args[4],
+                            args[5],
+                            args[6],
+                            args[7],
+                            args[8]);
+      case 10:
+        return dynamic_call(source,
+                            args[0],
+                            args[1],
+                            args[2],
+                            args[3],
+                            args[4],
+                            args[5],
+                            args[6],
+                            args[7],
+                            args[8],
+                            args[9]);
+      default:
+        break;
+    }
+
+    /* TODO: Move call fns into var so we can remove these checks. */
+    if(source->type == object_type::var)
+    {
+      source = runtime::deref(source);
+    }
+
+    /* With more args than any fixed arity can take, only a variadic arity will do. The args
+     * beyond its fixed params are copied once, into the rest seq. */
+    auto const typed_source(variadic_callable(source));
+    if(!typed_source)
+    {
+      throw std::runtime_error{ fmt::format("invalid call with {} args to: {}",
+                                            arg_count,
+                                            runtime::to_string(source)) };
+    }
+
+    auto const fixed_count(
+      static_cast<size_t>(typed_source->get_arity_flags() & callable::fixed_arity_mask));
+    return call_with_rest(
+      typed_source,
+      args,
+      fixed_count,
+      obj::native_array_sequence::create(args + fixed_count, arg_count - fixed_count));
   }
 
   object_ptr apply_to(object_ptr const source, object_ptr const args)
   {
+    auto const callee(source->type == object_type::var ? runtime::deref(source) : source);
+    auto const variadic_callee(variadic_callable(callee));
+
     return visit_seqable(
       [=](auto const typed_args) -> object_ptr {
         auto const s(typed_args->fresh_seq());
+
+        /* When applying a variadic fn, the rest param just gets the tail of our fresh seq.
+         * Nothing is copied and lazy seqs are only realized as far as the fixed params. */
+        if(variadic_callee)
+        {
+          auto const fixed_count(static_cast<size_t>(variadic_callee->get_arity_flags()
+                                                     & callable::fixed_arity_mask));
+          if(fixed_count < sequence_length(s, fixed_count + 1))
+          {
+            std::array<object_ptr, max_params> fixed;
+            for(size_t i{}; i < fixed_count; ++i)
+            {
+              fixed[i] = s->first();
+              s->next_in_place();
+            }
+            return call_with_rest(variadic_callee, fixed.data(), fixed_count, s);
+          }
+        }
+
         auto const length(sequence_length(s, max_params + 1));
-        switch(length)
+        if(length <= max_params)
+        {
+          std::array<object_ptr, max_params> arg_vals;
+          for(size_t i{}; i < length; ++i)
+          {
+            arg_vals[i] = s->first();
+            s->next_in_place();
+          }
+          return dynamic_call(callee, arg_vals.data(), length);
+        }
+
+        native_vector<object_ptr> arg_vals{ s->first() };
+        while(s->next_in_place())
         {
-          case 0:
-            return dynamic_call(source);
-          case 1:
-            return dynamic_call(source, s->first());
-          case 2:
-            return dynamic_call(source, s->first(), s->next_in_place()->first());
-          case 3:
-            return dynamic_call(source,
-                                s->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first());
-          case 4:
-            return dynamic_call(source,
-                                s->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first());
-          case 5:
-            return dynamic_call(source,
-                                s->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first());
-          case 6:
-            return dynamic_call(source,
-                                s->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first());
-          case 7:
-            return dynamic_call(source,
-                                s->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first());
-          case 8:
-            return dynamic_call(source,
-                                s->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first());
-          case 9:
-            return dynamic_call(source,
-                                s->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first());
-          case 10:
-            return dynamic_call(source,
-                                s->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first());
-          default:
-            return dynamic_call(source,
-                                s->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                s->next_in_place()->first(),
-                                obj::persistent_list::create(next_in_place(s)));
+          arg_vals.emplace_back(s->first());
         }
+        return dynamic_call(callee, arg_vals.data(), arg_vals.size());
       },
       args);
   }
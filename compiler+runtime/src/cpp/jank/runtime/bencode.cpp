@@ -0,0 +1,312 @@
+#include <algorithm>
+
+#include <jank/runtime/bencode.hpp>
+#include <jank/runtime/visit.hpp>
+#include <jank/runtime/core.hpp>
+#include <jank/runtime/core/seq.hpp>
+#include <jank/runtime/obj/persistent_array_map.hpp>
+#include <jank/runtime/obj/transient_array_map.hpp>
+#include <jank/runtime/obj/transient_vector.hpp>
+#include <jank/runtime/obj/writer.hpp>
+
+namespace jank::runtime::bencode
+{
+  decode_result decoder::decode_some(native_persistent_string const &input, size_t const offset)
+  {
+    auto const data(input.data());
+    auto const size(input.size());
+    auto pos(offset);
+
+    while(pos < size)
+    {
+      object_ptr done{};
+      auto const c(data[pos]);
+
+      switch(st)
+      {
+        case state::value:
+          ++pos;
+          switch(c)
+          {
+            case 'i':
+              st = state::integer;
+              integer = 0;
+              negative = has_digits = false;
+              break;
+            case 'l':
+              stack.push_back({ obj::transient_vector::empty(), nullptr, nullptr });
+              break;
+            case 'd':
+              stack.push_back(
+                { nullptr, obj::persistent_array_map::empty()->to_transient(), nullptr });
+              break;
+            case 'e':
+              {
+                if(stack.empty())
+                {
+                  return invalid("extraneous 'e' found");
+                }
+
+                auto const coll(stack.back());
+                stack.pop_back();
+                if(coll.list)
+                {
+                  done = coll.list->to_persistent();
+                }
+                else if(coll.next_key)
+                {
+                  return invalid("odd number of dict fields");
+                }
+                else
+                {
+                  done = runtime::persistent(coll.dict);
+                }
+              }
+              break;
+            case '0' ... '9':
+              st = state::string_length;
+              remaining = static_cast<size_t>(c - '0');
+              break;
+            default:
+              return invalid("unsupported character");
+          }
+          break;
+
+        case state::integer:
+          ++pos;
+          if(c == 'e')
+          {
+            if(!has_digits)
+            {
+              return invalid("unable to parse int");
+            }
+            st = state::value;
+            done = make_box(integer);
+          }
+          else if(c == '-' && !has_digits && !negative)
+          {
+            negative = true;
+          }
+          else if(c >= '0' && c <= '9')
+          {
+            /* Accumulating on the negative side lets us reach the smallest integer. */
+            native_integer const digit{ c - '0' };
+            if(__builtin_mul_overflow(integer, 10, &integer)
+               || (negative ? __builtin_sub_overflow(integer, digit, &integer)
+                            : __builtin_add_overflow(integer, digit, &integer)))
+            {
+              return invalid("int is out of range");
+            }
+            has_digits = true;
+          }
+          else
+          {
+            return invalid("unable to parse int");
+          }
+          break;
+
+        case state::string_length:
+          ++pos;
+          if(c == ':')
+          {
+            /* The common case is that the whole string is already here. */
+            if(remaining <= size - pos)
+            {
+              st = state::value;
+              done = make_box<obj::persistent_string>(input.shared_substr(pos, remaining));
+              pos += remaining;
+            }
+            else
+            {
+              st = state::string_body;
+              partial_string.clear();
+              partial_string.reserve(remaining);
+            }
+          }
+          else if(c >= '0' && c <= '9')
+          {
+            if(__builtin_mul_overflow(remaining, 10, &remaining)
+               || __builtin_add_overflow(remaining, static_cast<size_t>(c - '0'), &remaining))
+            {
+              return invalid("invalid string size");
+            }
+          }
+          else
+          {
+            return invalid("unable to parse string size");
+          }
+          break;
+
+        case state::string_body:
+          {
+            auto const available(std::min(remaining, size - pos));
+            partial_string.insert(partial_string.end(), data + pos, data + pos + available);
+            pos += available;
+            remaining -= available;
+            if(remaining == 0)
+            {
+              st = state::value;
+              done = make_box(
+                native_persistent_string_view{ partial_string.data(), partial_string.size() });
+              partial_string.clear();
+            }
+          }
+          break;
+      }
+
+      if(!done)
+      {
+        continue;
+      }
+
+      if(stack.empty())
+      {
+        return std::make_pair(done, pos);
+      }
+
+      auto &top(stack.back());
+      if(top.list)
+      {
+        top.list->conj_in_place(done);
+      }
+      else if(!top.next_key)
+      {
+        if(done->type != object_type::persistent_string)
+        {
+          return invalid("non-string dict key");
+        }
+        top.next_key = done;
+      }
+      else
+      {
+        top.dict = runtime::assoc_in_place(top.dict, top.next_key, done);
+        top.next_key = nullptr;
+      }
+    }
+
+    return decode_error{ "unexpected EOF", decode_error_reason::incomplete_data };
+  }
+
+  native_bool decoder::is_partial() const
+  {
+    return st != state::value || !stack.empty();
+  }
+
+  decode_error decoder::invalid(native_persistent_string const &message)
+  {
+    stack.clear();
+    partial_string.clear();
+    st = state::value;
+    return { message, decode_error_reason::invalid_data };
+  }
+
+  result<object_ptr, decode_error> decode(native_persistent_string const &input)
+  {
+    if(input.empty())
+    {
+      return ok(obj::nil::nil_const());
+    }
+
+    decoder d;
+    auto const res(d.decode_some(input, 0));
+    if(res.is_err())
+    {
+      return err(res.expect_err());
+    }
+    return ok(res.expect_ok().first);
+  }
+
+  static void write_string(util::string_builder &buff, native_persistent_string_view const &s)
+  {
+    buff(s.size())(':')(s);
+  }
+
+  static native_persistent_string key_string(object_ptr const o)
+  {
+    switch(o->type)
+    {
+      case object_type::persistent_string:
+        return expect_object<obj::persistent_string>(o)->data;
+      case object_type::keyword:
+        return expect_object<obj::keyword>(o)->sym->to_string();
+      case object_type::symbol:
+        return expect_object<obj::symbol>(o)->to_string();
+      default:
+        throw std::runtime_error{ "bencode dict keys must be strings, keywords, or symbols, not "
+                                  + to_code_string(o) };
+    }
+  }
+
+  void encode(util::string_builder &buff, object_ptr const o)
+  {
+    switch(o->type)
+    {
+      case object_type::integer:
+        buff('i')(expect_object<obj::integer>(o)->data)('e');
+        return;
+      case object_type::persistent_string:
+        write_string(buff, expect_object<obj::persistent_string>(o)->data);
+        return;
+      case object_type::keyword:
+      case object_type::symbol:
+        write_string(buff, key_string(o));
+        return;
+      case object_type::nil:
+        buff("le");
+        return;
+      default:
+        break;
+    }
+
+    visit_map_like(
+      [&](auto const typed_o) {
+        /* Dict keys must be sorted by their raw bytes. */
+        native_vector<std::pair<native_persistent_string, object_ptr>> entries;
+        entries.reserve(typed_o->count());
+        for(auto const &entry : typed_o->data)
+        {
+          entries.emplace_back(key_string(entry.first), entry.second);
+        }
+        std::sort(entries.begin(), entries.end(), [](auto const &l, auto const &r) {
+          return native_persistent_string_view{ l.first }
+            < native_persistent_string_view{ r.first };
+        });
+
+        buff('d');
+        for(auto const &entry : entries)
+        {
+          write_string(buff, entry.first);
+          encode(buff, entry.second);
+        }
+        buff('e');
+      },
+      [&]() {
+        visit_seqable(
+          [&](auto const typed_o) {
+            buff('l');
+            for(auto it(typed_o->fresh_seq()); it != nullptr; it = runtime::next_in_place(it))
+            {
+              encode(buff, it->first());
+            }
+            buff('e');
+          },
+          [&]() { throw std::runtime_error{ "unable to bencode " + to_code_string(o) }; },
+          o);
+      },
+      o);
+  }
+
+  native_persistent_string encode(object_ptr const o)
+  {
+    util::string_builder buff;
+    encode(buff, o);
+    return buff.release();
+  }
+
+  void encode_to(obj::writer_ptr const w, object_ptr const o)
+  {
+    std::lock_guard<std::recursive_mutex> const lock{ w->mutex };
+    encode(w->buffer, o);
+    w->wrote();
+  }
+}
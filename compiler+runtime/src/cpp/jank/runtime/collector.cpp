@@ -0,0 +1,181 @@
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <stdexcept>
+
+#include <gc/gc.h>
+
+#include <fmt/format.h>
+
+#include <jank/runtime/collector.hpp>
+#include <jank/util/cli.hpp>
+
+namespace jank::runtime::collector
+{
+  /* These are all touched from within Boehm's event callback, which can be called
+   * from whichever thread triggered the collection, so they need to be atomic. The
+   * callback must not allocate. */
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static std::atomic<native_integer> collections{};
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static std::atomic<native_integer> pause_count{};
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static std::atomic<native_integer> pause_total_ns{};
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static std::atomic<native_integer> pause_max_ns{};
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static std::atomic<native_integer> pause_start_ns{};
+
+  static native_integer now_ns()
+  {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+  }
+
+  /* We only care about a few of these, so we don't switch on the type; -Wswitch-enum
+   * would have us list them all. */
+  static void on_collection_event(GC_EventType const event)
+  {
+    if(event == GC_EVENT_PRE_STOP_WORLD)
+    {
+      pause_start_ns.store(now_ns(), std::memory_order_relaxed);
+    }
+    else if(event == GC_EVENT_POST_START_WORLD)
+    {
+      auto const start(pause_start_ns.load(std::memory_order_relaxed));
+      if(start == 0)
+      {
+        return;
+      }
+      auto const pause(now_ns() - start);
+      pause_count.fetch_add(1, std::memory_order_relaxed);
+      pause_total_ns.fetch_add(pause, std::memory_order_relaxed);
+      auto max(pause_max_ns.load(std::memory_order_relaxed));
+      while(max < pause
+            && !pause_max_ns.compare_exchange_weak(max, pause, std::memory_order_relaxed))
+      {
+      }
+    }
+    else if(event == GC_EVENT_END)
+    {
+      collections.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  void pre_configure(int const argc, char const **argv)
+  {
+    static constexpr native_persistent_string_view flag{ "--gc-markers" };
+
+    for(int i{ 1 }; i < argc; ++i)
+    {
+      native_persistent_string_view const arg{ argv[i] };
+      native_persistent_string_view value;
+      if(arg == flag && i + 1 < argc)
+      {
+        value = argv[i + 1];
+      }
+      else if(arg.starts_with(flag) && arg.size() > flag.size() && arg[flag.size()] == '=')
+      {
+        value = arg.substr(flag.size() + 1);
+      }
+      else
+      {
+        continue;
+      }
+
+      unsigned markers{};
+      auto const res(std::from_chars(value.data(), value.data() + value.size(), markers));
+      if(res.ec == std::errc{} && markers != 0)
+      {
+#if GC_VERSION_MAJOR > 8 || (GC_VERSION_MAJOR == 8 && GC_VERSION_MINOR >= 2)
+        GC_set_markers_count(markers);
+#else
+        /* Older versions of Boehm only read the marker count from GC_MARKERS. */
+        std::fputs("--gc-markers needs Boehm GC 8.2 or newer, so it's being ignored. "
+                   "Set GC_MARKERS instead.\n",
+                   stderr);
+#endif
+      }
+      return;
+    }
+  }
+
+  void configure(util::cli::options const &opts)
+  {
+    GC_set_on_collection_event(on_collection_event);
+
+    if(opts.gc_initial_heap_size > 0)
+    {
+      auto const current(static_cast<native_integer>(GC_get_heap_size()));
+      if(current < opts.gc_initial_heap_size
+         && !GC_expand_hp(static_cast<size_t>(opts.gc_initial_heap_size - current)))
+      {
+        fmt::println(stderr,
+                     "Unable to expand the GC heap to {} bytes.",
+                     opts.gc_initial_heap_size);
+      }
+    }
+
+    if(opts.gc_free_space_divisor > 0)
+    {
+      GC_set_free_space_divisor(static_cast<GC_word>(opts.gc_free_space_divisor));
+    }
+
+    /* A pause target is only meaningful for incremental collection, since a full
+     * collection can't be broken up. */
+    if(opts.gc_incremental || opts.gc_pause_target_ms > 0)
+    {
+      GC_enable_incremental();
+    }
+    if(opts.gc_pause_target_ms > 0)
+    {
+      GC_set_time_limit(static_cast<unsigned long>(opts.gc_pause_target_ms));
+    }
+  }
+
+  stats current_stats()
+  {
+    return {
+      .collections = collections.load(std::memory_order_relaxed),
+      .pause_count = pause_count.load(std::memory_order_relaxed),
+      .pause_total_ns = pause_total_ns.load(std::memory_order_relaxed),
+      .pause_max_ns = pause_max_ns.load(std::memory_order_relaxed),
+      .heap_size = static_cast<native_integer>(GC_get_heap_size()),
+      .free_bytes = static_cast<native_integer>(GC_get_free_bytes()),
+      .bytes_since_gc = static_cast<native_integer>(GC_get_bytes_since_gc()),
+      .total_bytes = static_cast<native_integer>(GC_get_total_bytes()),
+    };
+  }
+
+  void collect()
+  {
+    GC_gcollect();
+  }
+
+  void allow_thread_registration()
+  {
+    /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+    static std::once_flag allowed;
+    std::call_once(allowed, [] { GC_allow_register_threads(); });
+  }
+
+  thread_registration::thread_registration()
+  {
+    GC_stack_base stack_base{};
+    if(GC_get_stack_base(&stack_base) != GC_SUCCESS)
+    {
+      throw std::runtime_error{ "unable to find the stack base of this thread" };
+    }
+    registered = GC_register_my_thread(&stack_base) == GC_SUCCESS;
+  }
+
+  thread_registration::~thread_registration()
+  {
+    if(registered)
+    {
+      GC_unregister_my_thread();
+    }
+  }
+}
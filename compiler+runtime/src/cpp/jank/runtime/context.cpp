@@ -1,4 +1,7 @@
 #include <exception>
+#include <optional>
+
+#include <unistd.h>
 
 #include <llvm/ExecutionEngine/Orc/LLJIT.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
@@ -26,6 +29,7 @@
 #include <jank/util/clang_format.hpp>
 #include <jank/util/dir.hpp>
 #include <jank/codegen/llvm_processor.hpp>
+#include <jank/profile/allocation.hpp>
 #include <jank/profile/time.hpp>
 
 namespace jank::runtime
@@ -44,6 +48,8 @@ namespace jank::runtime
   context::context(util::cli::options const &opts)
     : jit_prc{ opts }
     , binary_cache_dir{ util::binary_cache_dir(opts.optimization_level,
+                                               jit_prc.target_cpu,
+                                               opts.direct_linking,
                                                opts.include_dirs,
                                                opts.define_macros) }
     , module_loader{ *this, opts.module_path }
@@ -75,6 +81,26 @@ namespace jank::runtime
     assert_var->bind_root(obj::boolean::true_const());
     assert_var->dynamic.store(true);
 
+    auto const out_sym(make_box<obj::symbol>("clojure.core/*out*"));
+    out_var = core->intern_var(out_sym);
+    out_var->bind_root(make_box<obj::writer>(STDOUT_FILENO, false));
+    out_var->dynamic.store(true);
+
+    auto const err_sym(make_box<obj::symbol>("clojure.core/*err*"));
+    err_var = core->intern_var(err_sym);
+    err_var->bind_root(make_box<obj::writer>(STDERR_FILENO, true));
+    err_var->dynamic.store(true);
+
+    auto const flush_on_newline_sym(make_box<obj::symbol>("clojure.core/*flush-on-newline*"));
+    flush_on_newline_var = core->intern_var(flush_on_newline_sym);
+    flush_on_newline_var->bind_root(obj::boolean::true_const());
+    flush_on_newline_var->dynamic.store(true);
+
+    auto const agent_sym(make_box<obj::symbol>("clojure.core/*agent*"));
+    agent_var = core->intern_var(agent_sym);
+    agent_var->bind_root(obj::nil::nil_const());
+    agent_var->dynamic.store(true);
+
     /* These are not actually interned. */
     current_module_var
       = make_box<runtime::var>(core, make_box<obj::symbol>("*current-module*"))->set_dynamic(true);
@@ -97,6 +123,12 @@ namespace jank::runtime
 
   context::~context()
   {
+    /* Our vars' slots would otherwise keep their last bindings alive on this thread. */
+    auto const &tbfs(thread_binding_frames[this]);
+    while(!tbfs.empty())
+    {
+      static_cast<void>(pop_thread_bindings());
+    }
     thread_binding_frames.erase(this);
   }
 
@@ -167,20 +199,42 @@ namespace jank::runtime
   object_ptr context::eval_string(native_persistent_string_view const &code)
   {
     profile::timer const timer{ "rt eval_string" };
+    /* The REPL carries on after an exception, so we can't leave the profiler attributing
+     * allocations to whichever function threw. */
+    profile::allocation::function_scope const alloc_fn;
     read::lex::processor l_prc{ code };
     read::parse::processor p_prc{ l_prc.begin(), l_prc.end() };
 
+    /* When compiling, every expression needs to live until the module has been generated,
+     * so the whole file shares one allocation scope. Otherwise, each form is released as soon
+     * as it has been evaluated. */
+    native_bool const compiling{ truthy(compile_files_var->deref()) };
+    std::optional<analyze::allocation_scope> module_allocations;
+    if(compiling)
+    {
+      module_allocations.emplace(an_prc);
+    }
+
     object_ptr ret{ obj::nil::nil_const() };
     native_vector<analyze::expression_ptr> exprs{};
     for(auto const &form : p_prc)
     {
+      std::optional<analyze::allocation_scope> form_allocations;
+      if(!compiling)
+      {
+        form_allocations.emplace(an_prc);
+      }
+
       auto const expr(
         an_prc.analyze(form.expect_ok().unwrap().ptr, analyze::expression_position::statement));
       ret = evaluate::eval(expr.expect_ok());
-      exprs.emplace_back(expr.expect_ok());
+      if(compiling)
+      {
+        exprs.emplace_back(expr.expect_ok());
+      }
     }
 
-    if(truthy(compile_files_var->deref()))
+    if(compiling)
     {
       auto const &module(
         expect_object<runtime::ns>(intern_var("clojure.core", "*ns*").expect_ok()->deref())
@@ -277,6 +331,7 @@ namespace jank::runtime
     }
 
     binding_scope const preserve{ *this };
+    profile::allocation::function_scope const alloc_fn;
 
     try
     {
@@ -307,6 +362,7 @@ namespace jank::runtime
 
   object_ptr context::eval(object_ptr const o)
   {
+    analyze::allocation_scope const allocations{ an_prc };
     auto const expr(an_prc.analyze(o, analyze::expression_position::value));
     return evaluate::eval(expr.expect_ok());
   }
@@ -331,21 +387,9 @@ namespace jank::runtime
     }
     //codegen_ctx->module->print(llvm::outs(), nullptr);
 
-    auto const target_triple{ llvm::sys::getDefaultTargetTriple() };
-    std::string target_error;
-    auto const target{ llvm::TargetRegistry::lookupTarget(target_triple, target_error) };
-    if(!target)
-    {
-      return err(target_error);
-    }
-    llvm::TargetOptions const opt;
-    auto const target_machine{
-      target->createTargetMachine(target_triple, "generic", "", opt, llvm::Reloc::PIC_)
-    };
-    if(!target_machine)
-    {
-      return err(fmt::format("failed to create target machine for {}", target_triple));
-    }
+    /* This is the same target machine our optimization passes were tuned for. */
+    auto const target_machine{ jit_prc.target_machine.get() };
+    auto const target_triple{ target_machine->getTargetTriple().str() };
     llvm::legacy::PassManager pass;
 
     if(target_machine->addPassesToEmitFile(pass, os, nullptr, llvm::CodeGenFileType::ObjectFile))
@@ -471,6 +515,18 @@ namespace jank::runtime
     return expect_object<ns>(find_var("clojure.core", "*ns*").unwrap()->deref());
   }
 
+  void context::flush_output()
+  {
+    for(auto const v : { err_var, out_var })
+    {
+      auto const w(v->deref());
+      if(w->type == object_type::writer)
+      {
+        expect_object<obj::writer>(w)->flush();
+      }
+    }
+  }
+
   result<var_ptr, native_persistent_string>
   context::intern_var(native_persistent_string const &ns, native_persistent_string const &name)
   {
@@ -670,40 +726,42 @@ namespace jank::runtime
   string_result<void> context::push_thread_bindings(obj::persistent_hash_map_ptr const bindings)
   {
     assert(bindings);
-    thread_binding_frame frame{ obj::persistent_hash_map::empty() };
+    thread_binding_frame frame{ obj::persistent_hash_map::empty(), {} };
     auto &tbfs(thread_binding_frames[this]);
     if(!tbfs.empty())
     {
       frame.bindings = tbfs.front().bindings;
     }
 
-    auto const thread_id(std::this_thread::get_id());
-
+    /* We check everything first, so that a failed push doesn't leave any slots changed. */
     for(auto it(bindings->fresh_seq()); it != nullptr; it = runtime::next_in_place(it))
     {
-      auto const entry(it->first());
-      auto const var(expect_object<var>(entry->data[0]));
+      auto const var(expect_object<runtime::var>(it->first()->data[0]));
       if(!var->dynamic.load())
       {
         return err(fmt::format("Can't dynamically bind non-dynamic var: {}", var->to_string()));
       }
-      /* TODO: Where is this unset? */
-      var->thread_bound.store(true);
+    }
+
+    auto const thread_id(std::this_thread::get_id());
+
+    for(auto it(bindings->fresh_seq()); it != nullptr; it = runtime::next_in_place(it))
+    {
+      auto const entry(it->first());
+      auto const var(expect_object<runtime::var>(entry->data[0]));
 
       /* The binding may already be a thread binding if we're just pushing the previous
-       * bindings again to give a scratch pad for some upcoming code. */
-      if(entry->data[1]->type == object_type::var_thread_binding)
+       * bindings again to give a scratch pad for some upcoming code, or if the bindings
+       * were conveyed from another thread. */
+      auto value(entry->data[1]);
+      if(value->type == object_type::var_thread_binding)
       {
-        frame.bindings = frame.bindings->assoc(
-          var,
-          make_box<var_thread_binding>(expect_object<var_thread_binding>(entry->data[1])->value,
-                                       thread_id));
-      }
-      else
-      {
-        frame.bindings
-          = frame.bindings->assoc(var, make_box<var_thread_binding>(entry->data[1], thread_id));
+        value = expect_object<var_thread_binding>(value)->value;
       }
+
+      auto const binding(make_box<var_thread_binding>(value, thread_id));
+      frame.bindings = frame.bindings->assoc(var, binding);
+      frame.previous_bindings.emplace_back(var, var->swap_thread_binding(binding));
     }
 
     assert(frame.bindings);
@@ -719,6 +777,10 @@ namespace jank::runtime
       return err("Mismatched thread binding pop");
     }
 
+    for(auto const &previous : tbfs.front().previous_bindings)
+    {
+      previous.first->swap_thread_binding(previous.second);
+    }
     tbfs.pop_front();
 
     return ok();
@@ -6,6 +6,7 @@
 #include <jank/runtime/behavior/comparable.hpp>
 #include <jank/runtime/behavior/nameable.hpp>
 #include <jank/runtime/behavior/derefable.hpp>
+#include <jank/runtime/behavior/realizable.hpp>
 #include <jank/runtime/context.hpp>
 
 namespace jank::runtime
@@ -48,9 +49,13 @@ namespace jank::runtime
     return lhs == rhs;
   }
 
-  native_persistent_string type(object_ptr const o)
+  object_ptr type(object_ptr const o)
   {
-    return object_type_str(o->type);
+    if(o->type == object_type::record)
+    {
+      return expect_object<obj::record>(o)->type;
+    }
+    return make_box(object_type_str(o->type));
   }
 
   native_bool is_nil(object_ptr const o)
@@ -98,124 +103,119 @@ namespace jank::runtime
     return o->type == object_type::symbol && !expect_object<obj::symbol>(o)->ns.empty();
   }
 
-  object_ptr print(object_ptr const args)
+  static obj::writer_ptr current_out()
   {
-    visit_object(
-      [](auto const typed_args) {
-        using T = typename decltype(typed_args)::value_type;
+    return try_object<obj::writer>(__rt_ctx->out_var->deref());
+  }
 
-        if constexpr(behavior::sequenceable<T>)
-        {
-          util::string_builder buff;
-          runtime::to_string(typed_args->first(), buff);
-          for(auto it(next_in_place(typed_args)); it != nullptr; it = next_in_place(it))
-          {
-            buff(' ');
-            runtime::to_string(it->first(), buff);
-          }
-          std::fwrite(buff.data(), 1, buff.size(), stdout);
-        }
-        else
-        {
-          throw std::runtime_error{ fmt::format("expected a sequence: {}",
-                                                typed_args->to_string()) };
-        }
-      },
-      args);
-    return obj::nil::nil_const();
+  static void write_newline(obj::writer_ptr const out)
+  {
+    out->buffer('\n');
+    if(truthy(__rt_ctx->flush_on_newline_var->deref()))
+    {
+      out->flush();
+    }
+    else
+    {
+      out->wrote();
+    }
   }
 
-  object_ptr println(object_ptr const args)
+  /* Each arg is streamed straight into *out*, rather than building up the whole string
+   * first. The writer stays locked until we're done, so concurrent prints don't interleave. */
+  template <typename F>
+  static object_ptr write_out(object_ptr const args, native_bool const newline, F const &write_one)
   {
+    auto const out(current_out());
+    std::lock_guard<std::recursive_mutex> const lock{ out->mutex };
+
     visit_object(
-      [](auto const typed_more) {
-        using T = typename decltype(typed_more)::value_type;
+      [&](auto const typed_args) {
+        using T = typename decltype(typed_args)::value_type;
 
         if constexpr(std::same_as<T, obj::nil>)
         {
-          std::putc('\n', stdout);
         }
         else if constexpr(behavior::sequenceable<T>)
         {
-          util::string_builder buff;
-          runtime::to_string(typed_more->first(), buff);
-          for(auto it(next_in_place(typed_more)); it != nullptr; it = next_in_place(it))
+          write_one(typed_args->first(), out->buffer);
+          for(auto it(next_in_place(typed_args)); it != nullptr; it = next_in_place(it))
           {
-            buff(' ');
-            runtime::to_string(it->first(), buff);
+            out->buffer(' ');
+            write_one(it->first(), out->buffer);
           }
-          std::fwrite(buff.data(), 1, buff.size(), stdout);
-          std::putc('\n', stdout);
         }
         else
         {
           throw std::runtime_error{ fmt::format("expected a sequence: {}",
-                                                typed_more->to_string()) };
+                                                typed_args->to_string()) };
         }
       },
       args);
+
+    if(newline)
+    {
+      write_newline(out);
+    }
+    else
+    {
+      out->wrote();
+    }
     return obj::nil::nil_const();
   }
 
-  object_ptr pr(object_ptr const args)
+  object_ptr print(object_ptr const args)
   {
-    visit_object(
-      [](auto const typed_args) {
-        using T = typename decltype(typed_args)::value_type;
+    return write_out(args, false, [](object_ptr const o, util::string_builder &buff) {
+      runtime::to_string(o, buff);
+    });
+  }
 
-        if constexpr(behavior::sequenceable<T>)
-        {
-          util::string_builder buff;
-          runtime::to_code_string(typed_args->first(), buff);
-          for(auto it(next_in_place(typed_args)); it != nullptr; it = next_in_place(it))
-          {
-            buff(' ');
-            runtime::to_code_string(it->first(), buff);
-          }
-          std::fwrite(buff.data(), 1, buff.size(), stdout);
-        }
-        else
-        {
-          throw std::runtime_error{ fmt::format("expected a sequence: {}",
-                                                typed_args->to_string()) };
-        }
-      },
-      args);
-    return obj::nil::nil_const();
+  object_ptr println(object_ptr const args)
+  {
+    return write_out(args, true, [](object_ptr const o, util::string_builder &buff) {
+      runtime::to_string(o, buff);
+    });
+  }
+
+  object_ptr pr(object_ptr const args)
+  {
+    return write_out(args, false, [](object_ptr const o, util::string_builder &buff) {
+      runtime::to_code_string(o, buff);
+    });
   }
 
   object_ptr prn(object_ptr const args)
   {
-    visit_object(
-      [](auto const typed_more) {
-        using T = typename decltype(typed_more)::value_type;
+    return write_out(args, true, [](object_ptr const o, util::string_builder &buff) {
+      runtime::to_code_string(o, buff);
+    });
+  }
 
-        if constexpr(std::same_as<T, obj::nil>)
-        {
-          std::putc('\n', stdout);
-        }
-        else if constexpr(behavior::sequenceable<T>)
-        {
-          util::string_builder buff;
-          runtime::to_code_string(typed_more->first(), buff);
-          for(auto it(next_in_place(typed_more)); it != nullptr; it = next_in_place(it))
-          {
-            buff(' ');
-            runtime::to_code_string(it->first(), buff);
-          }
-          std::fwrite(buff.data(), 1, buff.size(), stdout);
-          std::putc('\n', stdout);
-        }
-        else
-        {
-          throw std::runtime_error{ fmt::format("expected a sequence: {}",
-                                                typed_more->to_string()) };
-        }
-      },
-      args);
+  object_ptr newline()
+  {
+    auto const out(current_out());
+    std::lock_guard<std::recursive_mutex> const lock{ out->mutex };
+    write_newline(out);
     return obj::nil::nil_const();
   }
 
+  object_ptr flush(object_ptr const writer)
+  {
+    try_object<obj::writer>(writer)->flush();
+    return obj::nil::nil_const();
+  }
+
+  object_ptr string_writer()
+  {
+    return make_box<obj::writer>();
+  }
+
+  native_bool is_writer(object_ptr const o)
+  {
+    return o->type == object_type::writer;
+  }
+
   native_real to_real(object_ptr const o)
   {
     return visit_number_like(
@@ -483,6 +483,44 @@ namespace jank::runtime
       o);
   }
 
+  object_ptr
+  blocking_deref(object_ptr const o, object_ptr const timeout_ms, object_ptr const timeout_val)
+  {
+    return visit_object(
+      [=](auto const typed_o) -> object_ptr {
+        using T = typename decltype(typed_o)::value_type;
+
+        if constexpr(behavior::blocking_derefable<T>)
+        {
+          return typed_o->deref(to_int(timeout_ms), timeout_val);
+        }
+        else
+        {
+          throw std::runtime_error{ fmt::format("not blocking derefable: {}",
+                                                typed_o->to_string()) };
+        }
+      },
+      o);
+  }
+
+  native_bool is_realized(object_ptr const o)
+  {
+    return visit_object(
+      [=](auto const typed_o) -> native_bool {
+        using T = typename decltype(typed_o)::value_type;
+
+        if constexpr(behavior::realizable<T>)
+        {
+          return typed_o->is_realized();
+        }
+        else
+        {
+          throw std::runtime_error{ fmt::format("not realizable: {}", typed_o->to_string()) };
+        }
+      },
+      o);
+  }
+
   object_ptr volatile_(object_ptr const o)
   {
     return make_box<obj::volatile_>(o);
@@ -510,6 +548,22 @@ namespace jank::runtime
     return try_object<obj::volatile_>(v)->reset(new_val);
   }
 
+  object_ptr promise()
+  {
+    return make_box<obj::promise>();
+  }
+
+  /* Like Clojure, this returns the promise only if this was the first delivery. */
+  object_ptr deliver(object_ptr const p, object_ptr const val)
+  {
+    auto const typed_p(try_object<obj::promise>(p));
+    if(typed_p->deliver(val))
+    {
+      return typed_p;
+    }
+    return obj::nil::nil_const();
+  }
+
   void push_thread_bindings(object_ptr const o)
   {
     __rt_ctx->push_thread_bindings(o).expect_ok();
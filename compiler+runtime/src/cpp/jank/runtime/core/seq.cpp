@@ -1,5 +1,7 @@
 #include <algorithm>
+#include <numeric>
 #include <random>
+#include <thread>
 #include <fmt/core.h>
 
 #include <jank/native_persistent_string/fmt.hpp>
@@ -105,7 +107,8 @@ namespace jank::runtime
   {
     return (o->type == object_type::persistent_hash_map
             || o->type == object_type::persistent_array_map
-            || o->type == object_type::persistent_sorted_map);
+            || o->type == object_type::persistent_sorted_map
+            || (o->type == object_type::record && expect_object<obj::record>(o)->type->is_record));
   }
 
   native_bool is_associative(object_ptr const o)
@@ -724,8 +727,7 @@ namespace jank::runtime
               if constexpr(std::same_as<O, obj::persistent_hash_map>
                            || std::same_as<O, obj::persistent_array_map>
                            || std::same_as<O, obj::transient_hash_map>
-                           //|| std::same_as<O, obj::transient_array_map>
-              )
+                           || std::same_as<O, obj::transient_array_map>)
               {
                 object_ptr ret{ typed_m };
                 for(auto const &pair : typed_other->data)
@@ -1162,19 +1164,199 @@ namespace jank::runtime
     return obj::repeat::create(n, val);
   }
 
-  object_ptr sort(object_ptr const coll)
+  /* Sorts with fewer elements than this, per thread, aren't worth splitting up. */
+  static constexpr size_t parallel_sort_grain{ 1 << 16 };
+
+  /* A stable sort which sorts runs on their own threads and then merges adjacent runs, also in
+   * parallel, until one is left. The worker threads aren't registered with the GC, so this is
+   * only used for native keys, which can be compared without touching the runtime. */
+  template <typename It, typename Less>
+  static void parallel_stable_sort(It const begin, It const end, Less const &less)
+  {
+    auto const size(static_cast<size_t>(end - begin));
+    auto const run_count(std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u),
+                                           size / parallel_sort_grain));
+    if(run_count < 2)
+    {
+      std::stable_sort(begin, end, less);
+      return;
+    }
+
+    std::vector<It> bounds;
+    bounds.reserve(run_count + 1);
+    for(size_t i{}; i <= run_count; ++i)
+    {
+      bounds.emplace_back(begin + static_cast<ptrdiff_t>(size * i / run_count));
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(run_count);
+    for(size_t i{}; i < run_count; ++i)
+    {
+      workers.emplace_back([&, i] { std::stable_sort(bounds[i], bounds[i + 1], less); });
+    }
+    for(auto &worker : workers)
+    {
+      worker.join();
+    }
+
+    for(size_t width{ 1 }; width < run_count; width *= 2)
+    {
+      workers.clear();
+      for(size_t i{}; i + width < run_count; i += width * 2)
+      {
+        auto const last(std::min(i + width * 2, run_count));
+        workers.emplace_back([&, i, width, last] {
+          std::inplace_merge(bounds[i], bounds[i + width], bounds[last], less);
+        });
+      }
+      for(auto &worker : workers)
+      {
+        worker.join();
+      }
+    }
+  }
+
+  /* Sorting moves indices around, rather than objects, so nothing reachable only from the
+   * sort's scratch memory can be collected out from under it. */
+  template <typename F>
+  static std::vector<size_t>
+  order_by_native_key(native_vector<object_ptr> const &keys, F const &key)
+  {
+    using K = std::invoke_result_t<F, object_ptr>;
+
+    std::vector<std::pair<K, size_t>> keyed;
+    keyed.reserve(keys.size());
+    for(size_t i{}; i < keys.size(); ++i)
+    {
+      keyed.emplace_back(key(keys[i]), i);
+    }
+
+    parallel_stable_sort(keyed.begin(), keyed.end(), [](auto const &l, auto const &r) {
+      return l.first < r.first;
+    });
+
+    std::vector<size_t> order;
+    order.reserve(keyed.size());
+    for(auto const &k : keyed)
+    {
+      order.emplace_back(k.second);
+    }
+    return order;
+  }
+
+  /* When every key has the same type, and it's one of the common comparable types, we can
+   * extract native keys once and skip the double dispatch of runtime::compare entirely. */
+  static option<std::vector<size_t>> order_homogeneous(native_vector<object_ptr> const &keys)
+  {
+    if(keys.empty())
+    {
+      return none;
+    }
+
+    auto const type(keys[0]->type);
+    if(!std::ranges::all_of(keys, [=](object_ptr const o) { return o->type == type; }))
+    {
+      return none;
+    }
+
+    switch(type)
+    {
+      case object_type::integer:
+        return order_by_native_key(keys, [](object_ptr const o) {
+          return expect_object<obj::integer>(o)->data;
+        });
+      case object_type::real:
+        return order_by_native_key(keys, [](object_ptr const o) {
+          return expect_object<obj::real>(o)->data;
+        });
+      case object_type::persistent_string:
+        return order_by_native_key(keys, [](object_ptr const o) {
+          return static_cast<native_persistent_string_view>(
+            expect_object<obj::persistent_string>(o)->data);
+        });
+      case object_type::keyword:
+        /* Matches symbol::compare, where symbols without a namespace come first. */
+        return order_by_native_key(keys, [](object_ptr const o) {
+          auto const sym(expect_object<obj::keyword>(o)->sym);
+          return std::make_pair(static_cast<native_persistent_string_view>(sym->ns),
+                                static_cast<native_persistent_string_view>(sym->name));
+        });
+      default:
+        return none;
+    }
+  }
+
+  /* Comparators can be fns returning a number, like compare, or predicates like <. */
+  static native_integer
+  call_comparator(object_ptr const comp, object_ptr const l, object_ptr const r)
+  {
+    auto const ret(dynamic_call(comp, l, r));
+    if(ret->type == object_type::boolean)
+    {
+      if(truthy(ret))
+      {
+        return -1;
+      }
+      return truthy(dynamic_call(comp, r, l)) ? 1 : 0;
+    }
+    return to_int(ret);
+  }
+
+  /* Both sort and sort-by land here. Keys are computed once per item, up front, and the
+   * items are reordered by the sorted order of their keys. A nil keyfn means the items are
+   * their own keys and a nil comp means runtime::compare. */
+  static object_ptr sort_impl(object_ptr const keyfn, object_ptr const comp, object_ptr const coll)
   {
     return visit_seqable(
-      [](auto const typed_coll) -> object_ptr {
-        native_vector<object_ptr> vec;
+      [=](auto const typed_coll) -> object_ptr {
+        native_vector<object_ptr> items;
         for(auto it(typed_coll->fresh_seq()); it != nullptr; it = it->next_in_place())
         {
-          vec.push_back(it->first());
+          items.push_back(it->first());
         }
 
-        std::stable_sort(vec.begin(), vec.end(), [](object_ptr const a, object_ptr const b) {
-          return runtime::compare(a, b) < 0;
-        });
+        native_vector<object_ptr> keys;
+        if(keyfn != nullptr)
+        {
+          keys.reserve(items.size());
+          for(auto const item : items)
+          {
+            keys.push_back(dynamic_call(keyfn, item));
+          }
+        }
+        auto const &sort_keys(keyfn != nullptr ? keys : items);
+
+        option<std::vector<size_t>> order;
+        if(comp == nullptr)
+        {
+          order = order_homogeneous(sort_keys);
+        }
+        if(order.is_none())
+        {
+          std::vector<size_t> indices(items.size());
+          std::iota(indices.begin(), indices.end(), 0);
+          if(comp == nullptr)
+          {
+            std::stable_sort(indices.begin(), indices.end(), [&](size_t const l, size_t const r) {
+              return runtime::compare(sort_keys[l], sort_keys[r]) < 0;
+            });
+          }
+          else
+          {
+            std::stable_sort(indices.begin(), indices.end(), [&](size_t const l, size_t const r) {
+              return call_comparator(comp, sort_keys[l], sort_keys[r]) < 0;
+            });
+          }
+          order = std::move(indices);
+        }
+
+        native_vector<object_ptr> vec;
+        vec.reserve(items.size());
+        for(auto const i : order.unwrap())
+        {
+          vec.push_back(items[i]);
+        }
 
         using T = typename decltype(typed_coll)::value_type;
 
@@ -1190,6 +1372,26 @@ namespace jank::runtime
       coll);
   }
 
+  object_ptr sort(object_ptr const coll)
+  {
+    return sort_impl(nullptr, nullptr, coll);
+  }
+
+  object_ptr sort(object_ptr const comp, object_ptr const coll)
+  {
+    return sort_impl(nullptr, comp, coll);
+  }
+
+  object_ptr sort_by(object_ptr const keyfn, object_ptr const coll)
+  {
+    return sort_impl(keyfn, nullptr, coll);
+  }
+
+  object_ptr sort_by(object_ptr const keyfn, object_ptr const comp, object_ptr const coll)
+  {
+    return sort_impl(keyfn, comp, coll);
+  }
+
   object_ptr shuffle(object_ptr const coll)
   {
     return visit_seqable(
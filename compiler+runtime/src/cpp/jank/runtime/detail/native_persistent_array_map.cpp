@@ -1,3 +1,9 @@
+#include <bit>
+
+#if defined(__x86_64__)
+  #include <immintrin.h>
+#endif
+
 #include <fmt/format.h>
 
 #include <jank/runtime/detail/native_persistent_array_map.hpp>
@@ -117,96 +123,123 @@ namespace jank::runtime::detail
 
   void native_persistent_array_map::insert_or_assign(object_ptr const key, object_ptr const val)
   {
-    if(key->type == runtime::object_type::keyword)
+    auto const i(index_of(key));
+    if(i < length)
     {
-      for(size_t i{}; i < length; i += 2)
-      {
-        if(data[i] == key)
-        {
-          data[i + 1] = val;
-          hash = 0;
-          return;
-        }
-      }
+      data[i + 1] = val;
+      hash = 0;
+      return;
     }
-    else
+    insert_unique(key, val);
+  }
+
+  static size_t index_of_identical_scalar(object_ptr const * const data,
+                                          size_t const length,
+                                          object_ptr const key)
+  {
+    for(size_t i{}; i < length; i += 2)
     {
-      for(size_t i{}; i < length; i += 2)
+      if(data[i] == key)
       {
-        if(runtime::equal(data[i], key))
-        {
-          data[i + 1] = val;
-          hash = 0;
-          return;
-        }
+        return i;
       }
     }
-    insert_unique(key, val);
+    return length;
   }
 
-  object_ptr native_persistent_array_map::find(object_ptr const key) const
+#if defined(__x86_64__)
+  /* Compares four slots at a time, which is two key/value pairs, so only the even lanes
+   * are keys. A full map of eight pairs is four compares. */
+  __attribute__((target("avx2"))) static size_t
+  index_of_identical_avx2(object_ptr const * const data, size_t const length, object_ptr const key)
   {
-    if(key->type == runtime::object_type::keyword)
+    auto const needle(
+      _mm256_set1_epi64x(static_cast<long long>(reinterpret_cast<uintptr_t>(key.data))));
+    size_t i{};
+    for(; i + 4 <= length; i += 4)
     {
-      for(size_t i{}; i < length; i += 2)
+      /* NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast) */
+      auto const slots(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(data + i)));
+      auto const matches(
+        _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(slots, needle))) & 0b0101);
+      if(matches != 0)
       {
-        if(data[i] == key)
-        {
-          return data[i + 1];
-        }
+        return i + static_cast<size_t>(std::countr_zero(static_cast<unsigned>(matches)));
       }
     }
-    else
+    /* There can be one pair left over. */
+    if(i < length && data[i] == key)
     {
-      for(size_t i{}; i < length; i += 2)
+      return i;
+    }
+    return length;
+  }
+
+  static native_bool const has_avx2{ []() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+  }() };
+#endif
+
+  /* Finds the slot holding this exact key object, without considering equality. */
+  static size_t
+  index_of_identical(object_ptr const * const data, size_t const length, object_ptr const key)
+  {
+#if defined(__x86_64__)
+    if(has_avx2)
+    {
+      return index_of_identical_avx2(data, length, key);
+    }
+#endif
+    return index_of_identical_scalar(data, length, key);
+  }
+
+  size_t native_persistent_array_map::index_of(object_ptr const key) const
+  {
+    /* Most keys are keywords, which are interned, so identity is all we need to check for
+     * them. For everything else, an identical key is still equal, so we try that first. */
+    auto const identical(index_of_identical(data, length, key));
+    if(identical < length || key->type == runtime::object_type::keyword)
+    {
+      return identical;
+    }
+
+    for(size_t i{}; i < length; i += 2)
+    {
+      if(runtime::equal(data[i], key))
       {
-        if(runtime::equal(data[i], key))
-        {
-          return data[i + 1];
-        }
+        return i;
       }
     }
+    return length;
+  }
+
+  object_ptr native_persistent_array_map::find(object_ptr const key) const
+  {
+    auto const i(index_of(key));
+    if(i < length)
+    {
+      return data[i + 1];
+    }
     return nullptr;
   }
 
   void native_persistent_array_map::erase(object_ptr const key)
   {
-    if(key->type == runtime::object_type::keyword)
+    auto const i(index_of(key));
+    if(i == length)
     {
-      for(size_t i{}; i < length; i += 2)
-      {
-        if(data[i] == key)
-        {
-          for(size_t k{ i + 2 }; k < length; k += 2)
-          {
-            data[k - 2] = data[k];
-            data[k - 1] = data[k + 1];
-          }
-
-          length -= 2;
-          hash = 0;
-          return;
-        }
-      }
+      return;
     }
-    else
-    {
-      for(size_t i{}; i < length; i += 2)
-      {
-        if(runtime::equal(data[i], key))
-        {
-          for(size_t k{ i + 2 }; k < length; k += 2)
-          {
-            data[k - 2] = data[k];
-            data[k - 1] = data[k + 1];
-          }
 
-          length -= 2;
-          hash = 0;
-          return;
-        }
-      }
+    for(size_t k{ i + 2 }; k < length; k += 2)
+    {
+      data[k - 2] = data[k];
+      data[k - 1] = data[k + 1];
     }
+
+    length -= 2;
+    hash = 0;
   }
 
   native_hash native_persistent_array_map::to_hash() const
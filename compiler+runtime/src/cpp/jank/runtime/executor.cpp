@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+#include <jank/runtime/executor.hpp>
+#include <jank/runtime/collector.hpp>
+#include <jank/profile/allocation.hpp>
+
+namespace jank::runtime
+{
+  executor::executor(size_t const core_threads,
+                     size_t const max_threads,
+                     std::chrono::milliseconds const keep_alive)
+    : core_threads{ core_threads }
+    , max_threads{ std::max(core_threads, max_threads) }
+    , keep_alive{ keep_alive }
+  {
+  }
+
+  native_bool executor::submit(task * const t)
+  {
+    {
+      std::lock_guard<std::mutex> const locked{ lock };
+      if(shutting_down)
+      {
+        return false;
+      }
+
+      queue.push_back(t);
+      if(idle_count < queue.size() && thread_count < max_threads)
+      {
+        start_thread();
+      }
+    }
+    ready.notify_one();
+    return true;
+  }
+
+  void executor::shutdown()
+  {
+    {
+      std::lock_guard<std::mutex> const locked{ lock };
+      shutting_down = true;
+    }
+    ready.notify_all();
+  }
+
+  native_bool executor::is_shutdown()
+  {
+    std::lock_guard<std::mutex> const locked{ lock };
+    return shutting_down;
+  }
+
+  /* Must be called with the lock held. */
+  void executor::start_thread()
+  {
+    /* The submitting thread is registered, since it has a task in hand, so it's allowed
+     * to do this. */
+    collector::allow_thread_registration();
+    std::thread{ [this] { work(); } }.detach();
+    ++thread_count;
+  }
+
+  void executor::work()
+  {
+    collector::thread_registration const registration;
+
+    std::unique_lock<std::mutex> locked{ lock };
+    while(true)
+    {
+      auto const has_work([&] { return shutting_down || !queue.empty(); });
+
+      ++idle_count;
+      if(thread_count > core_threads)
+      {
+        ready.wait_for(locked, keep_alive, has_work);
+      }
+      else
+      {
+        ready.wait(locked, has_work);
+      }
+      --idle_count;
+
+      /* Either we've been idle for too long, or we're shutting down and everything
+       * queued has already been taken. */
+      if(queue.empty())
+      {
+        --thread_count;
+        return;
+      }
+
+      auto const t(queue.front());
+      queue.pop_front();
+      locked.unlock();
+
+      try
+      {
+        profile::allocation::function_scope const alloc_fn;
+        t->run();
+      }
+      catch(...)
+      {
+        /* A task which throws mustn't take its thread down with it. */
+      }
+
+      locked.lock();
+    }
+  }
+
+  executor &executor::pooled()
+  {
+    /* Like Clojure, we allow a couple of extra threads, so cores don't sit idle while
+     * a thread waits on a lock. */
+    static auto const size(std::max(std::thread::hardware_concurrency(), 1u) + 2);
+    static auto const pool(new executor{ size, size, std::chrono::milliseconds::zero() });
+    return *pool;
+  }
+
+  executor &executor::solo()
+  {
+    static auto const pool(new executor{ 0,
+                                         std::numeric_limits<size_t>::max(),
+                                         std::chrono::seconds{ 60 } });
+    return *pool;
+  }
+}
@@ -0,0 +1,439 @@
+#include <condition_variable>
+
+#include <fmt/format.h>
+
+#include <jank/runtime/obj/agent.hpp>
+#include <jank/runtime/obj/keyword.hpp>
+#include <jank/runtime/obj/persistent_hash_map.hpp>
+#include <jank/runtime/behavior/callable.hpp>
+#include <jank/runtime/behavior/metadatable.hpp>
+#include <jank/runtime/executor.hpp>
+#include <jank/runtime/context.hpp>
+#include <jank/runtime/visit.hpp>
+#include <jank/runtime/core.hpp>
+#include <jank/util/scope_exit.hpp>
+#include <jank/profile/allocation.hpp>
+
+namespace jank::runtime::obj
+{
+  struct agent::latch : gc
+  {
+    void count_down()
+    {
+      {
+        std::lock_guard<std::mutex> const locked{ lock };
+        --remaining;
+      }
+      done.notify_all();
+    }
+
+    std::mutex lock;
+    std::condition_variable done;
+    size_t remaining{};
+  };
+
+  /* Runs a batch of one agent's actions on one of an executor's threads. */
+  struct agent_batch : executor::task
+  {
+    agent_batch(agent * const a, executor * const exec)
+      : a{ a }
+      , exec{ exec }
+    {
+    }
+
+    void run() override
+    {
+      a->run_batch(*exec);
+    }
+
+    agent *a{};
+    executor *exec{};
+  };
+
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static thread_local agent *running_agent{};
+
+  /* The sends held back by the running action. The vector lives on the stack of the
+   * thread running the action, so the GC can see what's in it. */
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static thread_local native_vector<std::pair<agent *, agent::action *>> *pending_sends{};
+
+  agent::agent(object_ptr const state)
+    : state{ state }
+  {
+  }
+
+  native_bool agent::equal(object const &o) const
+  {
+    return &o == &base;
+  }
+
+  native_persistent_string agent::to_string() const
+  {
+    util::string_builder buff;
+    to_string(buff);
+    return buff.release();
+  }
+
+  void agent::to_string(util::string_builder &buff) const
+  {
+    fmt::format_to(std::back_inserter(buff), "{}@{}", object_type_str(base.type), fmt::ptr(&base));
+  }
+
+  native_persistent_string agent::to_code_string() const
+  {
+    return to_string();
+  }
+
+  native_hash agent::to_hash() const
+  {
+    return static_cast<native_hash>(reinterpret_cast<uintptr_t>(this));
+  }
+
+  object_ptr agent::deref() const
+  {
+    return state.load();
+  }
+
+  agent_ptr agent::with_meta(object_ptr const m)
+  {
+    meta = behavior::detail::validate_meta(m);
+    return this;
+  }
+
+  agent_ptr agent::dispatch(object_ptr const fn, object_ptr const args, executor &exec)
+  {
+    auto const a(new(GC) action{});
+    a->fn = fn;
+    a->args = args;
+    a->bindings = __rt_ctx->get_thread_bindings();
+    a->exec = &exec;
+    return dispatch(a);
+  }
+
+  agent_ptr agent::dispatch(action * const a)
+  {
+    auto const e(error.load());
+    if(e)
+    {
+      throw std::runtime_error{ fmt::format("Agent is failed, needs restart: {}",
+                                            runtime::to_string(e)) };
+    }
+
+    if(pending_sends)
+    {
+      pending_sends->emplace_back(this, a);
+      return this;
+    }
+
+    enqueue(a);
+    return this;
+  }
+
+  void agent::enqueue(action * const a)
+  {
+    native_bool needs_schedule{};
+    {
+      std::lock_guard<std::mutex> const locked{ queue_lock };
+      queue.push_back(a);
+      if(!scheduled && !error.load())
+      {
+        scheduled = needs_schedule = true;
+      }
+    }
+
+    if(needs_schedule && !schedule(*a->exec))
+    {
+      throw std::runtime_error{ "Agent actions can't be sent after shutdown-agents" };
+    }
+  }
+
+  native_bool agent::schedule(executor &exec)
+  {
+    if(exec.submit(new(GC) agent_batch{ this, &exec }))
+    {
+      return true;
+    }
+
+    std::lock_guard<std::mutex> const locked{ queue_lock };
+    scheduled = false;
+    return false;
+  }
+
+  void agent::run_batch(executor &exec)
+  {
+    running_agent = this;
+    util::scope_exit const reset{ [] { running_agent = nullptr; } };
+
+    for(size_t i{};; ++i)
+    {
+      action *a{};
+      executor *next{};
+      {
+        std::lock_guard<std::mutex> const locked{ queue_lock };
+        if(queue.empty() || error.load())
+        {
+          scheduled = false;
+          return;
+        }
+
+        /* Each action runs on the executor it was sent to, so blocking actions never tie
+         * up the pooled threads. After a full batch, we go to the back of the line. */
+        a = queue.front();
+        if(a->exec != &exec || i == max_batch_size)
+        {
+          next = a->exec;
+        }
+        else
+        {
+          queue.pop_front();
+        }
+      }
+
+      if(next)
+      {
+        schedule(*next);
+        return;
+      }
+      run_action(a);
+    }
+  }
+
+  void agent::run_action(action * const a)
+  {
+    if(a->done)
+    {
+      a->done->count_down();
+      return;
+    }
+
+    native_vector<std::pair<agent *, action *>> held;
+    pending_sends = &held;
+    util::scope_exit const release{ [] { pending_sends = nullptr; } };
+
+    object_ptr failure{};
+    try
+    {
+      profile::allocation::function_scope const alloc_fn;
+      context::binding_scope const bindings{ *__rt_ctx,
+                                             a->bindings->assoc(__rt_ctx->agent_var, this) };
+      auto const next(apply_to(a->fn, make_box<obj::cons>(state.load(), a->args)));
+      validate(next);
+      state.store(next);
+    }
+    catch(std::exception const &e)
+    {
+      failure = make_box(e.what());
+    }
+    catch(object_ptr const e)
+    {
+      failure = e;
+    }
+    catch(...)
+    {
+      failure = make_box("unknown error in agent action");
+    }
+
+    pending_sends = nullptr;
+    if(failure)
+    {
+      /* Sends from a failed action are dropped, as if it never ran. */
+      handle_error(failure);
+      return;
+    }
+
+    for(auto const &send : held)
+    {
+      send.first->enqueue(send.second);
+    }
+  }
+
+  void agent::handle_error(object_ptr const e)
+  {
+    if(mode.load() == error_mode::fail)
+    {
+      error.store(e);
+    }
+
+    auto const handler(error_handler.load());
+    if(handler)
+    {
+      try
+      {
+        dynamic_call(handler, this, e);
+      }
+      catch(...)
+      {
+        /* Like Clojure, errors from the handler are ignored. */
+      }
+    }
+  }
+
+  void agent::validate(object_ptr const s) const
+  {
+    auto const v(validator.load());
+    if(v && !truthy(dynamic_call(v, s)))
+    {
+      throw std::runtime_error{ "Invalid reference state" };
+    }
+  }
+
+  object_ptr agent::restart(object_ptr const new_state, native_bool const clear_actions)
+  {
+    if(!error.load())
+    {
+      throw std::runtime_error{ "Agent does not need a restart" };
+    }
+    validate(new_state);
+    state.store(new_state);
+
+    executor *next{};
+    {
+      std::lock_guard<std::mutex> const locked{ queue_lock };
+      if(clear_actions)
+      {
+        queue.clear();
+      }
+      error.store(nullptr);
+      if(!queue.empty() && !scheduled)
+      {
+        scheduled = true;
+        next = queue.front()->exec;
+      }
+    }
+
+    if(next)
+    {
+      schedule(*next);
+    }
+    return new_state;
+  }
+
+  void agent::set_validator(object_ptr const fn)
+  {
+    if(fn == nil::nil_const())
+    {
+      validator.store(nullptr);
+      return;
+    }
+
+    if(!truthy(dynamic_call(fn, state.load())))
+    {
+      throw std::runtime_error{ "Invalid reference state" };
+    }
+    validator.store(fn);
+  }
+
+  object_ptr agent::get_validator() const
+  {
+    auto const v(validator.load());
+    return v ? v : nil::nil_const();
+  }
+
+  void agent::set_error_handler(object_ptr const fn)
+  {
+    error_handler.store(fn == nil::nil_const() ? nullptr : fn.data);
+  }
+
+  object_ptr agent::get_error_handler() const
+  {
+    auto const handler(error_handler.load());
+    return handler ? handler : nil::nil_const();
+  }
+
+  void agent::set_error_mode(object_ptr const m)
+  {
+    auto const kw(try_object<keyword>(m));
+    if(kw->sym->ns.empty() && kw->sym->name == "fail")
+    {
+      mode.store(error_mode::fail);
+    }
+    else if(kw->sym->ns.empty() && kw->sym->name == "continue")
+    {
+      mode.store(error_mode::continue_);
+    }
+    else
+    {
+      throw std::runtime_error{ fmt::format("Invalid agent error mode: {}",
+                                            runtime::to_code_string(m)) };
+    }
+  }
+
+  object_ptr agent::get_error_mode() const
+  {
+    return __rt_ctx->intern_keyword(mode.load() == error_mode::fail ? "fail" : "continue")
+      .expect_ok();
+  }
+
+  object_ptr agent::get_error() const
+  {
+    auto const e(error.load());
+    return e ? e : nil::nil_const();
+  }
+
+  size_t agent::queue_count()
+  {
+    std::lock_guard<std::mutex> const locked{ queue_lock };
+    return queue.size();
+  }
+
+  native_bool agent::await(object_ptr const agents, option<native_integer> const timeout_ms)
+  {
+    if(running_agent)
+    {
+      throw std::runtime_error{ "Can't await in agent action" };
+    }
+
+    native_vector<agent_ptr> targets;
+    visit_seqable(
+      [&](auto const typed_agents) {
+        for(auto it(typed_agents->fresh_seq()); it != nullptr; it = runtime::next_in_place(it))
+        {
+          targets.emplace_back(try_object<agent>(it->first()));
+        }
+      },
+      agents);
+
+    auto const l(new(GC) latch{});
+    l->remaining = targets.size();
+    for(auto const target : targets)
+    {
+      auto const a(new(GC) action{});
+      a->exec = &executor::pooled();
+      a->done = l;
+      target->dispatch(a);
+    }
+
+    std::unique_lock<std::mutex> locked{ l->lock };
+    auto const is_done([&] { return l->remaining == 0; });
+    if(timeout_ms.is_some())
+    {
+      return l->done.wait_for(locked,
+                              std::chrono::milliseconds{ timeout_ms.unwrap() },
+                              is_done);
+    }
+    l->done.wait(locked, is_done);
+    return true;
+  }
+
+  size_t agent::release_pending_sends()
+  {
+    if(!pending_sends || pending_sends->empty())
+    {
+      return 0;
+    }
+
+    auto const sends(std::move(*pending_sends));
+    pending_sends->clear();
+    for(auto const &send : sends)
+    {
+      send.first->enqueue(send.second);
+    }
+    return sends.size();
+  }
+
+  agent *agent::current()
+  {
+    return running_agent;
+  }
+}
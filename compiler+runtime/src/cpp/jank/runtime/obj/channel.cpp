@@ -0,0 +1,386 @@
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include <jank/runtime/obj/channel.hpp>
+#include <jank/runtime/obj/persistent_vector.hpp>
+#include <jank/runtime/context.hpp>
+#include <jank/runtime/visit.hpp>
+#include <jank/runtime/core.hpp>
+#include <jank/util/futex.hpp>
+#include <jank/util/scope_exit.hpp>
+
+namespace jank::runtime::obj
+{
+  static void check_not_nil(object_ptr const o)
+  {
+    if(o == nil::nil_const())
+    {
+      throw std::runtime_error{ "Can't put nil on a channel" };
+    }
+  }
+
+  channel::channel(size_t const capacity)
+    : capacity{ capacity }
+    , cells{ make_array_box<cell>(capacity) }
+  {
+    if(capacity == 0)
+    {
+      throw std::runtime_error{ "Channel capacity must be positive" };
+    }
+    for(size_t i{}; i < capacity; ++i)
+    {
+      cells.data[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  native_bool channel::equal(object const &o) const
+  {
+    return &o == &base;
+  }
+
+  native_persistent_string channel::to_string() const
+  {
+    util::string_builder buff;
+    to_string(buff);
+    return buff.release();
+  }
+
+  void channel::to_string(util::string_builder &buff) const
+  {
+    fmt::format_to(std::back_inserter(buff), "{}@{}", object_type_str(base.type), fmt::ptr(&base));
+  }
+
+  native_persistent_string channel::to_code_string() const
+  {
+    return to_string();
+  }
+
+  native_hash channel::to_hash() const
+  {
+    return static_cast<native_hash>(reinterpret_cast<uintptr_t>(this));
+  }
+
+  /* A cell is ready to write when its sequence matches the position and ready to read
+   * when it's one past. Whoever claims the position by bumping head or tail owns the cell
+   * until they publish the next sequence. */
+  native_bool channel::push(object_ptr const o)
+  {
+    auto pos(head.load(std::memory_order_relaxed));
+    while(true)
+    {
+      auto &c(cells.data[pos % capacity]);
+      auto const seq(c.sequence.load(std::memory_order_acquire));
+      auto const diff(static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos));
+      if(diff == 0)
+      {
+        if(head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+          c.value = o.data;
+          c.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      /* The reader from the last lap hasn't been here yet, so we're full. */
+      else if(diff < 0)
+      {
+        return false;
+      }
+      else
+      {
+        pos = head.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  object *channel::pop()
+  {
+    auto pos(tail.load(std::memory_order_relaxed));
+    while(true)
+    {
+      auto &c(cells.data[pos % capacity]);
+      auto const seq(c.sequence.load(std::memory_order_acquire));
+      auto const diff(static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1));
+      if(diff == 0)
+      {
+        if(tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+          auto const ret(c.value);
+          /* Don't keep the value alive for the GC. */
+          c.value = nullptr;
+          c.sequence.store(pos + capacity, std::memory_order_release);
+          return ret;
+        }
+      }
+      else if(diff < 0)
+      {
+        return nullptr;
+      }
+      else
+      {
+        pos = tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /* Waiters register before checking the buffer and wakers check for waiters after
+   * changing it. Both are sequentially consistent, so at least one of them sees the
+   * other and no wake up is lost. */
+  void channel::signal(std::atomic<uint32_t> &event, std::atomic<uint32_t> const &waiters)
+  {
+    event.fetch_add(1);
+    if(waiters.load() != 0)
+    {
+      util::futex::wake_all(event);
+    }
+    notify_selectors();
+  }
+
+  void channel::notify_selectors()
+  {
+    if(selector_count.load() == 0)
+    {
+      return;
+    }
+
+    std::lock_guard<std::mutex> const locked{ selectors_lock };
+    for(auto const s : selectors)
+    {
+      s->event.fetch_add(1);
+      util::futex::wake_all(s->event);
+    }
+  }
+
+  void channel::add_selector(selector * const s)
+  {
+    std::lock_guard<std::mutex> const locked{ selectors_lock };
+    selectors.push_back(s);
+    selector_count.fetch_add(1);
+  }
+
+  void channel::remove_selector(selector * const s)
+  {
+    std::lock_guard<std::mutex> const locked{ selectors_lock };
+    auto const found(std::find(selectors.begin(), selectors.end(), s));
+    if(found != selectors.end())
+    {
+      selectors.erase(found);
+      selector_count.fetch_sub(1);
+    }
+  }
+
+  native_bool channel::try_offer(object_ptr const o)
+  {
+    if(!push(o))
+    {
+      return false;
+    }
+    signal(not_empty, take_waiters);
+    return true;
+  }
+
+  object *channel::try_poll()
+  {
+    auto const ret(pop());
+    if(ret)
+    {
+      signal(not_full, put_waiters);
+    }
+    return ret;
+  }
+
+  native_bool channel::offer(object_ptr const o)
+  {
+    check_not_nil(o);
+    return !closed.load() && try_offer(o);
+  }
+
+  object *channel::poll()
+  {
+    return try_poll();
+  }
+
+  native_bool channel::put(object_ptr const o)
+  {
+    check_not_nil(o);
+    while(true)
+    {
+      if(closed.load())
+      {
+        return false;
+      }
+      if(try_offer(o))
+      {
+        return true;
+      }
+
+      put_waiters.fetch_add(1);
+      util::scope_exit const done{ [this] { put_waiters.fetch_sub(1); } };
+      auto const epoch(not_full.load());
+      if(closed.load())
+      {
+        return false;
+      }
+      if(try_offer(o))
+      {
+        return true;
+      }
+      util::futex::wait(not_full, epoch, none);
+    }
+  }
+
+  object_ptr channel::take()
+  {
+    while(true)
+    {
+      if(auto const ret(try_poll()); ret)
+      {
+        return ret;
+      }
+
+      take_waiters.fetch_add(1);
+      util::scope_exit const done{ [this] { take_waiters.fetch_sub(1); } };
+      auto const epoch(not_empty.load());
+      /* Puts which raced with the close may still have landed, so we drain first. */
+      if(auto const ret(try_poll()); ret)
+      {
+        return ret;
+      }
+      if(closed.load())
+      {
+        return nil::nil_const();
+      }
+      util::futex::wait(not_empty, epoch, none);
+    }
+  }
+
+  void channel::close()
+  {
+    if(closed.exchange(true))
+    {
+      return;
+    }
+    signal(not_empty, take_waiters);
+    signal(not_full, put_waiters);
+  }
+
+  native_bool channel::is_closed() const
+  {
+    return closed.load();
+  }
+
+  persistent_vector_ptr channel::alts(object_ptr const ops,
+                                      native_bool const priority,
+                                      option<object_ptr> const &default_val)
+  {
+    struct op
+    {
+      channel_ptr ch;
+      /* Null for takes. */
+      object_ptr put_val;
+    };
+
+    native_vector<op> parsed;
+    visit_seqable(
+      [&](auto const typed_ops) {
+        for(auto it(typed_ops->fresh_seq()); it != nullptr; it = runtime::next_in_place(it))
+        {
+          auto const o(it->first());
+          if(o->type == object_type::channel)
+          {
+            parsed.push_back({ expect_object<channel>(o), nullptr });
+          }
+          else if(o->type == object_type::persistent_vector
+                  && expect_object<persistent_vector>(o)->count() == 2)
+          {
+            auto const vec(expect_object<persistent_vector>(o));
+            check_not_nil(vec->data[1]);
+            parsed.push_back({ try_object<channel>(vec->data[0]), vec->data[1] });
+          }
+          else
+          {
+            throw std::runtime_error{ fmt::format("Invalid alts op: {}",
+                                                  runtime::to_code_string(o)) };
+          }
+        }
+      },
+      ops);
+
+    if(parsed.empty())
+    {
+      throw std::runtime_error{ "alts needs at least one op" };
+    }
+
+    /* Rather than picking at random, each call starts one past where the last call on this
+     * thread started, which is just as fair and much cheaper. */
+    /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+    static thread_local size_t rotation{};
+    auto const start(priority ? 0 : rotation++ % parsed.size());
+
+    auto const result([](object_ptr const val, channel_ptr const ch) {
+      return make_box<persistent_vector>(std::in_place, val, object_ptr{ ch });
+    });
+
+    auto const attempt([&]() -> persistent_vector_ptr {
+      for(size_t i{}; i < parsed.size(); ++i)
+      {
+        auto const &o(parsed[(start + i) % parsed.size()]);
+        if(!o.put_val)
+        {
+          if(auto const ret(o.ch->try_poll()); ret)
+          {
+            return result(ret, o.ch);
+          }
+          if(o.ch->is_closed())
+          {
+            auto const ret(o.ch->try_poll());
+            return result(ret ? object_ptr{ ret } : nil::nil_const(), o.ch);
+          }
+        }
+        else if(o.ch->is_closed())
+        {
+          return result(obj::boolean::false_const(), o.ch);
+        }
+        else if(o.ch->try_offer(o.put_val))
+        {
+          return result(obj::boolean::true_const(), o.ch);
+        }
+      }
+      return nullptr;
+    });
+
+    if(auto const ret(attempt()); ret)
+    {
+      return ret;
+    }
+    if(default_val.is_some())
+    {
+      return make_box<persistent_vector>(
+        std::in_place,
+        default_val.unwrap(),
+        object_ptr{ __rt_ctx->intern_keyword("default").expect_ok() });
+    }
+
+    auto const sel(new(GC) selector{});
+    for(auto const &o : parsed)
+    {
+      o.ch->add_selector(sel);
+    }
+    util::scope_exit const unregister{ [&] {
+      for(auto const &o : parsed)
+      {
+        o.ch->remove_selector(sel);
+      }
+    } };
+
+    while(true)
+    {
+      auto const epoch(sel->event.load());
+      if(auto const ret(attempt()); ret)
+      {
+        return ret;
+      }
+      util::futex::wait(sel->event, epoch, none);
+    }
+  }
+}
@@ -1,3 +1,5 @@
+#include <exception>
+
 #include <fmt/format.h>
 
 #include <jank/runtime/obj/delay.hpp>
@@ -40,31 +42,40 @@ namespace jank::runtime::obj
 
   object_ptr delay::deref()
   {
-    std::lock_guard<std::mutex> const lock{ mutex };
-    if(val != nullptr)
+    /* The error is remembered for later derefs, but whoever ran the fn gets the original
+     * exception. */
+    std::exception_ptr original_error;
+    realized.call([&] {
+      try
+      {
+        val = dynamic_call(fn);
+      }
+      catch(std::exception const &e)
+      {
+        error = make_box(e.what());
+        original_error = std::current_exception();
+      }
+      catch(object_ptr const e)
+      {
+        error = e;
+        original_error = std::current_exception();
+      }
+      fn = nullptr;
+    });
+
+    if(original_error)
     {
-      return val;
+      std::rethrow_exception(original_error);
     }
-
     if(error != nullptr)
     {
       throw error;
     }
-
-    try
-    {
-      val = dynamic_call(fn);
-    }
-    catch(std::exception const &e)
-    {
-      error = make_box(e.what());
-      throw;
-    }
-    catch(object_ptr const e)
-    {
-      error = e;
-      throw;
-    }
     return val;
   }
+
+  native_bool delay::is_realized() const
+  {
+    return realized.is_done();
+  }
 }
@@ -1,4 +1,5 @@
 #include <jank/runtime/obj/integer_range.hpp>
+#include <jank/runtime/obj/array_chunk.hpp>
 #include <jank/runtime/core/math.hpp>
 #include <jank/runtime/core/make_box.hpp>
 #include <jank/runtime/visit.hpp>
@@ -123,6 +124,34 @@ namespace jank::runtime::obj
     return this;
   }
 
+  /* Unlike range, we know every value up front, so there's nothing to cache. A chunk is
+   * just the next block of integers. */
+  array_chunk_ptr integer_range::chunked_first() const
+  {
+    auto const size(std::min(count(), chunk_size));
+    native_vector<object_ptr> buffer;
+    buffer.reserve(size);
+    auto val(start->data);
+    for(size_t i{}; i < size; ++i, val += step->data)
+    {
+      buffer.emplace_back(make_box<integer>(val));
+    }
+    return make_box<array_chunk>(std::move(buffer), static_cast<size_t>(0));
+  }
+
+  integer_range_ptr integer_range::chunked_next() const
+  {
+    if(count() <= chunk_size)
+    {
+      return nullptr;
+    }
+    return make_box<integer_range>(
+      make_box<integer>(start->data + step->data * static_cast<native_integer>(chunk_size)),
+      end,
+      step,
+      bounds_check);
+  }
+
   cons_ptr integer_range::conj(object_ptr const head) const
   {
     return make_box<cons>(head, this);
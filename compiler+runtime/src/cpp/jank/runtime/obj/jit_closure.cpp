@@ -71,7 +71,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<0>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_0(context);
+    return keep_alive(this, arity_0(context));
   }
 
   object_ptr jit_closure::call(object_ptr const a1)
@@ -80,7 +80,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<1>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_1(context, a1);
+    return keep_alive(this, arity_1(context, a1));
   }
 
   object_ptr jit_closure::call(object_ptr const a1, object_ptr const a2)
@@ -89,7 +89,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<2>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_2(context, a1, a2);
+    return keep_alive(this, arity_2(context, a1, a2));
   }
 
   object_ptr jit_closure::call(object_ptr const a1, object_ptr const a2, object_ptr const a3)
@@ -98,7 +98,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<3>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_3(context, a1, a2, a3);
+    return keep_alive(this, arity_3(context, a1, a2, a3));
   }
 
   object_ptr jit_closure::call(object_ptr const a1,
@@ -110,7 +110,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<4>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_4(context, a1, a2, a3, a4);
+    return keep_alive(this, arity_4(context, a1, a2, a3, a4));
   }
 
   object_ptr jit_closure::call(object_ptr const a1,
@@ -123,7 +123,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<5>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_5(context, a1, a2, a3, a4, a5);
+    return keep_alive(this, arity_5(context, a1, a2, a3, a4, a5));
   }
 
   object_ptr jit_closure::call(object_ptr const a1,
@@ -137,7 +137,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<6>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_6(context, a1, a2, a3, a4, a5, a6);
+    return keep_alive(this, arity_6(context, a1, a2, a3, a4, a5, a6));
   }
 
   object_ptr jit_closure::call(object_ptr const a1,
@@ -152,7 +152,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<7>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_7(context, a1, a2, a3, a4, a5, a6, a7);
+    return keep_alive(this, arity_7(context, a1, a2, a3, a4, a5, a6, a7));
   }
 
   object_ptr jit_closure::call(object_ptr const a1,
@@ -168,7 +168,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<8>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_8(context, a1, a2, a3, a4, a5, a6, a7, a8);
+    return keep_alive(this, arity_8(context, a1, a2, a3, a4, a5, a6, a7, a8));
   }
 
   object_ptr jit_closure::call(object_ptr const a1,
@@ -185,7 +185,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<9>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_9(context, a1, a2, a3, a4, a5, a6, a7, a8, a9);
+    return keep_alive(this, arity_9(context, a1, a2, a3, a4, a5, a6, a7, a8, a9));
   }
 
   object_ptr jit_closure::call(object_ptr const a1,
@@ -203,7 +203,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<10>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_10(context, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10);
+    return keep_alive(this, arity_10(context, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10));
   }
 
   behavior::callable::arity_flag_t jit_closure::get_arity_flags() const
@@ -70,7 +70,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<0>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_0();
+    return keep_alive(this, arity_0());
   }
 
   object_ptr jit_function::call(object_ptr const a1)
@@ -79,7 +79,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<1>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_1(a1);
+    return keep_alive(this, arity_1(a1));
   }
 
   object_ptr jit_function::call(object_ptr const a1, object_ptr const a2)
@@ -88,7 +88,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<2>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_2(a1, a2);
+    return keep_alive(this, arity_2(a1, a2));
   }
 
   object_ptr jit_function::call(object_ptr const a1, object_ptr const a2, object_ptr const a3)
@@ -97,7 +97,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<3>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_3(a1, a2, a3);
+    return keep_alive(this, arity_3(a1, a2, a3));
   }
 
   object_ptr jit_function::call(object_ptr const a1,
@@ -109,7 +109,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<4>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_4(a1, a2, a3, a4);
+    return keep_alive(this, arity_4(a1, a2, a3, a4));
   }
 
   object_ptr jit_function::call(object_ptr const a1,
@@ -122,7 +122,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<5>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_5(a1, a2, a3, a4, a5);
+    return keep_alive(this, arity_5(a1, a2, a3, a4, a5));
   }
 
   object_ptr jit_function::call(object_ptr const a1,
@@ -136,7 +136,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<6>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_6(a1, a2, a3, a4, a5, a6);
+    return keep_alive(this, arity_6(a1, a2, a3, a4, a5, a6));
   }
 
   object_ptr jit_function::call(object_ptr const a1,
@@ -151,7 +151,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<7>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_7(a1, a2, a3, a4, a5, a6, a7);
+    return keep_alive(this, arity_7(a1, a2, a3, a4, a5, a6, a7));
   }
 
   object_ptr jit_function::call(object_ptr const a1,
@@ -167,7 +167,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<8>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_8(a1, a2, a3, a4, a5, a6, a7, a8);
+    return keep_alive(this, arity_8(a1, a2, a3, a4, a5, a6, a7, a8));
   }
 
   object_ptr jit_function::call(object_ptr const a1,
@@ -184,7 +184,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<9>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_9(a1, a2, a3, a4, a5, a6, a7, a8, a9);
+    return keep_alive(this, arity_9(a1, a2, a3, a4, a5, a6, a7, a8, a9));
   }
 
   object_ptr jit_function::call(object_ptr const a1,
@@ -202,7 +202,7 @@ namespace jank::runtime::obj
     {
       throw invalid_arity<10>{ runtime::to_string(this_object_ptr()) };
     }
-    return arity_10(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10);
+    return keep_alive(this, arity_10(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10));
   }
 
   behavior::callable::arity_flag_t jit_function::get_arity_flags() const
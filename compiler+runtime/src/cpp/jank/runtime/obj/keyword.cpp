@@ -7,6 +7,7 @@ namespace jank::runtime::obj
 {
   keyword::keyword(detail::must_be_interned, native_persistent_string_view const &s)
     : sym{ make_box<obj::symbol>(s) }
+    , hash{ sym->to_hash() + static_cast<native_hash>(hash_magic) }
   {
   }
 
@@ -14,6 +15,7 @@ namespace jank::runtime::obj
                    native_persistent_string_view const &ns,
                    native_persistent_string_view const &n)
     : sym{ make_box<obj::symbol>(ns, n) }
+    , hash{ sym->to_hash() + static_cast<native_hash>(hash_magic) }
   {
   }
 
@@ -48,7 +50,7 @@ namespace jank::runtime::obj
 
   native_hash keyword::to_hash() const
   {
-    return sym->to_hash() + 0x9e3779b9;
+    return hash;
   }
 
   native_integer keyword::compare(object const &o) const
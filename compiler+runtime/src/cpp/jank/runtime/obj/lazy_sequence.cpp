@@ -19,6 +19,8 @@ namespace jank::runtime::obj
   lazy_sequence::lazy_sequence(object_ptr const fn, object_ptr const sequence)
     : fn{ fn }
     , sequence{ sequence }
+    , fn_called{ fn == nullptr }
+    , realized{ fn == nullptr }
   {
   }
 
@@ -113,43 +115,44 @@ namespace jank::runtime::obj
     return make_box<cons>(head, sequence ? this : nullptr);
   }
 
+  /* Returns what the fn gave us or, if that's already been turned into our sequence,
+   * the sequence itself. */
   object_ptr lazy_sequence::resolve_fn() const
   {
-    if(fn)
-    {
-      fn_result = dynamic_call(fn);
+    fn_called.call([this] {
+      auto const ret(dynamic_call(fn));
+      fn_result.store(ret == nil::nil_const() ? nullptr : ret.data, std::memory_order_release);
       fn = nullptr;
-      if(fn_result == nil::nil_const())
-      {
-        fn_result = nullptr;
-      }
-    }
-    if(fn_result)
+    });
+
+    object_ptr const ret{ fn_result.load(std::memory_order_acquire) };
+    if(ret)
     {
-      return fn_result;
+      return ret;
     }
-    return sequence;
+    /* Either the fn returned nil, in which case we're empty, or the result was cleared
+     * after realization, which happens only once the sequence is ready. */
+    return realized.is_done() ? sequence : nullptr;
   }
 
   object_ptr lazy_sequence::resolve_seq() const
   {
-    resolve_fn();
-    if(fn_result)
-    {
-      object_ptr lazy{ fn_result };
-      fn_result = nullptr;
+    realized.call([this] {
+      object_ptr lazy{ resolve_fn() };
       while(lazy && lazy->type == object_type::lazy_sequence)
       {
         lazy = expect_object<lazy_sequence>(lazy)->resolve_fn();
       }
       if(lazy)
       {
-        sequence = runtime::seq(lazy);
-        if(sequence == nil::nil_const())
-        {
-          sequence = nullptr;
-        }
+        auto const s(runtime::seq(lazy));
+        sequence = (s == nil::nil_const() ? nullptr : s);
       }
+    });
+
+    if(fn_result.load(std::memory_order_relaxed))
+    {
+      fn_result.store(nullptr, std::memory_order_release);
     }
     return sequence;
   }
@@ -162,4 +165,9 @@ namespace jank::runtime::obj
     ret->meta = meta;
     return ret;
   }
+
+  native_bool lazy_sequence::is_realized() const
+  {
+    return fn_called.is_done();
+  }
 }
@@ -1,3 +1,7 @@
+#include <bit>
+
+#include <gc/gc.h>
+
 #include <fmt/format.h>
 
 #include <jank/runtime/obj/multi_function.hpp>
@@ -11,6 +15,100 @@
 
 namespace jank::runtime::obj
 {
+  /* Generations are unique across all multimethods, so a call site can't mistake one
+   * multimethod's cache for another's, even if the first was collected and the second
+   * ended up at the same address. */
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static std::atomic<size_t> next_generation{ 1 };
+
+  multi_function_cache::entry::entry(object_ptr const dispatch_val,
+                                     object_ptr const method,
+                                     native_hash const hash)
+    : dispatch_val{ dispatch_val }
+    , method{ method }
+    , hash{ hash }
+  {
+  }
+
+  multi_function_cache::multi_function_cache(size_t const generation,
+                                             object_ptr const hierarchy,
+                                             size_t const capacity)
+    : generation{ generation }
+    , hierarchy{ hierarchy }
+    , capacity{ capacity }
+    , slots{ static_cast<std::atomic<entry *> *>(
+        GC_MALLOC(sizeof(std::atomic<entry *>) * capacity)) }
+  {
+    assert(std::has_single_bit(capacity));
+    for(size_t i{}; i < capacity; ++i)
+    {
+      new(slots + i) std::atomic<entry *>{};
+    }
+  }
+
+  object_ptr multi_function_cache::find(object_ptr const dispatch_val, native_hash const hash) const
+  {
+    auto const mask(capacity - 1);
+    for(size_t i{ hash & mask }, probes{}; probes < capacity; i = (i + 1) & mask, ++probes)
+    {
+      auto const e(slots[i].load(std::memory_order_acquire));
+      if(!e)
+      {
+        return nullptr;
+      }
+      if(e->hash == hash
+         && (e->dispatch_val == dispatch_val || runtime::equal(e->dispatch_val, dispatch_val)))
+      {
+        return e->method;
+      }
+    }
+    return nullptr;
+  }
+
+  native_bool multi_function_cache::insert(entry * const e)
+  {
+    /* We keep a quarter of the slots empty, so that probes stay short. */
+    if((size + 1) * 4 > capacity * 3)
+    {
+      return false;
+    }
+
+    auto const mask(capacity - 1);
+    for(size_t i{ e->hash & mask };; i = (i + 1) & mask)
+    {
+      if(!slots[i].load(std::memory_order_relaxed))
+      {
+        slots[i].store(e, std::memory_order_release);
+        ++size;
+        return true;
+      }
+    }
+  }
+
+  /* Adds the entry, moving everything over to a bigger cache if there's no room. Growing
+   * doesn't change what's cached, so the generation stays the same. */
+  static multi_function_cache *
+  add_cache_entry(multi_function_cache * const cache, multi_function_cache::entry * const e)
+  {
+    if(cache->insert(e))
+    {
+      return cache;
+    }
+
+    auto const bigger(
+      new(GC) multi_function_cache{ cache->generation, cache->hierarchy, cache->capacity * 2 });
+    for(size_t i{}; i < cache->capacity; ++i)
+    {
+      auto const existing(cache->slots[i].load(std::memory_order_relaxed));
+      if(existing)
+      {
+        bigger->insert(existing);
+      }
+    }
+    bigger->insert(e);
+    return bigger;
+  }
+
   multi_function::multi_function(object_ptr const name,
                                  object_ptr const dispatch,
                                  object_ptr const default_,
@@ -19,7 +117,10 @@ namespace jank::runtime::obj
     , default_dispatch_value{ default_ }
     , hierarchy{ hierarchy }
     , method_table{ persistent_hash_map::empty() }
-    , method_cache{ persistent_hash_map::empty() }
+    /* No hierarchy will match this, so the first call will build a real cache. */
+    , method_cache{ new(GC) multi_function_cache{ next_generation++,
+                                                  nullptr,
+                                                  multi_function_cache::initial_capacity } }
     , prefer_table{ persistent_hash_map::empty() }
     , name{ try_object<symbol>(name) }
   {
@@ -201,17 +302,40 @@ namespace jank::runtime::obj
   multi_function_ptr multi_function::reset()
   {
     std::lock_guard<std::recursive_mutex> const locked{ data_lock };
-    cached_hierarchy = nullptr;
-    method_table = prefer_table = method_cache = persistent_hash_map::empty();
+    method_table = prefer_table = persistent_hash_map::empty();
+    reset_cache();
     return this;
   }
 
-  persistent_hash_map_ptr multi_function::reset_cache()
+  multi_function_cache *multi_function::reset_cache()
   {
     std::lock_guard<std::recursive_mutex> const locked{ data_lock };
-    cached_hierarchy = hierarchy;
-    method_cache = method_table;
-    return method_cache;
+    auto cache(new(GC) multi_function_cache{ next_generation++,
+                                             deref(hierarchy),
+                                             multi_function_cache::initial_capacity });
+
+    /* Exact matches are known right away. */
+    for(auto it(method_table->fresh_seq()); it != nullptr; it = it->next_in_place())
+    {
+      auto const entry(it->first());
+      auto const dispatch_val(runtime::first(entry));
+      cache = add_cache_entry(
+        cache,
+        new(GC) multi_function_cache::entry{ dispatch_val, second(entry), to_hash(dispatch_val) });
+    }
+
+    method_cache.store(cache, std::memory_order_release);
+    return cache;
+  }
+
+  multi_function_cache *multi_function::current_cache()
+  {
+    auto const cache(method_cache.load(std::memory_order_acquire));
+    if(cache->hierarchy != deref(hierarchy))
+    {
+      return reset_cache();
+    }
+    return cache;
   }
 
   multi_function_ptr
@@ -315,26 +439,79 @@ namespace jank::runtime::obj
     return target;
   }
 
-  object_ptr multi_function::get_method(object_ptr const dispatch_val)
+  /* Only values which live as long as the runtime can be compared by identity at call
+   * sites, since the call site doesn't keep them alive. */
+  static native_bool is_permanent(object_ptr const o)
   {
-    if(cached_hierarchy != deref(hierarchy))
+    return o->type == object_type::keyword || o->type == object_type::nil
+      || o->type == object_type::boolean;
+  }
+
+  object_ptr multi_function::get_fn(call_site &site, object_ptr const dispatch_val)
+  {
+    auto const cache(current_cache());
+
+    auto const sequence(site.sequence.load(std::memory_order_acquire));
+    if((sequence & 1) == 0
+       && site.generation.load(std::memory_order_relaxed) == cache->generation
+       && site.fn.load(std::memory_order_relaxed) == &base
+       && site.dispatch_val.load(std::memory_order_relaxed) == dispatch_val.data)
     {
-      reset_cache();
+      object_ptr const method{ site.method.load(std::memory_order_relaxed) };
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if(site.sequence.load(std::memory_order_relaxed) == sequence)
+      {
+        return method;
+      }
     }
 
-    auto const target(method_cache->get(dispatch_val));
-    if(target != nil::nil_const())
+    auto const method(get_fn(dispatch_val));
+
+    /* If another thread is updating the site, we just leave it to them. We record the
+     * generation from before the lookup, so if the cache was reset in the meantime, this
+     * entry will never match. */
+    auto expected(sequence);
+    if(is_permanent(dispatch_val) && (expected & 1) == 0
+       && site.sequence.compare_exchange_strong(expected,
+                                                expected + 1,
+                                                std::memory_order_acquire))
+    {
+      std::atomic_thread_fence(std::memory_order_release);
+      site.generation.store(cache->generation, std::memory_order_relaxed);
+      site.fn.store(&base, std::memory_order_relaxed);
+      site.dispatch_val.store(dispatch_val, std::memory_order_relaxed);
+      site.method.store(method, std::memory_order_relaxed);
+      site.sequence.store(expected + 2, std::memory_order_release);
+    }
+
+    return method;
+  }
+
+  object_ptr multi_function::get_method(object_ptr const dispatch_val)
+  {
+    auto const hash(to_hash(dispatch_val));
+    auto const target(current_cache()->find(dispatch_val, hash));
+    if(target)
     {
       return target;
     }
 
-    return find_and_cache_best_method(dispatch_val);
+    return find_and_cache_best_method(dispatch_val, hash);
   }
 
-  object_ptr multi_function::find_and_cache_best_method(object_ptr const dispatch_val)
+  object_ptr
+  multi_function::find_and_cache_best_method(object_ptr const dispatch_val, native_hash const hash)
   {
-    /* TODO: Clojure uses a RW lock here for better parallelism. */
     std::lock_guard<std::recursive_mutex> const locked{ data_lock };
+
+    /* Another thread may have beaten us to it. */
+    auto const cache(current_cache());
+    auto const cached(cache->find(dispatch_val, hash));
+    if(cached)
+    {
+      return cached;
+    }
+
     object_ptr best_value{ nil::nil_const() };
     persistent_vector_sequence_ptr best_entry{};
 
@@ -343,14 +520,14 @@ namespace jank::runtime::obj
       auto const entry(it->first());
       auto const entry_key(entry->seq()->first());
 
-      if(is_a(cached_hierarchy, dispatch_val, entry_key))
+      if(is_a(hierarchy, dispatch_val, entry_key))
       {
-        if(best_entry == nullptr || is_dominant(cached_hierarchy, entry_key, best_entry->first()))
+        if(best_entry == nullptr || is_dominant(hierarchy, entry_key, best_entry->first()))
         {
           best_entry = entry->seq();
         }
 
-        if(!is_dominant(cached_hierarchy, best_entry->first(), entry_key))
+        if(!is_dominant(hierarchy, best_entry->first(), entry_key))
         {
           throw std::runtime_error{ fmt::format(
             "Multiple methods in multimethod '{}' match dispatch value: {} -> {} and {}, and "
@@ -376,7 +553,13 @@ namespace jank::runtime::obj
       }
     }
 
-    method_cache = method_cache->assoc(dispatch_val, best_value);
+    auto const updated(add_cache_entry(
+      cache,
+      new(GC) multi_function_cache::entry{ dispatch_val, best_value, hash }));
+    if(updated != cache)
+    {
+      method_cache.store(updated, std::memory_order_release);
+    }
 
     return best_value;
   }
@@ -1,3 +1,5 @@
+#include <memory>
+
 #include <jank/runtime/obj/native_array_sequence.hpp>
 #include <jank/runtime/core/to_string.hpp>
 #include <jank/runtime/core/seq_ext.hpp>
@@ -23,6 +25,24 @@ namespace jank::runtime::obj
     assert(size > 0);
   }
 
+  native_array_sequence_ptr
+  native_array_sequence::create(object_ptr const * const values, size_t const count)
+  {
+    /* The values follow the sequence, so we can't use make_box. Any sequences made from
+     * this one by next point into it, which keeps it alive. */
+    auto const size(sizeof(native_array_sequence) + count * sizeof(object_ptr));
+    auto const mem(GC_MALLOC(size));
+    if(!mem)
+    {
+      throw std::runtime_error{ "unable to allocate native_array_sequence" };
+    }
+    profile::allocation::sample(obj_type, size);
+
+    auto const arr(reinterpret_cast<object_ptr *>(static_cast<native_array_sequence *>(mem) + 1));
+    std::uninitialized_copy(values, values + count, arr);
+    return new(mem) native_array_sequence{ arr, count };
+  }
+
   /* behavior::object_like */
   native_bool native_array_sequence::equal(object const &o) const
   {
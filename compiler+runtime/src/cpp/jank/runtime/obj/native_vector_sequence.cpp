@@ -1,4 +1,5 @@
 #include <jank/runtime/obj/native_vector_sequence.hpp>
+#include <jank/runtime/obj/array_chunk.hpp>
 #include <jank/runtime/core.hpp>
 #include <jank/runtime/core/seq_ext.hpp>
 
@@ -99,6 +100,27 @@ namespace jank::runtime::obj
     return make_box<native_vector_sequence>(data, n);
   }
 
+  /* behavior::chunkable */
+  array_chunk_ptr native_vector_sequence::chunked_first() const
+  {
+    using difference_type = native_vector<object_ptr>::difference_type;
+
+    auto const end(std::min(data.size(), index + chunk_size));
+    native_vector<object_ptr> buffer(data.begin() + static_cast<difference_type>(index),
+                                     data.begin() + static_cast<difference_type>(end));
+    return make_box<array_chunk>(std::move(buffer), static_cast<size_t>(0));
+  }
+
+  native_vector_sequence_ptr native_vector_sequence::chunked_next() const
+  {
+    auto const end(index + chunk_size);
+    if(data.size() <= end)
+    {
+      return nullptr;
+    }
+    return make_box<native_vector_sequence>(data, end);
+  }
+
   native_vector_sequence_ptr native_vector_sequence::next_in_place()
   {
     ++index;
@@ -65,7 +65,7 @@ namespace jank::runtime::obj
   object_ptr persistent_sorted_map::get(object_ptr const key) const
   {
     auto const res(data.find(key));
-    if(res != data.end())
+    if(res)
     {
       return res->second;
     }
@@ -75,7 +75,7 @@ namespace jank::runtime::obj
   object_ptr persistent_sorted_map::get(object_ptr const key, object_ptr const fallback) const
   {
     auto const res(data.find(key));
-    if(res != data.end())
+    if(res)
     {
       return res->second;
     }
@@ -85,7 +85,7 @@ namespace jank::runtime::obj
   object_ptr persistent_sorted_map::get_entry(object_ptr const key) const
   {
     auto const res(data.find(key));
-    if(res != data.end())
+    if(res)
     {
       return make_box<persistent_vector>(std::in_place, key, res->second);
     }
@@ -94,7 +94,7 @@ namespace jank::runtime::obj
 
   native_bool persistent_sorted_map::contains(object_ptr const key) const
   {
-    return data.find(key) != data.end();
+    return data.find(key) != nullptr;
   }
 
   persistent_sorted_map_ptr
@@ -131,9 +131,9 @@ namespace jank::runtime::obj
   object_ptr persistent_sorted_set::call(object_ptr const o)
   {
     auto const found(data.find(o));
-    if(found != data.end())
+    if(found)
     {
-      return found.get();
+      return *found;
     }
     return nil::nil_const();
   }
@@ -145,7 +145,7 @@ namespace jank::runtime::obj
 
   native_bool persistent_sorted_set::contains(object_ptr const o) const
   {
-    return data.find(o) != data.end();
+    return data.find(o) != nullptr;
   }
 
   persistent_sorted_set_ptr persistent_sorted_set::disj(object_ptr const o) const
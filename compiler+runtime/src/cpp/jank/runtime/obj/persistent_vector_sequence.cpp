@@ -1,5 +1,8 @@
+#include <immer/algorithm.hpp>
+
 #include <jank/runtime/obj/persistent_vector_sequence.hpp>
 #include <jank/runtime/obj/persistent_vector.hpp>
+#include <jank/runtime/obj/array_chunk.hpp>
 #include <jank/runtime/core.hpp>
 #include <jank/runtime/core/seq_ext.hpp>
 
@@ -118,6 +121,36 @@ namespace jank::runtime::obj
     return this;
   }
 
+  /* behavior::chunkable */
+  size_t persistent_vector_sequence::chunk_end() const
+  {
+    return std::min(vec->data.size(), (index / chunk_size + 1) * chunk_size);
+  }
+
+  array_chunk_ptr persistent_vector_sequence::chunked_first() const
+  {
+    using difference_type = decltype(persistent_vector::data)::difference_type;
+
+    native_vector<object_ptr> buffer;
+    buffer.reserve(chunk_end() - index);
+    immer::for_each_chunk(vec->data.begin() + static_cast<difference_type>(index),
+                          vec->data.begin() + static_cast<difference_type>(chunk_end()),
+                          [&](auto const first, auto const last) {
+                            buffer.insert(buffer.end(), first, last);
+                          });
+    return make_box<array_chunk>(std::move(buffer), static_cast<size_t>(0));
+  }
+
+  persistent_vector_sequence_ptr persistent_vector_sequence::chunked_next() const
+  {
+    auto const end(chunk_end());
+    if(end == vec->data.size())
+    {
+      return nullptr;
+    }
+    return make_box<persistent_vector_sequence>(vec, end);
+  }
+
   cons_ptr persistent_vector_sequence::conj(object_ptr const head)
   {
     return make_box<cons>(head, this);
@@ -0,0 +1,122 @@
+#include <chrono>
+
+#include <fmt/format.h>
+
+#include <jank/runtime/obj/promise.hpp>
+#include <jank/util/futex.hpp>
+
+namespace jank::runtime::obj
+{
+  native_bool promise::equal(object const &o) const
+  {
+    return &o == &base;
+  }
+
+  native_persistent_string promise::to_string() const
+  {
+    util::string_builder buff;
+    to_string(buff);
+    return buff.release();
+  }
+
+  void promise::to_string(util::string_builder &buff) const
+  {
+    fmt::format_to(std::back_inserter(buff), "{}@{}", object_type_str(base.type), fmt::ptr(&base));
+  }
+
+  native_persistent_string promise::to_code_string() const
+  {
+    return to_string();
+  }
+
+  native_hash promise::to_hash() const
+  {
+    return static_cast<native_hash>(reinterpret_cast<uintptr_t>(this));
+  }
+
+  object_ptr promise::deref() const
+  {
+    wait(none);
+    return value;
+  }
+
+  object_ptr promise::deref(native_integer const timeout_ms, object_ptr const timeout_val) const
+  {
+    return wait(timeout_ms) ? value : timeout_val;
+  }
+
+  native_bool promise::is_realized() const
+  {
+    return (state.load(std::memory_order_acquire) & delivered) != 0;
+  }
+
+  native_bool promise::deliver(object_ptr const o)
+  {
+    auto current(state.load(std::memory_order_relaxed));
+    do
+    {
+      if(current & (delivering | delivered))
+      {
+        return false;
+      }
+    } while(!state.compare_exchange_weak(current,
+                                         current | delivering,
+                                         std::memory_order_acquire,
+                                         std::memory_order_relaxed));
+
+    value = o;
+    auto const previous(state.exchange(delivered, std::memory_order_acq_rel));
+    if(previous & has_waiters)
+    {
+      util::futex::wake_all(state);
+    }
+    return true;
+  }
+
+  native_bool promise::wait(option<native_integer> const timeout_ms) const
+  {
+    auto current(state.load(std::memory_order_acquire));
+    if(current & delivered)
+    {
+      return true;
+    }
+
+    using clock = std::chrono::steady_clock;
+    option<clock::time_point> deadline;
+    if(timeout_ms.is_some())
+    {
+      deadline = clock::now() + std::chrono::milliseconds{ timeout_ms.unwrap() };
+    }
+
+    while(!(current & delivered))
+    {
+      /* The deliverer only pays for a wake up if someone has said they're waiting. */
+      if(!(current & has_waiters))
+      {
+        if(!state.compare_exchange_weak(current,
+                                        current | has_waiters,
+                                        std::memory_order_acquire,
+                                        std::memory_order_acquire))
+        {
+          continue;
+        }
+        current |= has_waiters;
+      }
+
+      option<std::chrono::nanoseconds> remaining;
+      if(deadline.is_some())
+      {
+        auto const left(deadline.unwrap() - clock::now());
+        if(left <= clock::duration::zero())
+        {
+          return false;
+        }
+        remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(left);
+      }
+
+      util::futex::wait(state, current, remaining);
+      current = state.load(std::memory_order_acquire);
+    }
+    return true;
+  }
+}
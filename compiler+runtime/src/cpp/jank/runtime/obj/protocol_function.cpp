@@ -0,0 +1,342 @@
+#include <fmt/format.h>
+
+#include <jank/runtime/obj/protocol_function.hpp>
+#include <jank/runtime/obj/native_function_wrapper.hpp>
+#include <jank/runtime/obj/persistent_hash_map.hpp>
+#include <jank/runtime/obj/record.hpp>
+#include <jank/runtime/context.hpp>
+#include <jank/runtime/rtti.hpp>
+#include <jank/runtime/core.hpp>
+#include <jank/native_persistent_string/fmt.hpp>
+
+namespace jank::runtime::obj
+{
+  /* Generations are unique across all protocol fns, so a call site can't mistake one protocol
+   * fn's methods for another's, even if the first was collected and the second ended up at
+   * the same address. */
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static std::atomic<uint64_t> next_generation{ 1 };
+
+  static option<object_type> find_object_type(native_persistent_string_view const name)
+  {
+    for(size_t i{}; i < protocol_function::type_count; ++i)
+    {
+      auto const type(static_cast<object_type>(i));
+      auto const type_name(object_type_str(type));
+      if(type_name != native_persistent_string_view{ "unknown" } && type_name == name)
+      {
+        return type;
+      }
+    }
+    return none;
+  }
+
+  protocol_function::protocol_function(object_ptr const protocol_name, object_ptr const name)
+    : protocol_name{ try_object<symbol>(protocol_name) }
+    , name{ try_object<symbol>(name) }
+    , generation{ next_generation++ }
+    , extensions{ persistent_hash_map::empty() }
+  {
+  }
+
+  native_bool protocol_function::equal(object const &rhs) const
+  {
+    return &base == &rhs;
+  }
+
+  native_persistent_string protocol_function::to_string()
+  {
+    util::string_builder buff;
+    to_string(buff);
+    return buff.release();
+  }
+
+  void protocol_function::to_string(util::string_builder &buff)
+  {
+    fmt::format_to(std::back_inserter(buff),
+                   "{} ({}@{})",
+                   name->to_string(),
+                   object_type_str(base.type),
+                   fmt::ptr(&base));
+  }
+
+  native_persistent_string protocol_function::to_code_string()
+  {
+    return to_string();
+  }
+
+  native_hash protocol_function::to_hash() const
+  {
+    return static_cast<native_hash>(reinterpret_cast<uintptr_t>(this));
+  }
+
+  object_ptr protocol_function::call()
+  {
+    throw invalid_arity<0>{ runtime::to_string(this_object_ptr()) };
+  }
+
+  object_ptr protocol_function::call(object_ptr const a1)
+  {
+    return dynamic_call(get_fn(a1), a1);
+  }
+
+  object_ptr protocol_function::call(object_ptr const a1, object_ptr const a2)
+  {
+    return dynamic_call(get_fn(a1), a1, a2);
+  }
+
+  object_ptr
+  protocol_function::call(object_ptr const a1, object_ptr const a2, object_ptr const a3)
+  {
+    return dynamic_call(get_fn(a1), a1, a2, a3);
+  }
+
+  object_ptr protocol_function::call(object_ptr const a1,
+                                     object_ptr const a2,
+                                     object_ptr const a3,
+                                     object_ptr const a4)
+  {
+    return dynamic_call(get_fn(a1), a1, a2, a3, a4);
+  }
+
+  object_ptr protocol_function::call(object_ptr const a1,
+                                     object_ptr const a2,
+                                     object_ptr const a3,
+                                     object_ptr const a4,
+                                     object_ptr const a5)
+  {
+    return dynamic_call(get_fn(a1), a1, a2, a3, a4, a5);
+  }
+
+  object_ptr protocol_function::call(object_ptr const a1,
+                                     object_ptr const a2,
+                                     object_ptr const a3,
+                                     object_ptr const a4,
+                                     object_ptr const a5,
+                                     object_ptr const a6)
+  {
+    return dynamic_call(get_fn(a1), a1, a2, a3, a4, a5, a6);
+  }
+
+  object_ptr protocol_function::call(object_ptr const a1,
+                                     object_ptr const a2,
+                                     object_ptr const a3,
+                                     object_ptr const a4,
+                                     object_ptr const a5,
+                                     object_ptr const a6,
+                                     object_ptr const a7)
+  {
+    return dynamic_call(get_fn(a1), a1, a2, a3, a4, a5, a6, a7);
+  }
+
+  object_ptr protocol_function::call(object_ptr const a1,
+                                     object_ptr const a2,
+                                     object_ptr const a3,
+                                     object_ptr const a4,
+                                     object_ptr const a5,
+                                     object_ptr const a6,
+                                     object_ptr const a7,
+                                     object_ptr const a8)
+  {
+    return dynamic_call(get_fn(a1), a1, a2, a3, a4, a5, a6, a7, a8);
+  }
+
+  object_ptr protocol_function::call(object_ptr const a1,
+                                     object_ptr const a2,
+                                     object_ptr const a3,
+                                     object_ptr const a4,
+                                     object_ptr const a5,
+                                     object_ptr const a6,
+                                     object_ptr const a7,
+                                     object_ptr const a8,
+                                     object_ptr const a9)
+  {
+    return dynamic_call(get_fn(a1), a1, a2, a3, a4, a5, a6, a7, a8, a9);
+  }
+
+  object_ptr protocol_function::call(object_ptr const a1,
+                                     object_ptr const a2,
+                                     object_ptr const a3,
+                                     object_ptr const a4,
+                                     object_ptr const a5,
+                                     object_ptr const a6,
+                                     object_ptr const a7,
+                                     object_ptr const a8,
+                                     object_ptr const a9,
+                                     object_ptr const a10)
+  {
+    return dynamic_call(get_fn(a1), a1, a2, a3, a4, a5, a6, a7, a8, a9, a10);
+  }
+
+  object_ptr protocol_function::this_object_ptr()
+  {
+    return &this->base;
+  }
+
+  protocol_function_ptr protocol_function::extend(object_ptr const type, object_ptr const method)
+  {
+    std::atomic<object *> *slot{};
+    object_ptr key{ type };
+    if(type->type == object_type::record_type)
+    {
+      std::lock_guard<std::mutex> const locked{ data_lock };
+      auto const current(record_methods.load(std::memory_order_relaxed));
+      auto const methods(current ? expect_object<persistent_hash_map>(current)
+                                 : persistent_hash_map::empty());
+      record_methods.store(&methods->assoc(type, method)->base, std::memory_order_release);
+      extensions = extensions->assoc(key, method);
+      generation.store(next_generation++, std::memory_order_release);
+      return this;
+    }
+    else if(type == nil::nil_const())
+    {
+      slot = &method_table[static_cast<size_t>(object_type::nil)];
+    }
+    else if(type->type == object_type::keyword || type->type == object_type::persistent_string)
+    {
+      auto const type_name(type->type == object_type::keyword
+                             ? expect_object<keyword>(type)->sym->name
+                             : expect_object<persistent_string>(type)->data);
+      if(type_name == "default")
+      {
+        slot = &default_method;
+      }
+      else if(auto const found(find_object_type(type_name)); found.is_some())
+      {
+        slot = &method_table[static_cast<size_t>(found.unwrap())];
+      }
+      key = __rt_ctx->intern_keyword(type_name).expect_ok();
+    }
+
+    if(!slot)
+    {
+      throw std::runtime_error{ fmt::format("Unable to extend {} to unknown type: {}",
+                                            runtime::to_string(name),
+                                            runtime::to_string(type)) };
+    }
+
+    std::lock_guard<std::mutex> const locked{ data_lock };
+    extensions = extensions->assoc(key, method);
+    slot->store(method.data, std::memory_order_release);
+    generation.store(next_generation++, std::memory_order_release);
+    return this;
+  }
+
+  persistent_hash_map_ptr protocol_function::get_extensions()
+  {
+    std::lock_guard<std::mutex> const locked{ data_lock };
+    return extensions;
+  }
+
+  object_ptr protocol_function::find_fn(object_ptr const target) const
+  {
+    if(target->type == object_type::record)
+    {
+      auto const methods(record_methods.load(std::memory_order_acquire));
+      if(methods)
+      {
+        auto const method(expect_object<persistent_hash_map>(methods)->get(
+          expect_object<record>(target)->type));
+        if(method != nil::nil_const())
+        {
+          return method;
+        }
+      }
+    }
+
+    auto const method(
+      method_table[static_cast<size_t>(target->type)].load(std::memory_order_acquire));
+    if(method)
+    {
+      return method;
+    }
+
+    auto const fallback(default_method.load(std::memory_order_acquire));
+    if(fallback)
+    {
+      return fallback;
+    }
+    return nil::nil_const();
+  }
+
+  object_ptr protocol_function::get_fn(object_ptr const target) const
+  {
+    auto const method(find_fn(target));
+    if(method == nil::nil_const())
+    {
+      throw std::runtime_error{ fmt::format(
+        "No implementation of method: {} of protocol: {} found for type: {}",
+        runtime::to_string(name),
+        runtime::to_string(protocol_name),
+        target->type == object_type::record
+          ? expect_object<record>(target)->type->to_string()
+          : native_persistent_string{ object_type_str(target->type) }) };
+    }
+    return method;
+  }
+
+  object_ptr protocol_function::get_fn(call_site &site, object_ptr const target)
+  {
+    /* Every record shares an object_type, so they can't be cached by it. */
+    if(target->type == object_type::record)
+    {
+      return get_fn(target);
+    }
+
+    auto const current_generation(generation.load(std::memory_order_acquire));
+    auto const type_tag(static_cast<uint64_t>(target->type) + 1);
+
+    auto const sequence(site.sequence.load(std::memory_order_acquire));
+    auto const site_is_current((sequence & 1) == 0
+                               && site.generation.load(std::memory_order_relaxed)
+                                 == current_generation
+                               && site.fn.load(std::memory_order_relaxed) == &base);
+    auto const types(site_is_current ? site.types.load(std::memory_order_relaxed) : 0);
+    for(size_t i{}; i < call_site::entry_count; ++i)
+    {
+      if(((types >> (i * 8)) & 0xff) == type_tag)
+      {
+        object_ptr const method{ site.methods[i].load(std::memory_order_relaxed) };
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(site.sequence.load(std::memory_order_relaxed) == sequence)
+        {
+          return method;
+        }
+        break;
+      }
+    }
+
+    auto const method(get_fn(target));
+
+    /* If another thread is updating the site, we just leave it to them. We record the
+     * generation from before the lookup, so if a method changed in the meantime, this
+     * entry will never match. New types take the first free entry. Once they're all taken,
+     * each type always evicts the same one, so a site can't thrash between all of them. */
+    auto expected(sequence);
+    if((expected & 1) == 0
+       && site.sequence.compare_exchange_strong(expected,
+                                                expected + 1,
+                                                std::memory_order_acquire))
+    {
+      std::atomic_thread_fence(std::memory_order_release);
+      auto entry(type_tag % call_site::entry_count);
+      for(size_t i{}; i < call_site::entry_count; ++i)
+      {
+        if(((types >> (i * 8)) & 0xff) == 0)
+        {
+          entry = i;
+          break;
+        }
+      }
+      auto const shift(entry * 8);
+      site.generation.store(current_generation, std::memory_order_relaxed);
+      site.fn.store(&base, std::memory_order_relaxed);
+      site.methods[entry].store(method, std::memory_order_relaxed);
+      site.types.store((types & ~(uint64_t{ 0xff } << shift)) | (type_tag << shift),
+                       std::memory_order_relaxed);
+      site.sequence.store(expected + 2, std::memory_order_release);
+    }
+
+    return method;
+  }
+}
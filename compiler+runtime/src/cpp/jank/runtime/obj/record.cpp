@@ -0,0 +1,384 @@
+#include <memory>
+
+#include <fmt/format.h>
+
+#include <jank/native_persistent_string/fmt.hpp>
+#include <jank/runtime/obj/record.hpp>
+#include <jank/runtime/obj/symbol.hpp>
+#include <jank/runtime/obj/persistent_vector.hpp>
+#include <jank/runtime/obj/persistent_hash_map.hpp>
+#include <jank/runtime/behavior/metadatable.hpp>
+#include <jank/runtime/rtti.hpp>
+#include <jank/runtime/visit.hpp>
+#include <jank/runtime/core.hpp>
+
+namespace jank::runtime::obj
+{
+  record::record(record_type_ptr const type)
+    : type{ type }
+  {
+  }
+
+  /* The fields live in the same allocation as the record, so we can't use make_box. */
+  static record *allocate(size_t const field_count)
+  {
+    auto const mem(GC_MALLOC(sizeof(record) + field_count * sizeof(object_ptr)));
+    if(!mem)
+    {
+      throw std::runtime_error{ "unable to allocate record" };
+    }
+    return static_cast<record *>(mem);
+  }
+
+  record_ptr
+  record::create(record_type_ptr const type, object_ptr const * const values, size_t const count)
+  {
+    if(count != type->fields.size())
+    {
+      throw std::runtime_error{ fmt::format("{} expects {} fields, but got {}",
+                                            type->to_string(),
+                                            type->fields.size(),
+                                            count) };
+    }
+
+    auto const ret(new(allocate(count)) record{ type });
+    std::uninitialized_copy(values, values + count, ret->fields());
+    return ret;
+  }
+
+  record_ptr record::create(record_type_ptr const type, object_ptr const values)
+  {
+    native_vector<object_ptr> collected;
+    collected.reserve(type->fields.size());
+    visit_seqable(
+      [&](auto const typed_values) {
+        for(auto it(typed_values->fresh_seq()); it != nullptr; it = runtime::next_in_place(it))
+        {
+          collected.emplace_back(it->first());
+        }
+      },
+      values);
+    return create(type, collected.data(), collected.size());
+  }
+
+  record_ptr record::clone() const
+  {
+    auto const count(type->fields.size());
+    auto const ret(new(allocate(count)) record{ *this });
+    std::uninitialized_copy(fields(), fields() + count, ret->fields());
+    ret->hash = 0;
+    return ret;
+  }
+
+  object_ptr *record::fields()
+  {
+    return reinterpret_cast<object_ptr *>(this + 1);
+  }
+
+  object_ptr const *record::fields() const
+  {
+    return reinterpret_cast<object_ptr const *>(this + 1);
+  }
+
+  void record::check_is_record(char const * const action) const
+  {
+    if(!type->is_record)
+    {
+      throw std::runtime_error{ fmt::format("{} isn't supported by {}, since it's not a record",
+                                            action,
+                                            type->to_string()) };
+    }
+  }
+
+  native_bool record::equal(object const &o) const
+  {
+    if(&o == &base)
+    {
+      return true;
+    }
+    if(o.type != object_type::record || !type->is_record)
+    {
+      return false;
+    }
+
+    auto const r(expect_object<record>(&o));
+    if(r->type != type)
+    {
+      return false;
+    }
+
+    for(size_t i{}; i < type->fields.size(); ++i)
+    {
+      if(!runtime::equal(fields()[i], r->fields()[i]))
+      {
+        return false;
+      }
+    }
+
+    if(!extension || !r->extension)
+    {
+      return !extension && !r->extension;
+    }
+    return runtime::equal(extension, r->extension);
+  }
+
+  static void to_string_impl(record const &r, util::string_builder &buff, native_bool const to_code)
+  {
+    auto const &name(*r.type->name);
+    buff('#');
+    if(!name.ns.empty())
+    {
+      buff(name.ns);
+      buff('.');
+    }
+    buff(name.name);
+
+    if(!r.type->is_record)
+    {
+      fmt::format_to(std::back_inserter(buff), "@{}", fmt::ptr(&r.base));
+      return;
+    }
+
+    auto const print([&](object_ptr const o) {
+      if(to_code)
+      {
+        runtime::to_code_string(o, buff);
+      }
+      else
+      {
+        runtime::to_string(o, buff);
+      }
+    });
+
+    buff('{');
+    native_bool needs_comma{};
+    for(size_t i{}; i < r.type->fields.size(); ++i)
+    {
+      if(needs_comma)
+      {
+        buff(", ");
+      }
+      print(r.type->fields[i]);
+      buff(' ');
+      print(r.fields()[i]);
+      needs_comma = true;
+    }
+    if(r.extension)
+    {
+      for(auto const &entry : r.extension->data)
+      {
+        if(needs_comma)
+        {
+          buff(", ");
+        }
+        print(entry.first);
+        buff(' ');
+        print(entry.second);
+        needs_comma = true;
+      }
+    }
+    buff('}');
+  }
+
+  void record::to_string(util::string_builder &buff) const
+  {
+    to_string_impl(*this, buff, false);
+  }
+
+  native_persistent_string record::to_string() const
+  {
+    util::string_builder buff;
+    to_string_impl(*this, buff, false);
+    return buff.release();
+  }
+
+  native_persistent_string record::to_code_string() const
+  {
+    util::string_builder buff;
+    to_string_impl(*this, buff, true);
+    return buff.release();
+  }
+
+  native_hash record::to_hash() const
+  {
+    if(hash)
+    {
+      return hash;
+    }
+
+    if(!type->is_record)
+    {
+      return hash = static_cast<native_hash>(reinterpret_cast<uintptr_t>(this));
+    }
+    return hash = hash::combine(type->name->to_hash(), to_map()->to_hash());
+  }
+
+  object_ptr record::get(object_ptr const key, object_ptr const fallback) const
+  {
+    auto const index(type->field_index(key));
+    if(index.is_some())
+    {
+      return fields()[index.unwrap()];
+    }
+    if(extension)
+    {
+      return extension->get(key, fallback);
+    }
+    return fallback;
+  }
+
+  object_ptr record::get(object_ptr const key) const
+  {
+    return get(key, nil::nil_const());
+  }
+
+  object_ptr record::get(lookup_site &site, object_ptr const key, object_ptr const fallback) const
+  {
+    /* The site only changes from one valid entry to another, so there's no need for
+     * anything stronger than relaxed ordering. */
+    auto const cached(site.type_and_index.load(std::memory_order_relaxed));
+    if((cached >> 16) == type->id)
+    {
+      return fields()[cached & record_type::max_fields];
+    }
+
+    auto const index(type->field_index(key));
+    if(index.is_none())
+    {
+      return get(key, fallback);
+    }
+
+    site.type_and_index.store((type->id << 16) | index.unwrap(), std::memory_order_relaxed);
+    return fields()[index.unwrap()];
+  }
+
+  object_ptr record::get_entry(object_ptr const key) const
+  {
+    auto const index(type->field_index(key));
+    if(index.is_some())
+    {
+      return make_box<persistent_vector>(std::in_place, key, fields()[index.unwrap()]);
+    }
+    if(extension)
+    {
+      return extension->get_entry(key);
+    }
+    return nil::nil_const();
+  }
+
+  native_bool record::contains(object_ptr const key) const
+  {
+    return type->field_index(key).is_some() || (extension && extension->contains(key));
+  }
+
+  object_ptr record::assoc(object_ptr const key, object_ptr const val) const
+  {
+    check_is_record("assoc");
+
+    auto const ret(clone());
+    auto const index(type->field_index(key));
+    if(index.is_some())
+    {
+      ret->fields()[index.unwrap()] = val;
+    }
+    else
+    {
+      ret->extension = (extension ? extension : persistent_hash_map::empty())->assoc(key, val);
+    }
+    return ret;
+  }
+
+  /* Like Clojure, removing a field means this is no longer a record, so we return a map. */
+  object_ptr record::dissoc(object_ptr const key) const
+  {
+    check_is_record("dissoc");
+
+    if(type->field_index(key).is_some())
+    {
+      return to_map()->dissoc(key);
+    }
+    if(!extension || !extension->contains(key))
+    {
+      return this;
+    }
+
+    auto const ret(clone());
+    ret->extension = extension->dissoc(key);
+    if(ret->extension->count() == 0)
+    {
+      ret->extension = nullptr;
+    }
+    return ret;
+  }
+
+  object_ptr record::conj(object_ptr const head) const
+  {
+    check_is_record("conj");
+
+    if(head == nil::nil_const())
+    {
+      return this;
+    }
+
+    if(head->type == object_type::persistent_vector)
+    {
+      auto const vec(expect_object<persistent_vector>(head));
+      if(vec->count() != 2)
+      {
+        throw std::runtime_error{ fmt::format("invalid map entry: {}", runtime::to_string(head)) };
+      }
+      return assoc(vec->data[0], vec->data[1]);
+    }
+
+    return visit_map_like(
+      [&](auto const typed_head) -> object_ptr {
+        object_ptr ret{ this };
+        for(auto const &entry : typed_head->data)
+        {
+          ret = runtime::assoc(ret, entry.first, entry.second);
+        }
+        return ret;
+      },
+      [&]() -> object_ptr {
+        throw std::runtime_error{ fmt::format("invalid map entry: {}", runtime::to_string(head)) };
+      },
+      head);
+  }
+
+  size_t record::count() const
+  {
+    check_is_record("count");
+    return type->fields.size() + (extension ? extension->count() : 0);
+  }
+
+  native_box<persistent_hash_map_sequence> record::seq() const
+  {
+    check_is_record("seq");
+    return to_map()->seq();
+  }
+
+  native_box<persistent_hash_map_sequence> record::fresh_seq() const
+  {
+    check_is_record("seq");
+    return to_map()->fresh_seq();
+  }
+
+  record_ptr record::with_meta(object_ptr const m) const
+  {
+    auto const meta(behavior::detail::validate_meta(m));
+    auto const ret(clone());
+    ret->meta = meta;
+    return ret;
+  }
+
+  persistent_hash_map_ptr record::to_map() const
+  {
+    auto transient(extension ? extension->data.transient()
+                             : runtime::detail::native_transient_hash_map{});
+    for(size_t i{}; i < type->fields.size(); ++i)
+    {
+      transient.set(type->fields[i], fields()[i]);
+    }
+    return make_box<persistent_hash_map>(meta, transient.persistent());
+  }
+}
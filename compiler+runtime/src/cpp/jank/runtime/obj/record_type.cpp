@@ -0,0 +1,87 @@
+#include <atomic>
+
+#include <fmt/format.h>
+
+#include <jank/native_persistent_string/fmt.hpp>
+#include <jank/runtime/obj/record_type.hpp>
+#include <jank/runtime/obj/keyword.hpp>
+#include <jank/runtime/obj/symbol.hpp>
+#include <jank/runtime/obj/persistent_vector.hpp>
+#include <jank/runtime/rtti.hpp>
+#include <jank/runtime/visit.hpp>
+#include <jank/runtime/core.hpp>
+
+namespace jank::runtime::obj
+{
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static std::atomic<uint64_t> next_id{ 1 };
+
+  record_type::record_type(object_ptr const name, object_ptr const fields, native_bool is_record)
+    : name{ try_object<symbol>(name) }
+    , is_record{ is_record }
+    , id{ next_id++ }
+  {
+    runtime::detail::native_transient_vector transient;
+    visit_seqable(
+      [&](auto const typed_fields) {
+        for(auto it(typed_fields->fresh_seq()); it != nullptr; it = runtime::next_in_place(it))
+        {
+          auto const field(it->first());
+          if(field->type != object_type::keyword)
+          {
+            throw std::runtime_error{ fmt::format("invalid field for {}: {}",
+                                                  this->name->to_string(),
+                                                  runtime::to_code_string(field)) };
+          }
+          this->fields.emplace_back(field);
+          transient.push_back(field);
+        }
+      },
+      fields);
+
+    if(this->fields.size() > max_fields)
+    {
+      throw std::runtime_error{ fmt::format("too many fields for {}: {}",
+                                            this->name->to_string(),
+                                            this->fields.size()) };
+    }
+    basis = make_box<persistent_vector>(transient.persistent());
+  }
+
+  native_bool record_type::equal(object const &o) const
+  {
+    return &base == &o;
+  }
+
+  void record_type::to_string(util::string_builder &buff) const
+  {
+    name->to_string(buff);
+  }
+
+  native_persistent_string record_type::to_string() const
+  {
+    return name->to_string();
+  }
+
+  native_persistent_string record_type::to_code_string() const
+  {
+    return name->to_code_string();
+  }
+
+  native_hash record_type::to_hash() const
+  {
+    return static_cast<native_hash>(reinterpret_cast<uintptr_t>(this));
+  }
+
+  option<size_t> record_type::field_index(object_ptr const key) const
+  {
+    for(size_t i{}; i < fields.size(); ++i)
+    {
+      if(fields[i] == key)
+      {
+        return i;
+      }
+    }
+    return none;
+  }
+}
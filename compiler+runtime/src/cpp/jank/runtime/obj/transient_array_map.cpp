@@ -0,0 +1,209 @@
+#include <cstring>
+
+#include <fmt/format.h>
+
+#include <jank/native_persistent_string/fmt.hpp>
+#include <jank/runtime/obj/transient_array_map.hpp>
+#include <jank/runtime/obj/transient_hash_map.hpp>
+#include <jank/runtime/obj/persistent_array_map.hpp>
+#include <jank/runtime/obj/persistent_hash_map.hpp>
+#include <jank/runtime/obj/persistent_vector.hpp>
+#include <jank/runtime/obj/nil.hpp>
+#include <jank/runtime/rtti.hpp>
+#include <jank/runtime/core/to_string.hpp>
+#include <jank/runtime/core/seq.hpp>
+
+namespace jank::runtime::obj
+{
+  transient_array_map::transient_array_map()
+  {
+    data.data = new(GC) object_ptr[max_size * 2];
+  }
+
+  transient_array_map::transient_array_map(value_type const &d)
+    : data{ d }
+  {
+    data.data = new(GC) object_ptr[max_size * 2];
+    memcpy(data.data, d.data, d.length * sizeof(object_ptr));
+  }
+
+  transient_array_map_ptr transient_array_map::empty()
+  {
+    return make_box<transient_array_map>();
+  }
+
+  native_bool transient_array_map::equal(object const &o) const
+  {
+    /* Transient equality, in Clojure, is based solely on identity. */
+    return &base == &o;
+  }
+
+  void transient_array_map::to_string(util::string_builder &buff) const
+  {
+    auto inserter(std::back_inserter(buff));
+    fmt::format_to(inserter, "{}@{}", object_type_str(base.type), fmt::ptr(&base));
+  }
+
+  native_persistent_string transient_array_map::to_string() const
+  {
+    util::string_builder buff;
+    to_string(buff);
+    return buff.release();
+  }
+
+  native_persistent_string transient_array_map::to_code_string() const
+  {
+    return to_string();
+  }
+
+  native_hash transient_array_map::to_hash() const
+  {
+    /* Hash is also based only on identity. Clojure uses default hashCode, which does the same. */
+    return static_cast<native_hash>(reinterpret_cast<uintptr_t>(this));
+  }
+
+  size_t transient_array_map::count() const
+  {
+    assert_active();
+    return data.size();
+  }
+
+  object_ptr transient_array_map::get(object_ptr const key) const
+  {
+    assert_active();
+    auto const res(data.find(key));
+    if(res)
+    {
+      return res;
+    }
+    return nil::nil_const();
+  }
+
+  object_ptr transient_array_map::get(object_ptr const key, object_ptr const fallback) const
+  {
+    assert_active();
+    auto const res(data.find(key));
+    if(res)
+    {
+      return res;
+    }
+    return fallback;
+  }
+
+  object_ptr transient_array_map::get_entry(object_ptr const key) const
+  {
+    assert_active();
+    auto const res(data.find(key));
+    if(res)
+    {
+      return make_box<persistent_vector>(std::in_place, key, res);
+    }
+    return nil::nil_const();
+  }
+
+  native_bool transient_array_map::contains(object_ptr const key) const
+  {
+    assert_active();
+    return data.find(key);
+  }
+
+  object_ptr transient_array_map::assoc_in_place(object_ptr const key, object_ptr const val)
+  {
+    assert_active();
+
+    auto const i(data.index_of(key));
+    if(i < data.length)
+    {
+      data.data[i + 1] = val;
+      data.hash = 0;
+      return this;
+    }
+
+    if(data.size() < max_size)
+    {
+      data.data[data.length] = key;
+      data.data[data.length + 1] = val;
+      data.length += 2;
+      data.hash = 0;
+      return this;
+    }
+
+    /* We're full, so we hand everything over to a hash map. This transient is done. */
+    active = false;
+    auto const ret(make_box<transient_hash_map>(data));
+    ret->assoc_in_place(key, val);
+    return ret;
+  }
+
+  transient_array_map_ptr transient_array_map::dissoc_in_place(object_ptr const key)
+  {
+    assert_active();
+    data.erase(key);
+    return this;
+  }
+
+  object_ptr transient_array_map::conj_in_place(object_ptr const head)
+  {
+    assert_active();
+
+    /* Each assoc may promote us, so we need to keep following the result. */
+    if(head->type == object_type::persistent_array_map)
+    {
+      object_ptr ret{ this };
+      for(auto const &pair : expect_object<persistent_array_map>(head)->data)
+      {
+        ret = runtime::assoc_in_place(ret, pair.first, pair.second);
+      }
+      return ret;
+    }
+    else if(head->type == object_type::persistent_hash_map)
+    {
+      object_ptr ret{ this };
+      for(auto const &pair : expect_object<persistent_hash_map>(head)->data)
+      {
+        ret = runtime::assoc_in_place(ret, pair.first, pair.second);
+      }
+      return ret;
+    }
+
+    if(head->type != object_type::persistent_vector)
+    {
+      throw std::runtime_error{ fmt::format("invalid map entry: {}", runtime::to_string(head)) };
+    }
+
+    auto const vec(expect_object<persistent_vector>(head));
+    if(vec->count() != 2)
+    {
+      throw std::runtime_error{ fmt::format("invalid map entry: {}", runtime::to_string(head)) };
+    }
+
+    return assoc_in_place(vec->data[0], vec->data[1]);
+  }
+
+  transient_array_map::persistent_type_ptr transient_array_map::to_persistent()
+  {
+    assert_active();
+    active = false;
+    /* The array is handed over as is. Since we're no longer active, nothing will write to
+     * it again, and the persistent map copies before any changes. */
+    return make_box<persistent_array_map>(std::move(data));
+  }
+
+  object_ptr transient_array_map::call(object_ptr const o) const
+  {
+    return get(o);
+  }
+
+  object_ptr transient_array_map::call(object_ptr const o, object_ptr const fallback) const
+  {
+    return get(o, fallback);
+  }
+
+  void transient_array_map::assert_active() const
+  {
+    if(!active)
+    {
+      throw std::runtime_error{ "transient used after it's been made persistent" };
+    }
+  }
+}
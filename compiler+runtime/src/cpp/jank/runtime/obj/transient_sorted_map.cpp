@@ -71,7 +71,7 @@ namespace jank::runtime::obj
   {
     assert_active();
     auto const res(data.find(key));
-    if(res != data.end())
+    if(res)
     {
       return res->second;
     }
@@ -82,7 +82,7 @@ namespace jank::runtime::obj
   {
     assert_active();
     auto const res(data.find(key));
-    if(res != data.end())
+    if(res)
     {
       return res->second;
     }
@@ -93,7 +93,7 @@ namespace jank::runtime::obj
   {
     assert_active();
     auto const res(data.find(key));
-    if(res != data.end())
+    if(res)
     {
       return make_box<persistent_vector>(std::in_place, key, res->second);
     }
@@ -103,7 +103,7 @@ namespace jank::runtime::obj
   native_bool transient_sorted_map::contains(object_ptr const key) const
   {
     assert_active();
-    return data.find(key) != data.end();
+    return data.find(key) != nullptr;
   }
 
   transient_sorted_map_ptr
@@ -81,9 +81,9 @@ namespace jank::runtime::obj
   {
     assert_active();
     auto const found(data.find(elem));
-    if(found != data.end())
+    if(found)
     {
-      return found.get();
+      return *found;
     }
     return nil::nil_const();
   }
@@ -92,9 +92,9 @@ namespace jank::runtime::obj
   {
     assert_active();
     auto const found(data.find(elem));
-    if(found != data.end())
+    if(found)
     {
-      return found.get();
+      return *found;
     }
     return fallback;
   }
@@ -124,7 +124,7 @@ namespace jank::runtime::obj
   native_bool transient_sorted_set::contains(object_ptr const elem) const
   {
     assert_active();
-    return data.find(elem) != data.end();
+    return data.find(elem) != nullptr;
   }
 
   transient_sorted_set_ptr transient_sorted_set::disjoin_in_place(object_ptr const elem)
@@ -0,0 +1,142 @@
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+#include <jank/runtime/obj/writer.hpp>
+
+namespace jank::runtime::obj
+{
+  static void write_fd(void * const data, char const *s, size_t size)
+  {
+    auto const fd(*static_cast<int const *>(data));
+
+    /* Some of our own output, such as error reporting, still goes through stdio. Anything
+     * it has buffered was written before this, so it needs to come out first. */
+    if(fd == STDOUT_FILENO)
+    {
+      std::fflush(stdout);
+    }
+    else if(fd == STDERR_FILENO)
+    {
+      std::fflush(stderr);
+    }
+
+    while(size != 0)
+    {
+      auto const written(::write(fd, s, size));
+      if(written < 0)
+      {
+        if(errno == EINTR)
+        {
+          continue;
+        }
+        throw std::runtime_error{ fmt::format("unable to write to fd {}: {}",
+                                              fd,
+                                              std::strerror(errno)) };
+      }
+      s += written;
+      size -= static_cast<size_t>(written);
+    }
+  }
+
+  writer::writer()
+    : buffer{ util::string_builder::initial_capacity }
+  {
+  }
+
+  writer::writer(int const fd, native_bool const auto_flush)
+    : fd{ fd }
+    , auto_flush{ auto_flush }
+    , buffer{ buffer_size }
+  {
+    buffer.sink = &write_fd;
+    buffer.sink_data = &this->fd;
+  }
+
+  writer::writer(util::string_builder::sink_fn const sink, void * const sink_data)
+    : buffer{ buffer_size }
+  {
+    buffer.sink = sink;
+    buffer.sink_data = sink_data;
+  }
+
+  native_bool writer::equal(object const &o) const
+  {
+    return &o == &base;
+  }
+
+  native_persistent_string writer::to_string()
+  {
+    util::string_builder buff;
+    to_string(buff);
+    return buff.release();
+  }
+
+  /* Like a StringWriter on the JVM, a string writer's string is what it has collected. */
+  void writer::to_string(util::string_builder &buff)
+  {
+    if(!is_string_writer())
+    {
+      fmt::format_to(std::back_inserter(buff), "{}@{}", object_type_str(base.type), fmt::ptr(&base));
+      return;
+    }
+
+    std::lock_guard<std::recursive_mutex> const lock{ mutex };
+    /* Printing a writer into itself would read from the buffer as it grows. */
+    if(&buff == &buffer)
+    {
+      buff(buffer.str());
+    }
+    else
+    {
+      buff(buffer.view());
+    }
+  }
+
+  native_persistent_string writer::to_code_string()
+  {
+    return to_string();
+  }
+
+  native_hash writer::to_hash() const
+  {
+    return static_cast<native_hash>(reinterpret_cast<uintptr_t>(this));
+  }
+
+  void writer::write(native_persistent_string_view const &s)
+  {
+    std::lock_guard<std::recursive_mutex> const lock{ mutex };
+    buffer(s);
+    wrote();
+  }
+
+  void writer::write(char const c)
+  {
+    std::lock_guard<std::recursive_mutex> const lock{ mutex };
+    buffer(c);
+    wrote();
+  }
+
+  void writer::wrote()
+  {
+    if(auto_flush)
+    {
+      flush();
+    }
+  }
+
+  void writer::flush()
+  {
+    std::lock_guard<std::recursive_mutex> const lock{ mutex };
+    buffer.drain();
+  }
+
+  native_bool writer::is_string_writer() const
+  {
+    return fd < 0 && !buffer.sink;
+  }
+}
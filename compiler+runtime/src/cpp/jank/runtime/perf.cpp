@@ -1,3 +1,5 @@
+#include <limits>
+
 #include <nanobench.h>
 
 #include <fmt/format.h>
@@ -7,6 +9,10 @@
 #include <jank/runtime/visit.hpp>
 #include <jank/runtime/context.hpp>
 #include <jank/runtime/core/seq.hpp>
+#include <jank/runtime/obj/persistent_array_map.hpp>
+#include <jank/runtime/obj/persistent_hash_map.hpp>
+#include <jank/runtime/obj/symbol.hpp>
+#include <jank/profile/allocation.hpp>
 
 namespace jank::runtime::perf
 {
@@ -48,4 +54,45 @@ namespace jank::runtime::perf
       label_str);
     return obj::nil::nil_const();
   }
+
+  static object_ptr make_stats(profile::allocation::stats const &s)
+  {
+    return obj::persistent_array_map::create_unique(
+      __rt_ctx->intern_keyword("count").expect_ok(),
+      make_box(static_cast<native_integer>(s.count)),
+      __rt_ctx->intern_keyword("bytes").expect_ok(),
+      make_box(static_cast<native_integer>(s.bytes)));
+  }
+
+  object_ptr allocations()
+  {
+    runtime::detail::native_transient_hash_map types;
+    for(size_t i{}; i <= std::numeric_limits<uint8_t>::max(); ++i)
+    {
+      auto const type(static_cast<object_type>(i));
+      auto const s(profile::allocation::type_stats(type));
+      if(s.count != 0)
+      {
+        types.set(__rt_ctx->intern_keyword(object_type_str(type)).expect_ok(), make_stats(s));
+      }
+    }
+
+    runtime::detail::native_transient_hash_map fns;
+    for(auto const &f : profile::allocation::all_function_stats())
+    {
+      fns.set(make_box<obj::symbol>(f.name), make_stats(f.totals));
+    }
+
+    return obj::persistent_array_map::create_unique(
+      __rt_ctx->intern_keyword("types").expect_ok(),
+      make_box<obj::persistent_hash_map>(types.persistent()),
+      __rt_ctx->intern_keyword("functions").expect_ok(),
+      make_box<obj::persistent_hash_map>(fns.persistent()));
+  }
+
+  object_ptr reset_allocations()
+  {
+    profile::allocation::reset();
+    return obj::nil::nil_const();
+  }
 }
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <fmt/compile.h>
 
 #include <jank/runtime/var.hpp>
@@ -32,13 +34,11 @@ namespace jank::runtime
   var::var(ns_ptr const &n,
            obj::symbol_ptr const &name,
            object_ptr const root,
-           native_bool const dynamic,
-           native_bool const thread_bound)
+           native_bool const dynamic)
     : n{ n }
     , name{ name }
     , root{ root }
     , dynamic{ dynamic }
-    , thread_bound{ thread_bound }
   {
   }
 
@@ -146,30 +146,78 @@ namespace jank::runtime
     return this;
   }
 
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static std::atomic<uint32_t> next_binding_slot{ 1 };
+
+  /* These are trivially initialized, so reading them doesn't need any TLS init checks. The
+   * array is uncollectable GC memory, since we can't rely on the GC scanning thread locals. */
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static thread_local var_thread_binding **thread_binding_slots{};
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static thread_local uint32_t thread_binding_slot_capacity{};
+
+  struct thread_binding_slots_cleanup
+  {
+    ~thread_binding_slots_cleanup()
+    {
+      GC_FREE(thread_binding_slots);
+      thread_binding_slots = nullptr;
+      thread_binding_slot_capacity = 0;
+    }
+  };
+
+  static void grow_thread_binding_slots(uint32_t const slot)
+  {
+    /* This is only here to free the array when the thread exits. */
+    /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+    static thread_local thread_binding_slots_cleanup const cleanup;
+    static_cast<void>(cleanup);
+
+    auto const capacity(std::max<uint32_t>(slot + 1, thread_binding_slot_capacity * 2));
+    auto const slots(
+      static_cast<var_thread_binding **>(GC_MALLOC_UNCOLLECTABLE(capacity * sizeof(void *))));
+    if(!slots)
+    {
+      throw std::runtime_error{ "unable to allocate thread binding slots" };
+    }
+    std::copy_n(thread_binding_slots, thread_binding_slot_capacity, slots);
+    std::fill(slots + thread_binding_slot_capacity, slots + capacity, nullptr);
+    GC_FREE(thread_binding_slots);
+    thread_binding_slots = slots;
+    thread_binding_slot_capacity = capacity;
+  }
+
   var_thread_binding_ptr var::get_thread_binding() const
   {
-    if(!thread_bound.load())
+    auto const slot(binding_slot.load(std::memory_order_relaxed));
+    if(slot == 0 || thread_binding_slot_capacity <= slot)
     {
       return nullptr;
     }
+    return thread_binding_slots[slot];
+  }
 
-    assert(n);
-    auto &tbfs(n->rt_ctx.thread_binding_frames[&n->rt_ctx]);
-    if(tbfs.empty())
+  var_thread_binding_ptr var::swap_thread_binding(var_thread_binding_ptr const binding)
+  {
+    auto slot(binding_slot.load());
+    if(slot == 0)
     {
-      return nullptr;
+      auto const fresh(next_binding_slot.fetch_add(1));
+      /* If we lose the race, slot is updated to the winner's. */
+      if(binding_slot.compare_exchange_strong(slot, fresh))
+      {
+        slot = fresh;
+      }
     }
 
-    assert(tbfs.front().bindings);
-    auto const found(tbfs.front().bindings->get_entry(this));
-    if(found == obj::nil::nil_const())
+    if(thread_binding_slot_capacity <= slot)
     {
-      return nullptr;
+      grow_thread_binding_slots(slot);
     }
 
-    auto const ret(expect_object<obj::persistent_vector>(found)->data[1]);
-    assert(ret);
-    return expect_object<var_thread_binding>(ret);
+    auto const previous(thread_binding_slots[slot]);
+    thread_binding_slots[slot] = binding.data;
+    return previous;
   }
 
   object_ptr var::deref() const
@@ -185,7 +233,10 @@ namespace jank::runtime
 
   var_ptr var::clone() const
   {
-    return make_box<var>(n, name, get_root(), dynamic.load(), thread_bound.load());
+    auto const ret(make_box<var>(n, name, get_root(), dynamic.load()));
+    /* Clones are equal to the original, so they share its bindings. */
+    ret->binding_slot.store(binding_slot.load());
+    return ret;
   }
 
   var_thread_binding::var_thread_binding(object_ptr const value, std::thread::id const id)
@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <gc/gc.h>
+
+#include <jank/util/arena.hpp>
+
+namespace jank::util
+{
+  static size_t align_up(size_t const size)
+  {
+    return (size + arena::alignment - 1) & ~(arena::alignment - 1);
+  }
+
+  static arena::chunk *allocate_chunk(size_t const capacity)
+  {
+    /* Uncollectable memory is scanned for pointers, but never collected, and it comes
+     * back zeroed. */
+    auto const mem(GC_MALLOC_UNCOLLECTABLE(align_up(sizeof(arena::chunk)) + capacity));
+    if(!mem)
+    {
+      throw std::runtime_error{ "unable to allocate arena chunk" };
+    }
+    auto const ret(new(mem) arena::chunk{});
+    ret->capacity = capacity;
+    return ret;
+  }
+
+  char *arena::chunk::data()
+  {
+    return reinterpret_cast<char *>(this) + align_up(sizeof(chunk));
+  }
+
+  arena::arena()
+    : first{ allocate_chunk(chunk_size) }
+    , current{ first }
+  {
+  }
+
+  arena::~arena()
+  {
+    reset();
+    GC_FREE(first);
+  }
+
+  void *arena::allocate(size_t const size)
+  {
+    auto const aligned_size(align_up(size));
+    if(current->capacity - current->used < aligned_size)
+    {
+      /* Anything bigger than a chunk gets a chunk of its own. The rest of the current
+       * chunk is wasted, but that's bounded by the chunk size. */
+      auto const next(allocate_chunk(std::max(chunk_size, aligned_size)));
+      next->next = current;
+      current = next;
+    }
+
+    auto const ret(current->data() + current->used);
+    current->used += aligned_size;
+    return ret;
+  }
+
+  void arena::reset()
+  {
+    while(current != first)
+    {
+      auto const next(current->next);
+      GC_FREE(current);
+      current = next;
+    }
+
+    /* The first chunk is still scanned by the GC, so we need to clear it out to not keep
+     * anything alive which was only referenced from old allocations. This also keeps
+     * new allocations zeroed, just as with the GC. */
+    std::memset(first->data(), 0, first->used);
+    first->used = 0;
+  }
+
+  size_t arena::size() const
+  {
+    size_t ret{};
+    for(auto c(current); c; c = c->next)
+    {
+      ret += c->used;
+    }
+    return ret;
+  }
+
+  /* Arenas are owned by the thread which uses them, rather than by the scope, so that
+   * chunks can be reused from one scope to the next. */
+  struct thread_arenas
+  {
+    std::vector<std::unique_ptr<arena>> levels;
+    size_t depth{};
+    arena *current{};
+  };
+
+  static thread_arenas &get_thread_arenas()
+  {
+    /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+    static thread_local thread_arenas arenas;
+    return arenas;
+  }
+
+  arena *current_arena()
+  {
+    return get_thread_arenas().current;
+  }
+
+  void *arena_allocate(arena * const a, size_t const size)
+  {
+    if(a)
+    {
+      return a->allocate(size);
+    }
+
+    auto const ret(GC_MALLOC(size));
+    if(!ret)
+    {
+      throw std::bad_alloc{};
+    }
+    return ret;
+  }
+
+  arena_scope::arena_scope()
+  {
+    auto &arenas(get_thread_arenas());
+    if(arenas.depth == arenas.levels.size())
+    {
+      arenas.levels.emplace_back(std::make_unique<arena>());
+    }
+
+    allocations = arenas.levels[arenas.depth].get();
+    previous = arenas.current;
+    ++arenas.depth;
+    arenas.current = allocations;
+  }
+
+  arena_scope::~arena_scope()
+  {
+    auto &arenas(get_thread_arenas());
+    allocations->reset();
+    --arenas.depth;
+    arenas.current = previous;
+  }
+
+  void *arena_object::operator new(size_t const size, GCPlacement const placement)
+  {
+    auto const a(current_arena());
+    if(a)
+    {
+      return a->allocate(size);
+    }
+    return gc::operator new(size, placement);
+  }
+
+  void arena_object::operator delete(void *)
+  {
+  }
+
+  void arena_object::operator delete(void *, GCPlacement)
+  {
+  }
+}
@@ -25,9 +25,52 @@ namespace jank::util::cli
     cli.add_option("--profile-output",
                    opts.profiler_file,
                    "The file to write profile entries (will be overwritten).");
+    cli.add_flag("--profile-allocations",
+                 opts.alloc_profiler_enabled,
+                 "Enable allocation profiling. A report is printed to stderr on exit.");
+    cli.add_option("--profile-allocations-sample-rate",
+                   opts.alloc_profiler_sample_rate,
+                   "Record every Nth allocation, on each thread, when profiling allocations.")
+      ->check(CLI::PositiveNumber);
     cli.add_flag("--gc-incremental", opts.gc_incremental, "Enable incremental GC collection.");
+    cli.add_option("--gc-initial-heap-size",
+                   opts.gc_initial_heap_size,
+                   "The initial GC heap size, in bytes. GC_INITIAL_HEAP_SIZE also works.")
+      ->check(CLI::NonNegativeNumber);
+    cli.add_option("--gc-free-space-divisor",
+                   opts.gc_free_space_divisor,
+                   "Trades heap growth for collection frequency; higher means more frequent "
+                   "collections and a smaller heap. GC_FREE_SPACE_DIVISOR also works.")
+      ->check(CLI::PositiveNumber);
+    cli.add_option("--gc-markers",
+                   opts.gc_markers,
+                   "The number of parallel marker threads, including the main thread. "
+                   "GC_MARKERS also works.")
+      ->check(CLI::PositiveNumber);
+    cli.add_option("--gc-pause-target",
+                   opts.gc_pause_target_ms,
+                   "The target maximum GC pause, in milliseconds. Implies --gc-incremental. "
+                   "GC_PAUSE_TIME_TARGET also works.")
+      ->check(CLI::PositiveNumber);
+    cli.add_flag("--perf-map",
+                 opts.perf_map_enabled,
+                 "Write JIT compiled function symbols to /tmp/perf-<pid>.map for Linux perf.");
+    cli.add_flag("--jit-debug",
+                 opts.jit_debug_enabled,
+                 "Register JIT compiled code with GDB/LLDB through the JIT debug interface.");
     cli.add_option("-O,--optimization", opts.optimization_level, "The optimization level to use.")
       ->check(CLI::Range(0, 3));
+    cli.add_option("--target-cpu",
+                   opts.target_cpu,
+                   "The CPU to generate code for, both when JIT compiling and when compiling "
+                   "object files. When JIT compiling, this covers jank code and the C++ we "
+                   "compile, but not the JIT's own startup code. Use native for the host CPU. "
+                   "Defaults to a generic CPU.");
+    cli.add_flag("--direct-linking",
+                 opts.direct_linking,
+                 "Call functions held by vars directly, rather than through the var. Existing "
+                 "callers won't see the var being redefined, unless it's marked ^:redef or "
+                 "^:dynamic.");
 
     /* Native dependencies. */
     cli.add_option("-I,--include-dir",
@@ -64,6 +64,8 @@ namespace jank::util
 
   native_persistent_string const &
   binary_cache_dir(native_integer const optimization_level,
+                   native_persistent_string const &target_cpu,
+                   native_bool const direct_linking,
                    native_vector<native_persistent_string> const &includes,
                    native_vector<native_persistent_string> const &defines)
   {
@@ -73,13 +75,19 @@ namespace jank::util
       return res;
     }
 
-    return res = fmt::format("target/{}", binary_version(optimization_level, includes, defines));
+    return res = fmt::format("target/{}",
+                             binary_version(optimization_level,
+                                            target_cpu,
+                                            direct_linking,
+                                            includes,
+                                            defines));
   }
 
   /* The binary version is composed of two things:
    *
    * 1. The LLVM target triplet
-   * 2. A SHA256 hash of unique inputs
+   * 2. A SHA256 hash of unique inputs, such as the optimization level, target CPU,
+   *    and whether calls are directly linked
    *
    * The intention of the hash is to ensure that changes made to the compiler will
    * result in needing to recompile previous binary artifacts. The way that it's
@@ -89,6 +97,8 @@ namespace jank::util
    */
   native_persistent_string const &
   binary_version(native_integer const optimization_level,
+                 native_persistent_string const &target_cpu,
+                 native_bool const direct_linking,
                  native_vector<native_persistent_string> const &includes,
                  native_vector<native_persistent_string> const &defines)
   {
@@ -111,11 +121,13 @@ namespace jank::util
       sb(def);
     }
 
-    auto const input(fmt::format("{}.{}.{}.{}.{}",
+    auto const input(fmt::format("{}.{}.{}.{}.{}.{}.{}",
                                  JANK_VERSION,
                                  clang::getClangRevision(),
                                  JANK_JIT_FLAGS,
                                  optimization_level,
+                                 target_cpu,
+                                 direct_linking,
                                  sb.release()));
     res = fmt::format("{}-{}", llvm::sys::getDefaultTargetTriple(), util::sha256(input));
 
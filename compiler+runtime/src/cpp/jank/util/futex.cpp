@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+
+#if defined(__linux__)
+  #include <cerrno>
+  #include <ctime>
+  #include <linux/futex.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+#include <jank/util/futex.hpp>
+
+namespace jank::util::futex
+{
+#if defined(__linux__)
+  static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+
+  native_bool wait(std::atomic<uint32_t> &word,
+                   uint32_t const expected,
+                   option<std::chrono::nanoseconds> const &timeout)
+  {
+    timespec ts{};
+    timespec *ts_ptr{};
+    if(timeout.is_some())
+    {
+      auto const ns(std::max(timeout.unwrap().count(), std::chrono::nanoseconds::rep{}));
+      ts.tv_sec = static_cast<time_t>(ns / 1'000'000'000);
+      ts.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+      ts_ptr = &ts;
+    }
+
+    /* std::atomic<uint32_t> is just the word, so the kernel can use it directly. */
+    /* NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg) */
+    auto const ret(syscall(SYS_futex,
+                           reinterpret_cast<uint32_t *>(&word),
+                           FUTEX_WAIT_PRIVATE,
+                           expected,
+                           ts_ptr,
+                           nullptr,
+                           0));
+    return ret == 0 || errno != ETIMEDOUT;
+  }
+
+  void wake_all(std::atomic<uint32_t> &word)
+  {
+    /* NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg) */
+    syscall(SYS_futex,
+            reinterpret_cast<uint32_t *>(&word),
+            FUTEX_WAKE_PRIVATE,
+            std::numeric_limits<int>::max(),
+            nullptr,
+            nullptr,
+            0);
+  }
+#else
+  struct bucket
+  {
+    std::mutex lock;
+    std::condition_variable waiters;
+  };
+
+  static bucket &bucket_for(std::atomic<uint32_t> const &word)
+  {
+    /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+    static std::array<bucket, 64> buckets;
+    auto const address(reinterpret_cast<uintptr_t>(&word));
+    return buckets[(address >> 4) % buckets.size()];
+  }
+
+  native_bool wait(std::atomic<uint32_t> &word,
+                   uint32_t const expected,
+                   option<std::chrono::nanoseconds> const &timeout)
+  {
+    auto &b(bucket_for(word));
+    std::unique_lock<std::mutex> locked{ b.lock };
+    /* Wakers take the lock before notifying, so checking under the lock means we can't
+     * miss a change. */
+    if(word.load(std::memory_order_acquire) != expected)
+    {
+      return true;
+    }
+    if(timeout.is_none())
+    {
+      b.waiters.wait(locked);
+      return true;
+    }
+    return b.waiters.wait_for(locked, timeout.unwrap()) == std::cv_status::no_timeout;
+  }
+
+  void wake_all(std::atomic<uint32_t> &word)
+  {
+    auto &b(bucket_for(word));
+    {
+      std::lock_guard<std::mutex> const locked{ b.lock };
+    }
+    b.waiters.notify_all();
+  }
+#endif
+}
@@ -0,0 +1,42 @@
+#include <stdexcept>
+
+#include <jank/util/once.hpp>
+
+namespace jank::util
+{
+  once::once(native_bool const done)
+    : current{ done ? state::done : state::pending }
+  {
+  }
+
+  native_bool once::begin()
+  {
+    while(true)
+    {
+      auto expected(state::pending);
+      if(current.compare_exchange_strong(expected, state::running, std::memory_order_acq_rel))
+      {
+        owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        return true;
+      }
+      if(expected == state::done)
+      {
+        return false;
+      }
+
+      if(owner.load(std::memory_order_relaxed) == std::this_thread::get_id())
+      {
+        throw std::runtime_error{ "recursive realization" };
+      }
+      /* If it fails, it goes back to pending and we'll give it a shot ourselves. */
+      current.wait(state::running, std::memory_order_acquire);
+    }
+  }
+
+  void once::finish(state const s)
+  {
+    owner.store({}, std::memory_order_relaxed);
+    current.store(s, std::memory_order_release);
+    current.notify_all();
+  }
+}
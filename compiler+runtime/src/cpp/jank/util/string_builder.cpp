@@ -27,11 +27,23 @@ namespace jank::util
 
   static void maybe_realloc(string_builder &sb, size_t const additional_size)
   {
-    auto const required_size{ sb.pos + additional_size + 1 };
-    if(sb.capacity < required_size)
+    auto required_size{ sb.pos + additional_size + 1 };
+    if(sb.capacity >= required_size)
     {
-      realloc(sb, required_size);
+      return;
     }
+
+    if(sb.sink)
+    {
+      sb.drain();
+      required_size = additional_size + 1;
+      if(sb.capacity >= required_size)
+      {
+        return;
+      }
+    }
+
+    realloc(sb, required_size);
   }
 
   static void write(string_builder &sb, char const * const str, size_t const size)
@@ -201,6 +213,16 @@ namespace jank::util
     return *this;
   }
 
+  string_builder &string_builder::operator()(native_persistent_string_view const &d) &
+  {
+    auto const required{ d.size() };
+    maybe_realloc(*this, required);
+
+    write(*this, d.data(), required);
+
+    return *this;
+  }
+
   void string_builder::push_back(native_bool const d) &
   {
     (*this)(d);
@@ -261,6 +283,11 @@ namespace jank::util
     (*this)(d);
   }
 
+  void string_builder::push_back(native_persistent_string_view const &d) &
+  {
+    (*this)(d);
+  }
+
   void string_builder::reserve(size_t const new_capacity)
   {
     if(capacity < new_capacity)
@@ -312,4 +339,13 @@ namespace jank::util
     buffer[pos] = 0;
     return { buffer, pos };
   }
+
+  void string_builder::drain()
+  {
+    if(sink && pos != 0)
+    {
+      sink(sink_data, buffer, pos);
+      pos = 0;
+    }
+  }
 }
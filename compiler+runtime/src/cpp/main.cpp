@@ -20,16 +20,20 @@
 #include <jank/runtime/obj/persistent_string.hpp>
 #include <jank/runtime/obj/persistent_vector.hpp>
 #include <jank/runtime/detail/type.hpp>
+#include <jank/runtime/collector.hpp>
 #include <jank/analyze/processor.hpp>
 #include <jank/evaluate.hpp>
 #include <jank/jit/processor.hpp>
 #include <jank/profile/time.hpp>
+#include <jank/profile/allocation.hpp>
 #include <jank/error/report.hpp>
 #include <jank/util/scope_exit.hpp>
 #include <jank/util/string.hpp>
 
 #include <jank/compiler_native.hpp>
 #include <jank/perf_native.hpp>
+#include <jank/gc_native.hpp>
+#include <jank/async_native.hpp>
 #include <clojure/core_native.hpp>
 #include <clojure/string_native.hpp>
 
@@ -47,7 +51,9 @@ namespace jank
 
     {
       profile::timer const timer{ "eval user code" };
-      std::cout << runtime::to_code_string(__rt_ctx->eval_file(opts.target_file)) << "\n";
+      auto const res(__rt_ctx->eval_file(opts.target_file));
+      __rt_ctx->flush_output();
+      std::cout << runtime::to_code_string(res) << "\n";
     }
 
     //ankerl::nanobench::Config config;
@@ -179,6 +185,7 @@ namespace jank
         }
 
         auto const res(__rt_ctx->eval_file(path_tmp));
+        __rt_ctx->flush_output();
         fmt::println("{}", runtime::to_code_string(res));
       }
       /* TODO: Unify error handling. JEEZE! */
@@ -199,6 +206,7 @@ namespace jank
         jank::error::report(e);
       }
 
+      __rt_ctx->flush_output();
       input.clear();
       std::cout << "\n";
       le.setPrompt(get_prompt("=> "));
@@ -289,6 +297,7 @@ try
   /* The GC needs to enabled even before arg parsing, since our native types,
    * like strings, use the GC for allocations. It can still be configured later. */
   GC_set_all_interior_pointers(1);
+  runtime::collector::pre_configure(argc, argv);
   GC_enable();
 
   llvm::llvm_shutdown_obj const Y{};
@@ -304,20 +313,30 @@ try
   }
   auto const &opts(parse_result.expect_ok());
 
-  if(opts.gc_incremental)
-  {
-    GC_enable_incremental();
-  }
+  runtime::collector::configure(opts);
 
   profile::configure(opts);
+  profile::allocation::configure(opts);
   profile::timer const timer{ "main" };
 
   __rt_ctx = new(GC) runtime::context{ opts };
+  /* Whatever is still buffered in *out* and *err* needs to be written before we go. */
+  std::atexit([] {
+    try
+    {
+      __rt_ctx->flush_output();
+    }
+    catch(...)
+    {
+    }
+  });
 
   jank_load_clojure_core_native();
   jank_load_clojure_string_native();
   jank_load_jank_compiler_native();
   jank_load_jank_perf_native();
+  jank_load_jank_gc_native();
+  jank_load_jank_async_native();
 
   switch(opts.command)
   {
@@ -14,7 +14,9 @@
 #include <jank/runtime/obj/persistent_vector.hpp>
 #include <jank/runtime/obj/persistent_string.hpp>
 #include <jank/runtime/obj/keyword.hpp>
+#include <jank/runtime/obj/jit_function.hpp>
 #include <jank/runtime/context.hpp>
+#include <jank/runtime/collector.hpp>
 #include <jank/runtime/core/to_string.hpp>
 #include <jank/analyze/processor.hpp>
 #include <jank/jit/processor.hpp>
@@ -195,5 +197,99 @@ namespace jank::jit
       }
       fmt::print("tested {} jank files\n", test_count);
     }
+
+    TEST_CASE("direct linking")
+    {
+      util::scope_exit const reset{ []() { __rt_ctx->jit_prc.direct_linking = false; } };
+      __rt_ctx->jit_prc.direct_linking = true;
+
+      auto const res(__rt_ctx->eval_string(R"(
+        (defn direct-linking-callee [] :old)
+        (defn ^:redef direct-linking-redef-callee [] :old)
+        (defn direct-linking-caller []
+          [(direct-linking-callee) (direct-linking-redef-callee)])
+        (defn direct-linking-callee [] :new)
+        (defn ^:redef direct-linking-redef-callee [] :new)
+        (direct-linking-caller))"));
+      CHECK(runtime::equal(res, __rt_ctx->eval_string("[:old :new]")));
+    }
+
+    /* Finalizers queue modules for unloading, but nothing is removed until the next reclaim. */
+    static void collect_unloadable_code()
+    {
+      for(size_t i{}; i < 3; ++i)
+      {
+        runtime::collector::collect();
+        GC_invoke_finalizers();
+      }
+      __rt_ctx->jit_prc.unloadable_code.reclaim();
+    }
+
+    static size_t owner_id(native_persistent_string const &fn_name)
+    {
+      return runtime::expect_object<runtime::obj::jit_function>(__rt_ctx->eval_string(fn_name))
+        ->owner->id;
+    }
+
+    TEST_CASE("unloading")
+    {
+      auto &registry(__rt_ctx->jit_prc.unloadable_code);
+      auto const reclaimed_before(registry.reclaimed_count());
+
+      /* Every eval is its own module and each redefinition drops the previous function,
+       * so all but the latest of these modules are garbage once we're done. */
+      static constexpr size_t iterations{ 20 };
+      for(size_t i{}; i < iterations; ++i)
+      {
+        __rt_ctx->eval_string("(defn unloading-test-fn [] (fn [] :dropped))");
+        CHECK(runtime::equal(__rt_ctx->eval_string("((unloading-test-fn))"),
+                             __rt_ctx->intern_keyword("dropped").expect_ok()));
+      }
+      auto const tracked_before(registry.tracked_count());
+
+      collect_unloadable_code();
+
+      /* Boehm is conservative, so a stray word on the stack can keep any one module around.
+       * Across this many, though, most of the dropped functions' modules need to have gone. */
+      auto const reclaimed(registry.reclaimed_count() - reclaimed_before);
+      CHECK_LE(iterations / 2, reclaimed);
+      CHECK_LT(registry.tracked_count(), tracked_before);
+
+      /* Whatever is still referenced still works. */
+      CHECK(runtime::equal(__rt_ctx->eval_string("((unloading-test-fn))"),
+                           __rt_ctx->intern_keyword("dropped").expect_ok()));
+    }
+
+    TEST_CASE("direct linking keeps callees loaded")
+    {
+      util::scope_exit const reset{ []() { __rt_ctx->jit_prc.direct_linking = false; } };
+      __rt_ctx->jit_prc.direct_linking = true;
+
+      __rt_ctx->eval_string("(defn unloading-callee [] :old)");
+      auto const callee_id(owner_id("unloading-callee"));
+      __rt_ctx->eval_string("(defn unloading-caller [] (unloading-callee))");
+
+      /* The caller calls the callee's code directly, never through its function object, so
+       * it's the caller's module which needs to hold onto the callee's. */
+      auto const caller(runtime::expect_object<runtime::obj::jit_function>(
+        __rt_ctx->eval_string("unloading-caller")));
+      native_bool depends{};
+      for(auto it(caller->owner->dependencies); it != nullptr; it = it->next)
+      {
+        depends = depends || it->owner->id == callee_id;
+      }
+      CHECK(depends);
+
+      /* Now nothing but the caller's module refers to the old callee. */
+      __rt_ctx->eval_string("(defn unloading-callee [] :new)");
+      collect_unloadable_code();
+
+      {
+        std::lock_guard<std::mutex> const lock{ __rt_ctx->jit_prc.unloadable_code.mutex };
+        CHECK(__rt_ctx->jit_prc.unloadable_code.trackers.contains(callee_id));
+      }
+      CHECK(runtime::equal(__rt_ctx->eval_string("(unloading-caller)"),
+                           __rt_ctx->intern_keyword("old").expect_ok()));
+    }
   }
 }
@@ -45,6 +45,23 @@ SUBCASE("C string")
     CHECK_EQ(s.size(), 38);
   }
 }
+
+SUBCASE("Fill")
+{
+  SUBCASE("SSO")
+  {
+    native_persistent_string const s(5, 'x');
+    CHECK_EQ(s, "xxxxx");
+  }
+
+  SUBCASE("Long")
+  {
+    native_persistent_string const s(64 * 1024, 'x');
+    CHECK_EQ(s.size(), 64 * 1024);
+    CHECK_EQ(s[s.size() - 1], 'x');
+    CHECK_EQ(s.c_str()[s.size()], '\0');
+  }
+}
 }
 
 TEST_CASE("Find")
@@ -184,6 +201,16 @@ TEST_CASE("Substring")
       CHECK_EQ(sub, "o b");
     }
   }
+
+  SUBCASE("Shared")
+  {
+    native_transient_string const corpus(2048, 'x');
+    native_persistent_string const s{ corpus + "shared substring which is long" };
+    auto const sub(s.shared_substr(corpus.size()));
+    CHECK_EQ(sub, "shared substring which is long");
+    CHECK_EQ(sub.data(), s.data() + corpus.size());
+    CHECK_NE(s.substr(corpus.size()).data(), sub.data());
+  }
 }
 }
 ;
@@ -1,7 +1,10 @@
+#include <array>
+
 #include <jank/runtime/behavior/callable.hpp>
 #include <jank/runtime/core.hpp>
 #include <jank/runtime/core/make_box.hpp>
 #include <jank/runtime/context.hpp>
+#include <jank/runtime/obj/native_array_sequence.hpp>
 #include <jank/runtime/obj/persistent_list.hpp>
 #include <jank/runtime/obj/persistent_string.hpp>
 #include <jank/runtime/obj/symbol.hpp>
@@ -131,5 +134,41 @@ namespace jank::runtime
                                                           make_box('q'))),
                   make_box<obj::persistent_string>("fghijklmnopq")));
     }
+
+    TEST_CASE("rest params")
+    {
+      auto const f(__rt_ctx->eval_string("(fn* [a b & args] args)"));
+      std::array<object_ptr, 12> args;
+      for(size_t i{}; i < args.size(); ++i)
+      {
+        args[i] = make_box(static_cast<native_integer>(i));
+      }
+
+      /* Every arg count beyond the fixed params, across the fixed overloads and the array,
+       * packs the same rest seq. */
+      for(size_t count{ 3 }; count <= args.size(); ++count)
+      {
+        CAPTURE(count);
+        auto const rest(dynamic_call(f, args.data(), count));
+        REQUIRE(rest->type == object_type::native_array_sequence);
+        CHECK_EQ(sequence_length(rest), count - 2);
+
+        /* The rest of the rest seq points into the same allocation. */
+        auto const typed_rest(expect_object<obj::native_array_sequence>(rest));
+        CHECK(equal(typed_rest->first(), args[2]));
+        auto const tail(typed_rest->next());
+        if(count == 3)
+        {
+          CHECK_EQ(nullptr, tail);
+        }
+        else
+        {
+          CHECK(equal(tail->first(), args[3]));
+          CHECK_EQ(sequence_length(tail), count - 3);
+        }
+      }
+
+      CHECK(equal(dynamic_call(f, args[0], args[1]), obj::nil::nil_const()));
+    }
   }
 }
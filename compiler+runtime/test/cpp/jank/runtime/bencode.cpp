@@ -0,0 +1,247 @@
+#include <thread>
+
+#include <fmt/format.h>
+
+#include <jank/runtime/bencode.hpp>
+#include <jank/runtime/obj/persistent_string.hpp>
+#include <jank/runtime/obj/writer.hpp>
+#include <jank/runtime/collector.hpp>
+#include <jank/runtime/context.hpp>
+#include <jank/runtime/core.hpp>
+
+/* This must go last; doctest and glog both define CHECK and family. */
+#include <doctest/doctest.h>
+
+namespace jank::runtime::bencode
+{
+  TEST_SUITE("bencode")
+  {
+    /* Long enough that substrings of it aren't stored inline. */
+    static constexpr char const *long_string{
+      "a string which is much too long to fit in a small string"
+    };
+
+    static object_ptr message()
+    {
+      return __rt_ctx->eval_string(fmt::format(R"(
+        {{"op" "eval"
+          "id" 42
+          "negative" -9223372036854775807
+          "code" "{0}"
+          "empty" ""
+          "list" [1 "two" [] {{}} ["{0}"]]
+          "many" (zipmap (map str (range 20)) (range 20))}})",
+                                               long_string));
+    }
+
+    static decode_result decode_from(decoder &d, native_persistent_string const &input)
+    {
+      return d.decode_some(input, 0);
+    }
+
+    TEST_CASE("round trip")
+    {
+      for(auto const &code : { "0",
+                               "-1",
+                               "9223372036854775807",
+                               R"("")",
+                               R"("short")",
+                               "[]",
+                               "{}",
+                               R"([1 ["two" [3]]])",
+                               R"({"a" {"b" {"c" []}}})" })
+      {
+        CAPTURE(code);
+        auto const o(__rt_ctx->eval_string(code));
+        auto const res(decode(encode(o)));
+        REQUIRE(res.is_ok());
+        CHECK(equal(res.expect_ok(), o));
+      }
+
+      auto const m(message());
+      CHECK(equal(decode(encode(m)).expect_ok(), m));
+    }
+
+    TEST_CASE("encode")
+    {
+      /* Keys are sorted by their bytes, whatever they started out as. */
+      CHECK_EQ(encode(__rt_ctx->eval_string(R"({"b" 1 :a 2 'c 3 "B" 4})")),
+               "d1:Bi4e1:ai2e1:bi1e1:ci3ee");
+      CHECK_EQ(encode(__rt_ctx->eval_string(":ns/kw")), "5:ns/kw");
+      CHECK_EQ(encode(obj::nil::nil_const()), "le");
+      CHECK(equal(decode("le").expect_ok(), __rt_ctx->eval_string("[]")));
+      CHECK_EQ(decode("").expect_ok(), obj::nil::nil_const());
+      CHECK_THROWS(encode(__rt_ctx->eval_string("1.5")));
+      CHECK_THROWS(encode(__rt_ctx->eval_string("{1 2}")));
+    }
+
+    TEST_CASE("split at every offset")
+    {
+      auto const encoded(encode(message()));
+      auto const whole(decode(encoded).expect_ok());
+
+      for(size_t split{}; split <= encoded.size(); ++split)
+      {
+        CAPTURE(split);
+        decoder d;
+
+        auto const head(decode_from(d, encoded.substr(0, split)));
+        if(split < encoded.size())
+        {
+          REQUIRE(head.is_err());
+          CHECK(head.expect_err().reason == decode_error_reason::incomplete_data);
+          CHECK_EQ(d.is_partial(), split != 0);
+
+          auto const tail(encoded.substr(split));
+          auto const rest(decode_from(d, tail));
+          REQUIRE(rest.is_ok());
+          CHECK(equal(rest.expect_ok().first, whole));
+          CHECK_EQ(rest.expect_ok().second, tail.size());
+        }
+        else
+        {
+          REQUIRE(head.is_ok());
+          CHECK(equal(head.expect_ok().first, whole));
+        }
+        CHECK(!d.is_partial());
+      }
+
+      /* The worst case is every byte arriving on its own. */
+      decoder d;
+      object_ptr decoded{};
+      for(size_t i{}; i < encoded.size(); ++i)
+      {
+        auto const res(decode_from(d, encoded.substr(i, 1)));
+        if(res.is_ok())
+        {
+          CHECK_EQ(i, encoded.size() - 1);
+          decoded = res.expect_ok().first;
+        }
+      }
+      CHECK(equal(decoded, whole));
+    }
+
+    TEST_CASE("decode some")
+    {
+      auto const a(encode(__rt_ctx->eval_string(R"({"id" 1})")));
+      auto const b(encode(__rt_ctx->eval_string(R"({"id" 2})")));
+      auto const c(encode(__rt_ctx->eval_string(R"({"id" 3})")));
+      auto const first(a + b + c.substr(0, 5));
+
+      decoder d;
+      auto const res_a(d.decode_some(first, 0));
+      REQUIRE(res_a.is_ok());
+      CHECK_EQ(res_a.expect_ok().second, a.size());
+
+      auto const res_b(d.decode_some(first, res_a.expect_ok().second));
+      REQUIRE(res_b.is_ok());
+      CHECK(equal(res_b.expect_ok().first, __rt_ctx->eval_string(R"({"id" 2})")));
+      CHECK_EQ(res_b.expect_ok().second, a.size() + b.size());
+
+      auto const res_c(d.decode_some(first, res_b.expect_ok().second));
+      CHECK(res_c.is_err());
+      CHECK(d.is_partial());
+
+      auto const res_rest(d.decode_some(c.substr(5), 0));
+      REQUIRE(res_rest.is_ok());
+      CHECK(equal(res_rest.expect_ok().first, __rt_ctx->eval_string(R"({"id" 3})")));
+      CHECK(!d.is_partial());
+    }
+
+    TEST_CASE("shared slices")
+    {
+      auto const encoded(encode(message()));
+      auto const decoded(decode(encoded).expect_ok());
+      auto const code(expect_object<obj::persistent_string>(
+        runtime::get(decoded, make_box<obj::persistent_string>("code"))));
+      CHECK_EQ(code->data, long_string);
+
+      /* Strings within one piece of input point into it, rather than being copied. */
+      auto const within([](native_persistent_string const &s, native_persistent_string const &in) {
+        return in.data() <= s.data() && s.data() + s.size() <= in.data() + in.size();
+      });
+      CHECK(within(code->data, encoded));
+
+      /* Strings split across pieces are put back together. */
+      auto const start(encoded.find(long_string));
+      auto const head(encoded.substr(0, start + 10));
+      auto const tail(encoded.substr(start + 10));
+      decoder d;
+      CHECK(decode_from(d, head).is_err());
+      auto const joined(decode_from(d, tail).expect_ok().first);
+      auto const joined_code(expect_object<obj::persistent_string>(
+        runtime::get(joined, make_box<obj::persistent_string>("code"))));
+      CHECK_EQ(joined_code->data, long_string);
+      CHECK(!within(joined_code->data, head));
+      CHECK(!within(joined_code->data, tail));
+    }
+
+    TEST_CASE("invalid")
+    {
+      for(auto const &input : { "x", "i1xe", "ie", "i-e", "e", "d1:ae", "di1ei2ee", "1x" })
+      {
+        CAPTURE(input);
+        decoder d;
+        auto const res(decode_from(d, input));
+        REQUIRE(res.is_err());
+        CHECK(res.expect_err().reason == decode_error_reason::invalid_data);
+        CHECK(!d.is_partial());
+      }
+
+      CHECK(decode("i99999999999999999999e").is_err());
+    }
+
+    static void collect(void * const data, char const * const s, size_t const size)
+    {
+      static_cast<native_transient_string *>(data)->append(s, size);
+    }
+
+    TEST_CASE("encode_to")
+    {
+      static constexpr size_t count{ 50 };
+      native_transient_string out;
+      auto const w(make_box<obj::writer>(&collect, &out));
+
+      /* Each value is larger than the writer's buffer, so it's written out in pieces. The
+       * writer's lock keeps the pieces of values from separate threads apart. */
+      auto const value(fmt::format(R"((apply str (repeat {} "x")))", obj::writer::buffer_size));
+      auto const big(__rt_ctx->eval_string(fmt::format(R"({{"id" 1 "value" {}}})", value)));
+      auto const other(__rt_ctx->eval_string(R"({"id" 2 "value" [1 2 3]})"));
+
+      collector::allow_thread_registration();
+      std::thread second{ [=] {
+        collector::thread_registration const registration;
+        for(size_t i{}; i < count; ++i)
+        {
+          encode_to(w, other);
+        }
+      } };
+      for(size_t i{}; i < count; ++i)
+      {
+        encode_to(w, big);
+      }
+      second.join();
+      w->flush();
+
+      native_persistent_string const stream{ out };
+      decoder d;
+      size_t bigs{}, others{};
+      for(size_t offset{}; offset < stream.size();)
+      {
+        auto const res(d.decode_some(stream, offset));
+        REQUIRE(res.is_ok());
+        if(equal(res.expect_ok().first, big))
+        {
+          ++bigs;
+        }
+        else if(equal(res.expect_ok().first, other))
+        {
+          ++others;
+        }
+        offset = res.expect_ok().second;
+      }
+      CHECK_EQ(bigs, count);
+      CHECK_EQ(others, count);
+    }
+  }
+}
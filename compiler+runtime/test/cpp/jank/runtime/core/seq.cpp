@@ -1,7 +1,12 @@
 #include <jank/runtime/core.hpp>
 #include <jank/runtime/core/make_box.hpp>
+#include <jank/runtime/context.hpp>
 #include <jank/runtime/obj/persistent_vector.hpp>
 #include <jank/runtime/obj/persistent_list.hpp>
+#include <jank/runtime/obj/native_vector_sequence.hpp>
+#include <jank/runtime/obj/number.hpp>
+#include <jank/runtime/obj/keyword.hpp>
+#include <jank/runtime/obj/symbol.hpp>
 
 /* This must go last; doctest and glog both define CHECK and family. */
 #include <doctest/doctest.h>
@@ -32,5 +37,78 @@ namespace jank::runtime::core
         make_box<obj::persistent_vector>(std::in_place, make_box('f'), make_box('g')),
         make_box<obj::persistent_list>(std::in_place, make_box('g'))));
     }
+
+    TEST_CASE("sort")
+    {
+      auto const core_fn([](native_persistent_string const &name) {
+        return __rt_ctx->find_var(make_box<obj::symbol>("clojure.core", name)).unwrap()->deref();
+      });
+      auto const ints([](std::initializer_list<native_integer> const values) {
+        native_vector<object_ptr> ret;
+        for(auto const v : values)
+        {
+          ret.push_back(make_box<obj::integer>(v));
+        }
+        return make_box<obj::native_vector_sequence>(std::move(ret));
+      });
+
+      SUBCASE("integers, in parallel")
+      {
+        /* Large enough to be split into runs. 7919 is coprime with the size, so this is a
+         * shuffled permutation of [0, size). */
+        native_integer const size{ 1 << 18 };
+        native_vector<object_ptr> input;
+        for(native_integer i{}; i < size; ++i)
+        {
+          input.push_back(make_box<obj::integer>((i * 7919) % size));
+        }
+
+        native_integer expected{};
+        native_bool in_order{ true };
+        for(auto it(seq(sort(make_box<obj::native_vector_sequence>(std::move(input)))));
+            it != obj::nil::nil_const();
+            it = next(it))
+        {
+          in_order &= equal(first(it), make_box<obj::integer>(expected++));
+        }
+        CHECK(in_order);
+        CHECK(expected == size);
+      }
+
+      SUBCASE("keywords")
+      {
+        auto const a(__rt_ctx->intern_keyword("a").expect_ok());
+        auto const b(__rt_ctx->intern_keyword("b").expect_ok());
+        auto const z_a(__rt_ctx->intern_keyword("z", "a").expect_ok());
+        CHECK(equal(sort(make_box<obj::persistent_vector>(std::in_place, z_a, b, a)),
+                    make_box<obj::persistent_vector>(std::in_place, a, b, z_a)));
+      }
+
+      SUBCASE("mixed numbers")
+      {
+        CHECK(equal(sort(make_box<obj::persistent_vector>(std::in_place,
+                                                          make_box<obj::real>(2.5),
+                                                          make_box<obj::integer>(3),
+                                                          make_box<obj::integer>(1))),
+                    make_box<obj::persistent_vector>(std::in_place,
+                                                     make_box<obj::integer>(1),
+                                                     make_box<obj::real>(2.5),
+                                                     make_box<obj::integer>(3))));
+      }
+
+      SUBCASE("comparator")
+      {
+        CHECK(equal(sort(core_fn(">"), ints({ 2, 3, 1 })), ints({ 3, 2, 1 })));
+        CHECK(equal(sort(core_fn("compare"), ints({ 2, 3, 1 })), ints({ 1, 2, 3 })));
+      }
+
+      SUBCASE("keyfn")
+      {
+        CHECK(equal(sort_by(core_fn("-"), ints({ 2, 3, 1 })), ints({ 3, 2, 1 })));
+        CHECK(equal(sort_by(core_fn("-"), core_fn(">"), ints({ 2, 3, 1 })), ints({ 1, 2, 3 })));
+        /* Stable, so equal keys keep their order. */
+        CHECK(equal(sort_by(core_fn("even?"), ints({ 4, 1, 2, 3 })), ints({ 1, 3, 4, 2 })));
+      }
+    }
   }
 }
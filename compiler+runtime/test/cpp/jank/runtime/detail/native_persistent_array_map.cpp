@@ -0,0 +1,96 @@
+#include <nanobench.h>
+
+#include <fmt/format.h>
+
+#include <jank/runtime/detail/native_persistent_array_map.hpp>
+#include <jank/runtime/obj/persistent_array_map.hpp>
+#include <jank/runtime/obj/persistent_hash_map.hpp>
+#include <jank/runtime/obj/transient_hash_map.hpp>
+#include <jank/runtime/context.hpp>
+#include <jank/runtime/core.hpp>
+#include <jank/runtime/core/make_box.hpp>
+
+/* This must go last; doctest and glog both define CHECK and family. */
+#include <doctest/doctest.h>
+
+namespace jank::runtime::detail
+{
+  static obj::keyword_ptr make_keyword(size_t const i)
+  {
+    return __rt_ctx->intern_keyword(fmt::format("key-{}", i)).expect_ok();
+  }
+
+  static native_persistent_array_map make_map(size_t const pairs)
+  {
+    auto const kvs(new(GC) object_ptr[pairs * 2]);
+    for(size_t i{}; i < pairs; ++i)
+    {
+      kvs[i * 2] = make_keyword(i);
+      kvs[i * 2 + 1] = make_box(static_cast<native_integer>(i));
+    }
+    return { in_place_unique{}, kvs, pairs * 2 };
+  }
+
+  TEST_SUITE("native_persistent_array_map")
+  {
+    TEST_CASE("find keyword")
+    {
+      /* Odd sizes leave a pair after the last full compare. */
+      for(size_t pairs{}; pairs <= native_persistent_array_map::max_size; ++pairs)
+      {
+        auto const m(make_map(pairs));
+        for(size_t i{}; i < pairs; ++i)
+        {
+          CHECK(equal(m.find(make_keyword(i)), make_box(static_cast<native_integer>(i))));
+          CHECK(m.index_of(make_keyword(i)) == i * 2);
+        }
+        CHECK(m.find(make_keyword(pairs)) == nullptr);
+        CHECK(m.index_of(make_keyword(pairs)) == m.length);
+      }
+    }
+
+    TEST_CASE("find equal")
+    {
+      native_persistent_array_map m;
+      m.insert_unique(make_box("a"), make_box(1));
+      m.insert_unique(make_box(2), make_box(2));
+      m.insert_unique(make_box("c"), make_box(3));
+
+      /* Not identical, but equal. */
+      CHECK(equal(m.find(make_box("a")), make_box(1)));
+      CHECK(equal(m.find(make_box(2)), make_box(2)));
+      CHECK(equal(m.find(make_box("c")), make_box(3)));
+      CHECK(m.find(make_box("d")) == nullptr);
+      /* Values are never matched as keys. */
+      CHECK(m.find(make_box(1)) == nullptr);
+    }
+
+    /* This is for deciding on max_size, so it doesn't run by default. Run it with
+     * `jank-test --test-case="array map threshold" --no-skip`. */
+    TEST_CASE("array map threshold" * doctest::skip())
+    {
+      ankerl::nanobench::Bench bench;
+      bench.title("keyword lookup").relative(true).minEpochIterations(100000);
+
+      for(size_t const pairs : { 4, 8, 12, 16 })
+      {
+        auto const array_map(make_box<obj::persistent_array_map>(make_map(pairs)));
+        obj::transient_hash_map trans;
+        for(auto const &e : array_map->data)
+        {
+          trans.assoc_in_place(e.first, e.second);
+        }
+        auto const hash_map(trans.to_persistent());
+        /* The last key is the worst case for an array map. */
+        auto const key(make_keyword(pairs - 1));
+
+        bench.run(fmt::format("array map {}", pairs), [&] {
+          ankerl::nanobench::doNotOptimizeAway(array_map->get(key));
+        });
+        bench.run(fmt::format("hash map {}", pairs), [&] {
+          ankerl::nanobench::doNotOptimizeAway(hash_map->get(key));
+        });
+      }
+    }
+  }
+}
@@ -0,0 +1,129 @@
+#include <cstdlib>
+
+#include <jank/runtime/detail/type.hpp>
+#include <jank/runtime/obj/number.hpp>
+#include <jank/runtime/rtti.hpp>
+#include <jank/runtime/core.hpp>
+#include <jank/runtime/core/make_box.hpp>
+
+/* This must go last; doctest and glog both define CHECK and family. */
+#include <doctest/doctest.h>
+
+namespace jank::runtime::detail
+{
+  static native_vector<native_integer> keys(native_persistent_sorted_map const &m)
+  {
+    native_vector<native_integer> ret;
+    for(auto const &e : m)
+    {
+      ret.push_back(expect_object<obj::integer>(e.first)->data);
+    }
+    return ret;
+  }
+
+  /* Checks the AVL invariants for every node. */
+  template <typename N>
+  static uint8_t checked_height(N const * const n)
+  {
+    if(n == nullptr)
+    {
+      return 0;
+    }
+    auto const l(checked_height(n->left));
+    auto const r(checked_height(n->right));
+    CHECK(std::abs(static_cast<int>(l) - static_cast<int>(r)) <= 1);
+    CHECK(n->height == 1 + std::max(l, r));
+    return n->height;
+  }
+
+  TEST_SUITE("native_persistent_sorted_tree")
+  {
+    TEST_CASE("insert in order")
+    {
+      native_persistent_sorted_map m;
+      for(native_integer i{ 99 }; i >= 0; --i)
+      {
+        m = m.insert_or_assign(make_box(i * 7 % 100), make_box(i));
+      }
+      CHECK(m.size() == 100);
+      checked_height(m.root);
+
+      auto const ks(keys(m));
+      for(size_t i{}; i < ks.size(); ++i)
+      {
+        CHECK(ks[i] == static_cast<native_integer>(i));
+      }
+    }
+
+    TEST_CASE("persistence")
+    {
+      native_persistent_sorted_map m;
+      for(native_integer i{}; i < 32; ++i)
+      {
+        m = m.insert_or_assign(make_box(i), make_box(i));
+      }
+
+      auto const replaced(m.insert_or_assign(make_box(5), make_box(500)));
+      auto const erased(m.erase_key(make_box(10)));
+
+      CHECK(equal(m.find(make_box(5))->second, make_box(5)));
+      CHECK(equal(replaced.find(make_box(5))->second, make_box(500)));
+      CHECK(replaced.size() == 32);
+      CHECK(m.find(make_box(10)) != nullptr);
+      CHECK(erased.find(make_box(10)) == nullptr);
+      CHECK(erased.size() == 31);
+      checked_height(erased.root);
+
+      /* Missing keys leave the tree as it was. */
+      CHECK(m.erase_key(make_box(100)).root == m.root);
+    }
+
+    TEST_CASE("erase")
+    {
+      native_persistent_sorted_map m;
+      for(native_integer i{}; i < 64; ++i)
+      {
+        m = m.insert_or_assign(make_box(i), make_box(i));
+      }
+      for(native_integer i{}; i < 64; i += 2)
+      {
+        m = m.erase_key(make_box(i));
+        checked_height(m.root);
+      }
+
+      CHECK(m.size() == 32);
+      auto const ks(keys(m));
+      for(size_t i{}; i < ks.size(); ++i)
+      {
+        CHECK(ks[i] == static_cast<native_integer>(i * 2 + 1));
+      }
+    }
+
+    TEST_CASE("transient")
+    {
+      native_persistent_sorted_set s;
+      s = s.insert_v(make_box(1)).insert_v(make_box(2));
+
+      auto trans(s.transient());
+      for(native_integer i{}; i < 50; ++i)
+      {
+        trans.insert_v(make_box(i));
+      }
+      trans.erase_key(make_box(1));
+      auto const result(trans.persistent());
+
+      /* The original is untouched. */
+      CHECK(s.size() == 2);
+      CHECK(s.find(make_box(1)) != nullptr);
+      CHECK(s.find(make_box(3)) == nullptr);
+
+      CHECK(result.size() == 49);
+      CHECK(result.find(make_box(1)) == nullptr);
+      checked_height(result.root);
+
+      /* Changes after persistent! can't affect the persistent tree. */
+      trans.insert_v(make_box(100));
+      CHECK(result.find(make_box(100)) == nullptr);
+    }
+  }
+}
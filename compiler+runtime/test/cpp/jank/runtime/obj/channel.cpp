@@ -0,0 +1,155 @@
+#include <chrono>
+#include <thread>
+
+#include <jank/runtime/obj/channel.hpp>
+#include <jank/runtime/obj/persistent_vector.hpp>
+#include <jank/runtime/collector.hpp>
+#include <jank/runtime/core.hpp>
+
+/* This must go last; doctest and glog both define CHECK and family. */
+#include <doctest/doctest.h>
+
+namespace jank::runtime::obj
+{
+  TEST_SUITE("channel")
+  {
+    TEST_CASE("offer and poll")
+    {
+      auto const ch(make_box<channel>(2));
+      CHECK(ch->offer(make_box(1)));
+      CHECK(ch->offer(make_box(2)));
+      CHECK(!ch->offer(make_box(3)));
+      CHECK(equal(ch->poll(), make_box(1)));
+      CHECK(ch->offer(make_box(3)));
+      CHECK(equal(ch->poll(), make_box(2)));
+      CHECK(equal(ch->poll(), make_box(3)));
+      CHECK_EQ(ch->poll(), nullptr);
+    }
+
+    TEST_CASE("close")
+    {
+      auto const ch(make_box<channel>(2));
+      CHECK(ch->put(make_box(1)));
+      ch->close();
+      CHECK(!ch->put(make_box(2)));
+      CHECK(equal(ch->take(), make_box(1)));
+      CHECK_EQ(ch->take(), nil::nil_const());
+    }
+
+    TEST_CASE("blocking across threads")
+    {
+      static constexpr native_integer count{ 1000 };
+      auto const ch(make_box<channel>(4));
+
+      collector::allow_thread_registration();
+      std::thread producer{ [=] {
+        collector::thread_registration const registration;
+        for(native_integer i{}; i < count; ++i)
+        {
+          ch->put(make_box(i));
+        }
+        ch->close();
+      } };
+
+      native_integer sum{};
+      for(auto v(ch->take()); v != nil::nil_const(); v = ch->take())
+      {
+        sum += to_int(v);
+      }
+      producer.join();
+      CHECK_EQ(sum, count * (count - 1) / 2);
+    }
+
+    TEST_CASE("alts")
+    {
+      auto const a(make_box<channel>(1));
+      auto const b(make_box<channel>(1));
+      CHECK(b->offer(make_box(1)));
+
+      auto const ops(make_box<persistent_vector>(std::in_place, object_ptr{ a }, object_ptr{ b }));
+
+      auto const taken(channel::alts(ops, true, none));
+      CHECK(equal(taken->data[0], make_box(1)));
+      CHECK_EQ(taken->data[1], object_ptr{ b });
+
+      auto const fallback(channel::alts(ops, true, object_ptr{ make_box(2) }));
+      CHECK(equal(fallback->data[0], make_box(2)));
+    }
+
+    TEST_CASE("alts blocking across threads")
+    {
+      collector::allow_thread_registration();
+
+      SUBCASE("take")
+      {
+        auto const a(make_box<channel>(1));
+        auto const b(make_box<channel>(1));
+        auto const ops(
+          make_box<persistent_vector>(std::in_place, object_ptr{ a }, object_ptr{ b }));
+
+        /* The sleep gives alts time to find nothing ready and park on both channels. */
+        std::thread producer{ [=] {
+          collector::thread_registration const registration;
+          std::this_thread::sleep_for(std::chrono::milliseconds{ 50 });
+          b->put(make_box(1));
+        } };
+        auto const taken(channel::alts(ops, true, none));
+        producer.join();
+        CHECK(equal(taken->data[0], make_box(1)));
+        CHECK_EQ(taken->data[1], object_ptr{ b });
+
+        /* The selector lost on a, so a put there must stay in a for the next take. */
+        CHECK(a->offer(make_box(2)));
+        CHECK(equal(a->poll(), make_box(2)));
+        CHECK_EQ(b->poll(), nullptr);
+      }
+
+      SUBCASE("put")
+      {
+        auto const a(make_box<channel>(1));
+        auto const b(make_box<channel>(1));
+        CHECK(a->offer(make_box(1)));
+        CHECK(b->offer(make_box(2)));
+        auto const ops(make_box<persistent_vector>(
+          std::in_place,
+          object_ptr{ make_box<persistent_vector>(std::in_place,
+                                                  object_ptr{ a },
+                                                  object_ptr{ make_box(3) }) },
+          object_ptr{ make_box<persistent_vector>(std::in_place,
+                                                  object_ptr{ b },
+                                                  object_ptr{ make_box(4) }) }));
+
+        std::thread consumer{ [=] {
+          collector::thread_registration const registration;
+          std::this_thread::sleep_for(std::chrono::milliseconds{ 50 });
+          b->take();
+        } };
+        auto const put(channel::alts(ops, true, none));
+        consumer.join();
+        CHECK_EQ(put->data[0], object_ptr{ obj::boolean::true_const() });
+        CHECK_EQ(put->data[1], object_ptr{ b });
+        CHECK(equal(b->poll(), make_box(4)));
+        CHECK(equal(a->poll(), make_box(1)));
+        CHECK_EQ(a->poll(), nullptr);
+      }
+
+      SUBCASE("close")
+      {
+        auto const a(make_box<channel>(1));
+        auto const b(make_box<channel>(1));
+        auto const ops(
+          make_box<persistent_vector>(std::in_place, object_ptr{ a }, object_ptr{ b }));
+
+        std::thread closer{ [=] {
+          collector::thread_registration const registration;
+          std::this_thread::sleep_for(std::chrono::milliseconds{ 50 });
+          a->close();
+        } };
+        auto const taken(channel::alts(ops, true, none));
+        closer.join();
+        CHECK_EQ(taken->data[0], nil::nil_const());
+        CHECK_EQ(taken->data[1], object_ptr{ a });
+      }
+    }
+  }
+}
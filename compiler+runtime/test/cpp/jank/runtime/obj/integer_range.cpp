@@ -1,4 +1,5 @@
 #include <jank/runtime/obj/integer_range.hpp>
+#include <jank/runtime/obj/array_chunk.hpp>
 #include <jank/runtime/core.hpp>
 #include <jank/runtime/core/make_box.hpp>
 
@@ -19,5 +20,21 @@ namespace jank::runtime::obj
       CHECK(!equal(integer_range::create(make_box(0)), integer_range::create(make_box(5))));
       CHECK(!equal(integer_range::create(make_box(1)), integer_range::create(make_box(0))));
     }
+
+    TEST_CASE("chunked")
+    {
+      auto const r(expect_object<integer_range>(integer_range::create(make_box(70))));
+      auto const first(r->chunked_first());
+      CHECK_EQ(integer_range::chunk_size, first->count());
+      CHECK(equal(first->nth(make_box(31)), make_box(31)));
+
+      auto const second(r->chunked_next());
+      CHECK(equal(second->first(), make_box(32)));
+
+      auto const third(second->chunked_next());
+      CHECK_EQ(6, third->chunked_first()->count());
+      CHECK(equal(third->chunked_first()->nth(make_box(5)), make_box(69)));
+      CHECK_EQ(nullptr, third->chunked_next());
+    }
   }
 }
@@ -0,0 +1,53 @@
+#include <jank/runtime/obj/native_vector_sequence.hpp>
+#include <jank/runtime/obj/array_chunk.hpp>
+#include <jank/runtime/core.hpp>
+#include <jank/runtime/core/make_box.hpp>
+
+/* This must go last; doctest and glog both define CHECK and family. */
+#include <doctest/doctest.h>
+
+namespace jank::runtime::obj
+{
+  TEST_SUITE("native_vector_sequence")
+  {
+    TEST_CASE("chunked")
+    {
+      for(native_integer const size : { 1, 31, 32, 33, 64, 70 })
+      {
+        native_vector<object_ptr> data;
+        for(native_integer i{}; i < size; ++i)
+        {
+          data.emplace_back(make_box(i));
+        }
+
+        for(native_integer start{}; start < size; ++start)
+        {
+          CAPTURE(size);
+          CAPTURE(start);
+
+          /* There are no leaves here, so chunks are counted from wherever we start. */
+          auto expected(start);
+          auto s(make_box<native_vector_sequence>(data, static_cast<size_t>(start)));
+          while(s)
+          {
+            auto const chunk(s->chunked_first());
+            REQUIRE_EQ(std::min<size_t>(static_cast<size_t>(size - expected), 32), chunk->count());
+            for(size_t i{}; i < chunk->count(); ++i)
+            {
+              CHECK(equal(chunk->nth(make_box(static_cast<native_integer>(i))),
+                          make_box(expected)));
+              ++expected;
+            }
+
+            s = s->chunked_next();
+            if(s)
+            {
+              CHECK(equal(s->first(), make_box(expected)));
+            }
+          }
+          CHECK_EQ(size, expected);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,77 @@
+#include <jank/runtime/obj/persistent_vector_sequence.hpp>
+#include <jank/runtime/obj/persistent_vector.hpp>
+#include <jank/runtime/obj/array_chunk.hpp>
+#include <jank/runtime/core.hpp>
+#include <jank/runtime/core/make_box.hpp>
+
+/* This must go last; doctest and glog both define CHECK and family. */
+#include <doctest/doctest.h>
+
+namespace jank::runtime::obj
+{
+  TEST_SUITE("persistent_vector_sequence")
+  {
+    static persistent_vector_ptr make_vector(native_integer const size)
+    {
+      persistent_vector::value_type data;
+      for(native_integer i{}; i < size; ++i)
+      {
+        data = data.push_back(make_box(i));
+      }
+      return make_box<persistent_vector>(std::move(data));
+    }
+
+    TEST_CASE("chunked")
+    {
+      /* Sizes either side of a leaf, along with some which span several leaves and a tail. */
+      for(native_integer const size : { 1, 31, 32, 33, 64, 70, 100 })
+      {
+        auto const v(make_vector(size));
+        for(native_integer start{}; start < size; ++start)
+        {
+          CAPTURE(size);
+          CAPTURE(start);
+
+          auto expected(start);
+          auto s(make_box<persistent_vector_sequence>(v, static_cast<size_t>(start)));
+          while(s)
+          {
+            /* Every chunk ends on a leaf boundary, or at the end of the vector, so only
+             * the first can be short when starting mid leaf. */
+            auto const chunk(s->chunked_first());
+            auto const leaf_end(std::min<native_integer>(size, (expected / 32 + 1) * 32));
+            REQUIRE_EQ(static_cast<size_t>(leaf_end - expected), chunk->count());
+            for(size_t i{}; i < chunk->count(); ++i)
+            {
+              CHECK(equal(chunk->nth(make_box(static_cast<native_integer>(i))),
+                          make_box(expected)));
+              ++expected;
+            }
+
+            s = s->chunked_next();
+            if(s)
+            {
+              CHECK(s->index % persistent_vector_sequence::chunk_size == 0);
+              CHECK(equal(s->first(), make_box(expected)));
+            }
+          }
+          CHECK_EQ(size, expected);
+        }
+      }
+    }
+
+    TEST_CASE("chunked from next")
+    {
+      auto const v(make_vector(40));
+      auto const s(v->seq()->next()->next());
+      auto const chunk(s->chunked_first());
+      CHECK_EQ(30, chunk->count());
+      CHECK(equal(chunk->nth(make_box(0)), make_box(2)));
+
+      auto const rest(s->chunked_next());
+      CHECK_EQ(8, rest->chunked_first()->count());
+      CHECK(equal(rest->first(), make_box(32)));
+      CHECK_EQ(nullptr, rest->chunked_next());
+    }
+  }
+}
@@ -0,0 +1,65 @@
+#include <jank/runtime/obj/transient_array_map.hpp>
+#include <jank/runtime/obj/transient_hash_map.hpp>
+#include <jank/runtime/obj/persistent_array_map.hpp>
+#include <jank/runtime/core.hpp>
+#include <jank/runtime/core/make_box.hpp>
+
+/* This must go last; doctest and glog both define CHECK and family. */
+#include <doctest/doctest.h>
+
+namespace jank::runtime::obj
+{
+  TEST_SUITE("transient_array_map")
+  {
+    TEST_CASE("assoc in place")
+    {
+      auto const trans(transient_array_map::empty());
+      object_ptr ret{ trans };
+      for(native_integer i{}; i < static_cast<native_integer>(transient_array_map::max_size); ++i)
+      {
+        ret = trans->assoc_in_place(make_box(i), make_box(i));
+        CHECK(ret == trans);
+      }
+      CHECK(trans->assoc_in_place(make_box(0), make_box(42)) == trans);
+      CHECK(equal(trans->get(make_box(0)), make_box(42)));
+      CHECK(trans->count() == transient_array_map::max_size);
+
+      auto const persistent(trans->to_persistent());
+      CHECK(persistent->count() == transient_array_map::max_size);
+      CHECK(equal(persistent->get(make_box(0)), make_box(42)));
+      CHECK_THROWS(trans->count());
+    }
+
+    TEST_CASE("promotion")
+    {
+      auto const trans(persistent_array_map::empty()->to_transient());
+      object_ptr ret{ trans };
+      for(native_integer i{}; i <= static_cast<native_integer>(transient_array_map::max_size);
+          ++i)
+      {
+        ret = assoc_in_place(ret, make_box(i), make_box(i));
+      }
+      CHECK(ret->type == object_type::transient_hash_map);
+      CHECK(!trans->active);
+
+      auto const promoted(expect_object<transient_hash_map>(ret));
+      CHECK(promoted->count() == transient_array_map::max_size + 1);
+      for(native_integer i{}; i <= static_cast<native_integer>(transient_array_map::max_size);
+          ++i)
+      {
+        CHECK(equal(promoted->get(make_box(i)), make_box(i)));
+      }
+    }
+
+    TEST_CASE("dissoc in place")
+    {
+      auto const trans(
+        persistent_array_map::create_unique(make_box(1), make_box(2), make_box(3), make_box(4))
+          ->to_transient());
+      trans->dissoc_in_place(make_box(1));
+      CHECK(trans->count() == 1);
+      CHECK(!trans->contains(make_box(1)));
+      CHECK(equal(trans->get(make_box(3)), make_box(4)));
+    }
+  }
+}
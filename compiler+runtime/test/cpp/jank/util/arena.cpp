@@ -0,0 +1,68 @@
+#include <jank/util/arena.hpp>
+
+/* This must go last; doctest and glog both define CHECK and family. */
+#include <doctest/doctest.h>
+
+namespace jank::util
+{
+  struct arena_test_object : arena_object
+  {
+    native_integer value{};
+  };
+
+  TEST_SUITE("arena")
+  {
+    TEST_CASE("allocate")
+    {
+      arena a;
+      auto const first(a.allocate(1));
+      auto const second(a.allocate(1));
+      CHECK_EQ(0, reinterpret_cast<uintptr_t>(first) % arena::alignment);
+      CHECK_EQ(0, reinterpret_cast<uintptr_t>(second) % arena::alignment);
+      CHECK_NE(first, second);
+      CHECK_EQ(2 * arena::alignment, a.size());
+    }
+
+    TEST_CASE("oversized")
+    {
+      arena a;
+      a.allocate(1);
+      a.allocate(arena::chunk_size * 2);
+      CHECK_NE(a.first, a.current);
+      CHECK_EQ(arena::alignment + arena::chunk_size * 2, a.size());
+    }
+
+    TEST_CASE("reset")
+    {
+      arena a;
+      auto const first(static_cast<char *>(a.allocate(8)));
+      first[0] = 'a';
+      a.allocate(arena::chunk_size);
+      a.reset();
+      CHECK_EQ(a.first, a.current);
+      CHECK_EQ(0, a.size());
+      auto const again(static_cast<char *>(a.allocate(8)));
+      CHECK_EQ(first, again);
+      CHECK_EQ(0, again[0]);
+    }
+
+    TEST_CASE("scope")
+    {
+      CHECK_EQ(nullptr, current_arena());
+      {
+        arena_scope const outer;
+        CHECK_EQ(outer.allocations, current_arena());
+        auto const o(new(GC) arena_test_object{});
+        CHECK_EQ(arena::alignment, outer.allocations->size());
+        {
+          arena_scope const inner;
+          CHECK_EQ(inner.allocations, current_arena());
+          CHECK_NE(outer.allocations, inner.allocations);
+        }
+        CHECK_EQ(outer.allocations, current_arena());
+        CHECK_EQ(0, o->value);
+      }
+      CHECK_EQ(nullptr, current_arena());
+    }
+  }
+}
@@ -0,0 +1,62 @@
+#include <jank/util/cli.hpp>
+
+/* This must go last; doctest and glog both define CHECK and family. */
+#include <doctest/doctest.h>
+
+namespace jank::util::cli
+{
+  TEST_SUITE("cli")
+  {
+    TEST_CASE("gc options")
+    {
+      SUBCASE("defaults")
+      {
+        char const *argv[]{ "jank", "repl" };
+        auto const res(parse(2, argv));
+        REQUIRE(res.is_ok());
+        auto const &opts(res.expect_ok());
+        CHECK(!opts.gc_incremental);
+        CHECK_EQ(opts.gc_initial_heap_size, 0);
+        CHECK_EQ(opts.gc_free_space_divisor, 0);
+        CHECK_EQ(opts.gc_markers, 0);
+        CHECK_EQ(opts.gc_pause_target_ms, 0);
+      }
+
+      SUBCASE("all set")
+      {
+        char const *argv[]{ "jank",
+                            "--gc-incremental",
+                            "--gc-initial-heap-size",
+                            "1048576",
+                            "--gc-free-space-divisor",
+                            "5",
+                            "--gc-markers=4",
+                            "--gc-pause-target",
+                            "10",
+                            "repl" };
+        auto const res(parse(10, argv));
+        REQUIRE(res.is_ok());
+        auto const &opts(res.expect_ok());
+        CHECK(opts.gc_incremental);
+        CHECK_EQ(opts.gc_initial_heap_size, 1048576);
+        CHECK_EQ(opts.gc_free_space_divisor, 5);
+        CHECK_EQ(opts.gc_markers, 4);
+        CHECK_EQ(opts.gc_pause_target_ms, 10);
+        CHECK(opts.command == command::repl);
+      }
+
+      SUBCASE("invalid")
+      {
+        for(auto const flag : { "--gc-markers", "--gc-free-space-divisor", "--gc-pause-target" })
+        {
+          CAPTURE(flag);
+          char const *argv[]{ "jank", flag, "0", "repl" };
+          CHECK(parse(4, argv).is_err());
+        }
+
+        char const *argv[]{ "jank", "--gc-initial-heap-size", "-1", "repl" };
+        CHECK(parse(4, argv).is_err());
+      }
+    }
+  }
+}
@@ -0,0 +1,42 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <jank/util/futex.hpp>
+
+/* This must go last; doctest and glog both define CHECK and family. */
+#include <doctest/doctest.h>
+
+namespace jank::util
+{
+  TEST_SUITE("futex")
+  {
+    TEST_CASE("changed value")
+    {
+      std::atomic<uint32_t> word{ 1 };
+      CHECK(futex::wait(word, 0, std::chrono::nanoseconds{ 0 }));
+    }
+
+    TEST_CASE("timeout")
+    {
+      std::atomic<uint32_t> word{ 0 };
+      CHECK(!futex::wait(word, 0, std::chrono::milliseconds{ 5 }));
+    }
+
+    TEST_CASE("wake")
+    {
+      std::atomic<uint32_t> word{ 0 };
+      std::thread waker{ [&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+        word.store(1);
+        futex::wake_all(word);
+      } };
+      while(word.load() == 0)
+      {
+        futex::wait(word, 0, none);
+      }
+      waker.join();
+      CHECK_EQ(1, word.load());
+    }
+  }
+}
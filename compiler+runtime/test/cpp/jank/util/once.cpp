@@ -0,0 +1,76 @@
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <jank/util/once.hpp>
+
+/* This must go last; doctest and glog both define CHECK and family. */
+#include <doctest/doctest.h>
+
+namespace jank::util
+{
+  TEST_SUITE("once")
+  {
+    TEST_CASE("runs once")
+    {
+      once o;
+      size_t calls{};
+      CHECK(!o.is_done());
+      o.call([&] { ++calls; });
+      o.call([&] { ++calls; });
+      CHECK(o.is_done());
+      CHECK_EQ(1, calls);
+    }
+
+    TEST_CASE("initially done")
+    {
+      once o{ true };
+      size_t calls{};
+      o.call([&] { ++calls; });
+      CHECK_EQ(0, calls);
+    }
+
+    TEST_CASE("retries after throwing")
+    {
+      once o;
+      CHECK_THROWS(o.call([] { throw std::runtime_error{ "nope" }; }));
+      CHECK(!o.is_done());
+
+      size_t calls{};
+      o.call([&] { ++calls; });
+      CHECK(o.is_done());
+      CHECK_EQ(1, calls);
+    }
+
+    TEST_CASE("recursive")
+    {
+      once o;
+      CHECK_THROWS(o.call([&] { o.call([] {}); }));
+      CHECK(!o.is_done());
+    }
+
+    TEST_CASE("concurrent")
+    {
+      once o;
+      std::atomic<size_t> calls{};
+      std::vector<std::thread> threads;
+      for(size_t i{}; i < 8; ++i)
+      {
+        threads.emplace_back([&] {
+          o.call([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+            ++calls;
+          });
+        });
+      }
+      for(auto &t : threads)
+      {
+        t.join();
+      }
+      CHECK(o.is_done());
+      CHECK_EQ(1, calls.load());
+    }
+  }
+}
@@ -97,5 +97,28 @@ namespace jank::util
       CHECK_EQ(initial_capacity, sb.capacity);
       CHECK_EQ("😁", sb.view());
     }
+
+    TEST_CASE("sink")
+    {
+      native_transient_string drained;
+      string_builder sb;
+      sb.sink_data = &drained;
+      sb.sink = [](void * const data, char const * const s, size_t const size) {
+        static_cast<native_transient_string *>(data)->append(s, size);
+      };
+
+      for(size_t i{}; i < 100; ++i)
+      {
+        sb("0123456789");
+      }
+      CHECK_EQ(initial_capacity, sb.capacity);
+      CHECK(sb.pos < initial_capacity);
+      CHECK_EQ(1000 - sb.pos, drained.size());
+
+      sb.drain();
+      CHECK_EQ(0, sb.pos);
+      CHECK_EQ(1000, drained.size());
+      CHECK_EQ("0123456789", drained.substr(990));
+    }
   }
 }
@@ -13,8 +13,12 @@
 
 #include <jank/native_persistent_string/fmt.hpp>
 #include <jank/runtime/context.hpp>
+#include <jank/runtime/collector.hpp>
 #include <jank/runtime/core/to_string.hpp>
 #include <jank/error/report.hpp>
+#include <jank/util/cli.hpp>
+#include <jank/gc_native.hpp>
+#include <jank/async_native.hpp>
 #include <clojure/core_native.hpp>
 
 /* NOLINTNEXTLINE(bugprone-exception-escape): println can throw. */
@@ -36,8 +40,14 @@ try
   context.applyCommandLine(argc, argv);
   context.setOption("no-breaks", true);
 
+  /* The default options, which only install the GC event callbacks, so jank.gc/stats has
+   * something to count. */
+  jank::runtime::collector::configure(jank::util::cli::options{});
+
   jank::runtime::__rt_ctx = new(GC) jank::runtime::context{};
   jank_load_clojure_core_native();
+  jank_load_jank_gc_native();
+  jank_load_jank_async_native();
   /* TODO: Load latest here.
    * We're loading from source always due to a bug in how we generate symbols which is
    * leading to duplicate symbols being generated. */
@@ -1,263 +1,88 @@
-#include <stack>
-
-/* https://wiki.theory.org/BitTorrentSpecification#Bencoding */
+#include <jank/c_api.h>
+#include <jank/runtime/bencode.hpp>
+#include <jank/runtime/convert.hpp>
+#include <jank/runtime/obj/native_function_wrapper.hpp>
+#include <jank/runtime/obj/native_pointer_wrapper.hpp>
+#include <jank/runtime/obj/persistent_vector.hpp>
+#include <jank/runtime/obj/transient_vector.hpp>
+
+/* The decoder itself lives in the runtime, where the nREPL server shares it. */
 namespace jank::data::bencode::decode
 {
   using namespace jank;
   using namespace jank::runtime;
+  using runtime::bencode::decode_error;
+  using runtime::bencode::decode_error_reason;
+  using runtime::bencode::decoder;
 
-  enum class decode_error_reason
-  {
-    invalid_data,
-    incomplete_data
-  };
-
-  struct decode_error
+  static void throw_error(decode_error const &e)
   {
-    native_persistent_string message;
-    decode_error_reason reason{};
-  };
-
-  using decode_result = result<std::pair<object_ptr, size_t>, decode_error>;
-
-  struct partially_decoded_list
-  {
-    obj::transient_vector_ptr data;
-  };
-
-  struct partially_decoded_dictionary
-  {
-    obj::transient_hash_map_ptr data;
-    object_ptr next_key{};
-  };
-
-  using partially_decoded_collection
-    = boost::variant<partially_decoded_list, partially_decoded_dictionary>;
+    auto const err("bencode decode error: " + e.message);
+    throw std::runtime_error{ err.c_str() };
+  }
 
-  template <typename T>
-  result<void, decode_error> append(partially_decoded_collection &coll, T const o)
+  /* Decodes the first value in a complete input. */
+  static object_ptr decode(object_ptr const str)
   {
-    if(coll.which() == 0)
+    auto const res(runtime::bencode::decode(try_object<obj::persistent_string>(str)->data));
+    if(res.is_err())
     {
-      auto &list(boost::get<partially_decoded_list>(coll));
-      list.data = list.data->cons_in_place(o);
-      return ok();
-    }
-    else
-    {
-      auto &dict(boost::get<partially_decoded_dictionary>(coll));
-      if constexpr(std::same_as<T, obj::persistent_string_ptr>)
-      {
-        if(!dict.next_key)
-        {
-          dict.next_key = o;
-          return ok();
-        }
-      }
-      else
-      {
-        if(!dict.next_key)
-        {
-          return decode_error{ "non-string dict key", decode_error_reason::invalid_data };
-        }
-      }
-
-      dict.data = dict.data->assoc_in_place(dict.next_key, o);
-      dict.next_key = nullptr;
-      return ok();
+      throw_error(res.expect_err());
     }
+    return res.expect_ok();
   }
 
-  result<object_ptr, decode_error> finish(partially_decoded_collection &coll)
+  static object_ptr make_decoder()
   {
-    if(coll.which() == 0)
-    {
-      auto &list(boost::get<partially_decoded_list>(coll));
-      return ok(list.data->to_persistent());
-    }
-    else
-    {
-      auto &dict(boost::get<partially_decoded_dictionary>(coll));
-      if(dict.next_key)
-      {
-        return decode_error{ "odd number of dict fields", decode_error_reason::invalid_data };
-      }
-      return ok(dict.data->to_persistent());
-    }
+    return make_box<obj::native_pointer_wrapper>(new(GC) decoder{});
   }
 
-  decode_result decode_some(object_ptr const str_obj)
+  /* Feeds the next piece of input to the decoder, returning a vector of every value it
+   * finished. Whatever's left over is kept for next time. */
+  static object_ptr decode_some(object_ptr const d, object_ptr const str)
   {
-    auto const &str(runtime::detail::to_string(str_obj));
-    auto const str_len(str.size());
-    size_t consumed_bytes{};
-
-    enum class collection_type
-    {
-      list,
-      dictionary
-    };
-
-    std::stack<partially_decoded_collection> stack;
+    auto const dec(try_object<obj::native_pointer_wrapper>(d)->as<decoder>());
+    auto const &input(try_object<obj::persistent_string>(str)->data);
 
-    while(consumed_bytes < str_len)
+    auto const ret(obj::transient_vector::empty());
+    for(size_t offset{}; offset < input.size();)
     {
-      switch(str[consumed_bytes])
+      auto const res(dec->decode_some(input, offset));
+      if(res.is_err())
       {
-        case 'i':
-          {
-            ++consumed_bytes;
-            auto const end(str.find('e', consumed_bytes));
-            if(end == native_persistent_string::npos)
-            {
-              return decode_error{ "EOF while reading int", decode_error_reason::incomplete_data };
-            }
-
-            auto const data(str.data());
-            native_integer i{};
-            auto const res(std::from_chars(data + consumed_bytes, data + end, i));
-            if(res.ec != std::errc{} || res.ptr != data + end)
-            {
-              /* TODO: Use ec value for better message. */
-              return decode_error{ "unable to parse int", decode_error_reason::invalid_data };
-            }
-            consumed_bytes += (end - consumed_bytes) + 1;
-
-            if(stack.empty())
-            {
-              return std::make_pair(make_box(i), consumed_bytes);
-            }
-
-            auto const append_res(append(stack.top(), make_box(i)));
-            if(append_res.is_err())
-            {
-              return append_res.expect_err();
-            }
-          }
-          break;
-
-        case 'l':
-          {
-            ++consumed_bytes;
-            stack.emplace(partially_decoded_list{ obj::transient_vector::empty() });
-          }
-          break;
-
-        case 'd':
-          {
-            ++consumed_bytes;
-            stack.emplace(partially_decoded_dictionary{ obj::transient_hash_map::empty() });
-          }
-          break;
-
-        case 'e':
-          {
-            ++consumed_bytes;
-            if(stack.empty())
-            {
-              return decode_error{ "extraneous 'e' found", decode_error_reason::invalid_data };
-            }
-
-            auto const res(finish(stack.top()));
-            if(res.is_err())
-            {
-              return res.expect_err();
-            }
-
-            if(stack.size() == 1)
-            {
-              return std::make_pair(res.expect_ok(), consumed_bytes);
-            }
-            stack.pop();
-
-            auto const append_res(append(stack.top(), res.expect_ok()));
-            if(append_res.is_err())
-            {
-              return append_res.expect_err();
-            }
-          }
-          break;
-
-        case '0' ... '9':
-          {
-            auto const end(str.find(':', consumed_bytes));
-            if(end == native_persistent_string::npos)
-            {
-              return decode_error{ "EOF while reading string",
-                                   decode_error_reason::incomplete_data };
-            }
-
-            auto const data(str.data());
-            native_integer size{};
-            auto const res(std::from_chars(data + consumed_bytes, data + end, size));
-            if(res.ec != std::errc{} || res.ptr != data + end)
-            {
-              /* TODO: Use ec value for better message. */
-              return decode_error{ "unable to parse string size",
-                                   decode_error_reason::invalid_data };
-            }
-            consumed_bytes += (end - consumed_bytes) + 1;
-
-            if(size < 0 || size > str.size() - consumed_bytes)
-            {
-              return decode_error{ "invalid string size", decode_error_reason::invalid_data };
-            }
-            native_persistent_string_view s{ data + consumed_bytes, data + consumed_bytes + size };
-
-            consumed_bytes += size;
-
-            if(stack.empty())
-            {
-              return std::make_pair(make_box(s), consumed_bytes);
-            }
-
-            auto const append_res(append(stack.top(), make_box(s)));
-            if(append_res.is_err())
-            {
-              return append_res.expect_err();
-            }
-          }
+        if(res.expect_err().reason == decode_error_reason::incomplete_data)
+        {
           break;
-
-        default:
-          return decode_error{ "unsupported character", decode_error_reason::invalid_data };
+        }
+        throw_error(res.expect_err());
       }
-    }
 
-    if(!stack.empty())
-    {
-      return decode_error{ "unexpected EOF", decode_error_reason::incomplete_data };
+      ret->conj_in_place(res.expect_ok().first);
+      offset = res.expect_ok().second;
     }
-
-    return std::make_pair(obj::nil::nil_const(), consumed_bytes);
+    return ret->to_persistent();
   }
 
-  object_ptr decode(object_ptr const str)
+  static object_ptr is_partial(object_ptr const d)
   {
-    auto const res(decode_some(str));
-    if(res.is_err())
-    {
-      /* TODO: fmt details once fmt can be linked JIT */
-      auto const err("bencode decode error: " + res.expect_err().message);
-      throw std::runtime_error{ err.c_str() };
-    }
-    return res.expect_ok().first;
+    return make_box(try_object<obj::native_pointer_wrapper>(d)->as<decoder>()->is_partial());
   }
+}
 
-  /* TODO: Make base class for ns which does this_object_ptr */
-  struct __ns : behavior::callable
-  {
-    /* TODO: Remove const from all of these. */
-    object_ptr call() const override
-    {
-      auto const ns(__rt_ctx->intern_ns("jank.data.bencode.decode"));
-      ns->intern_var("decode")->bind_root(make_box<obj::native_function_wrapper>(&decode));
-      return obj::nil::nil_const();
-    }
-
-    object_ptr this_object_ptr() const override
-    {
-      return obj::nil::nil_const();
-    }
-  };
+extern "C" jank_object_ptr jank_load_jank_data_bencode_decode()
+{
+  using namespace jank;
+  using namespace jank::runtime;
+  using namespace jank::data::bencode;
+
+  auto const ns(__rt_ctx->intern_ns("jank.data.bencode.decode"));
+  auto const intern_fn([=](native_persistent_string const &name, auto const fn) {
+    ns->intern_var(name)->bind_root(make_box<obj::native_function_wrapper>(convert_function(fn)));
+  });
+  intern_fn("decode", &decode::decode);
+  intern_fn("decoder", &decode::make_decoder);
+  intern_fn("decode-some", &decode::decode_some);
+  intern_fn("partial?", &decode::is_partial);
+
+  return erase(obj::nil::nil_const());
 }
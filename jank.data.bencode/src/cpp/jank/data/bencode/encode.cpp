@@ -0,0 +1,41 @@
+#include <jank/c_api.h>
+#include <jank/runtime/bencode.hpp>
+#include <jank/runtime/convert.hpp>
+#include <jank/runtime/obj/native_function_wrapper.hpp>
+#include <jank/runtime/obj/writer.hpp>
+
+/* The encoder itself lives in the runtime, where the nREPL server shares it. */
+namespace jank::data::bencode::encode
+{
+  using namespace jank;
+  using namespace jank::runtime;
+
+  static object_ptr encode_str(object_ptr const o)
+  {
+    return make_box<obj::persistent_string>(runtime::bencode::encode(o));
+  }
+
+  /* Encodes into the writer's own buffer, so a file descriptor writer writes the value out
+   * in buffer sized pieces as it goes. */
+  static object_ptr encode_to(object_ptr const w, object_ptr const o)
+  {
+    runtime::bencode::encode_to(try_object<obj::writer>(w), o);
+    return obj::nil::nil_const();
+  }
+}
+
+extern "C" jank_object_ptr jank_load_jank_data_bencode_encode()
+{
+  using namespace jank;
+  using namespace jank::runtime;
+  using namespace jank::data::bencode;
+
+  auto const ns(__rt_ctx->intern_ns("jank.data.bencode.encode"));
+  auto const intern_fn([=](native_persistent_string const &name, auto const fn) {
+    ns->intern_var(name)->bind_root(make_box<obj::native_function_wrapper>(convert_function(fn)));
+  });
+  intern_fn("encode", &encode::encode_str);
+  intern_fn("encode-to!", &encode::encode_to);
+
+  return erase(obj::nil::nil_const());
+}
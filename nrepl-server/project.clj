@@ -9,5 +9,8 @@
          :includes []}
   :source-paths ["src/jank"
                  "src/cpp"]
-  :profiles {:uberjar {:aot :all
+  :profiles {:test {:source-paths ["test/jank"
+                                   "test/cpp"]
+                    :main ^:skip-aot jank.nrepl-server.test}
+             :uberjar {:aot :all
                        :jvm-opts ["-Dclojure.compiler.direct-linking=true"]}})
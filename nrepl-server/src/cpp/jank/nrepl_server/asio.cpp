@@ -1,95 +1,643 @@
+#include <iostream>
+#include <mutex>
+#include <random>
+
+#include <fmt/format.h>
+
 #include <boost/asio/ts/buffer.hpp>
 #include <boost/asio/ts/internet.hpp>
 
+#include <jank/c_api.h>
+#include <jank/error.hpp>
+#include <jank/runtime/bencode.hpp>
+#include <jank/runtime/convert.hpp>
+#include <jank/runtime/core/seq.hpp>
+#include <jank/runtime/executor.hpp>
+#include <jank/runtime/obj/native_function_wrapper.hpp>
+#include <jank/runtime/obj/persistent_array_map.hpp>
+#include <jank/runtime/obj/persistent_hash_map.hpp>
+#include <jank/runtime/obj/persistent_string.hpp>
+#include <jank/runtime/obj/transient_array_map.hpp>
+#include <jank/runtime/obj/transient_vector.hpp>
+#include <jank/runtime/obj/writer.hpp>
+
+/* https://nrepl.org/nrepl/design/overview.html
+ *
+ * All networking happens on the thread which calls run!. Each session has its own thread,
+ * which is where evaluation happens, so a long eval in one session never holds up reading,
+ * writing, or handling other ops for any connection.
+ *
+ * Messages are decoded and encoded with the runtime's bencode codec, which is shared with
+ * jank.data.bencode. */
 namespace jank::nrepl_server::asio
 {
+  using namespace jank;
   using namespace jank::runtime;
   using boost::asio::ip::tcp;
 
-  struct connection : public std::enable_shared_from_this<connection>
+  /* Replies are built up as maps, which the shared encoder writes out. Every reply carries
+   * the id and session of the request it answers, when there is one. */
+  struct reply
   {
-    connection(tcp::socket &&socket)
-      : socket_(std::move(socket))
+    reply(native_persistent_string const &id, native_persistent_string const &session)
+    {
+      if(!id.empty())
+      {
+        entry("id", id);
+      }
+      if(!session.empty())
+      {
+        entry("session", session);
+      }
+    }
+
+    reply &entry(native_persistent_string const &key, object_ptr const value)
     {
-      do_read();
+      data = runtime::assoc_in_place(data, make_box<obj::persistent_string>(key), value);
+      return *this;
     }
 
-    void do_read()
+    reply &entry(native_persistent_string const &key, native_persistent_string const &value)
     {
-      auto self(shared_from_this());
-      socket_.async_read_some(boost::asio::buffer(data_, max_length),
-                              [this, self](boost::system::error_code ec, std::size_t length) {
-                                if(!ec)
-                                {
-                                  do_write(length);
-                                }
-                              });
+      return entry(key, make_box<obj::persistent_string>(value));
     }
 
-    void do_write(std::size_t length)
+    reply &status(std::initializer_list<native_persistent_string_view> const statuses)
     {
-      auto self(shared_from_this());
-      boost::asio::async_write(socket_,
-                               boost::asio::buffer(data_, length),
-                               [this, self](boost::system::error_code ec, std::size_t /*length*/) {
-                                 if(!ec)
-                                 {
-                                   do_read();
-                                 }
-                               });
+      auto const ret(obj::transient_vector::empty());
+      for(auto const &s : statuses)
+      {
+        ret->conj_in_place(make_box(s));
+      }
+      return entry("status", ret->to_persistent());
     }
 
-    static constexpr size_t max_length = 1024;
+    object_ptr finish() const
+    {
+      return runtime::persistent(data);
+    }
 
-    tcp::socket socket_;
-    char data_[max_length]{};
+    object_ptr data{ obj::persistent_array_map::empty()->to_transient() };
   };
 
-  boost::asio::io_context io_context;
-  std::unique_ptr<tcp::acceptor> acceptor;
-  std::unique_ptr<tcp::socket> socket;
+  static option<native_persistent_string>
+  string_field(object_ptr const msg, native_persistent_string_view const &key)
+  {
+    auto const v(get(msg, make_box(key)));
+    if(v->type != object_type::persistent_string)
+    {
+      return none;
+    }
+    return expect_object<obj::persistent_string>(v)->data;
+  }
+
+  struct server;
 
-  void accept_connection()
+  /* Connections are kept alive by their pending I/O, which the GC can't see, so they're
+   * reference counted. Their memory is traceable, though, so the GC sees what they point to. */
+  struct connection : std::enable_shared_from_this<connection>
   {
-    std::cout << "waiting for a new connection...\n";
-    acceptor->async_accept(*socket, [](boost::system::error_code const ec) {
-      if(!ec)
+    static constexpr size_t buffer_size{ 64 * 1024 };
+    /* Once there's less than this left in the buffer, we move on to a fresh one. */
+    static constexpr size_t min_read_size{ 4 * 1024 };
+
+    connection(server &srv, tcp::socket &&socket)
+      : srv{ srv }
+      , socket{ std::move(socket) }
+    {
+    }
+
+    void read()
+    {
+      /* Reads land straight in a GC string, which the decoded byte strings share rather than
+       * copy. Since they may still be around, bytes which have been read are never written
+       * over. Instead, the old buffer lives on for as long as something decoded from it. */
+      if(buffer.size() - filled < min_read_size)
       {
-        std::cout << "new connection accepted\n";
-        std::make_shared<connection>(std::move(*socket));
+        buffer = native_persistent_string(buffer_size, '\0');
+        filled = 0;
       }
 
-      accept_connection();
-    });
+      socket.async_read_some(
+        boost::asio::buffer(const_cast<char *>(buffer.data()) + filled, buffer.size() - filled),
+        [self = shared_from_this()](boost::system::error_code const ec, size_t const length) {
+          if(ec)
+          {
+            self->disconnected();
+            return;
+          }
+
+          try
+          {
+            self->handle_messages(length);
+          }
+          catch(std::exception const &e)
+          {
+            std::cerr << "nREPL connection dropped: " << e.what() << "\n";
+            self->disconnected();
+            return;
+          }
+          self->read();
+        });
+    }
+
+    void handle_messages(size_t length);
+    void disconnected();
+
+    /* Can be called from any thread. Replies are encoded on the calling thread, then written
+     * one at a time, in order, by the I/O thread. */
+    void send(object_ptr const msg)
+    {
+      auto const encoded(runtime::bencode::encode(msg));
+      std::lock_guard<std::mutex> const locked{ outgoing_lock };
+      outgoing.emplace_back(encoded);
+      if(outgoing.size() == 1)
+      {
+        boost::asio::post(socket.get_executor(), [self = shared_from_this()]() { self->write(); });
+      }
+    }
+
+    /* The front of the queue stays put until it's been written, so it backs the write. */
+    void write()
+    {
+      native_persistent_string front;
+      {
+        std::lock_guard<std::mutex> const locked{ outgoing_lock };
+        front = outgoing.front();
+      }
+
+      boost::asio::async_write(
+        socket,
+        boost::asio::buffer(front.data(), front.size()),
+        [self = shared_from_this()](boost::system::error_code const ec, size_t) {
+          native_bool more{};
+          {
+            std::lock_guard<std::mutex> const locked{ self->outgoing_lock };
+            if(ec)
+            {
+              self->outgoing.clear();
+              return;
+            }
+            self->outgoing.pop_front();
+            more = !self->outgoing.empty();
+          }
+          if(more)
+          {
+            self->write();
+          }
+        });
+    }
+
+    server &srv;
+    tcp::socket socket;
+    native_persistent_string buffer;
+    /* How much of the buffer has been read into. */
+    size_t filled{};
+    runtime::bencode::decoder *dec{ new(GC) runtime::bencode::decoder{} };
+    std::mutex outgoing_lock;
+    native_deque<native_persistent_string> outgoing;
+    /* The sessions cloned over this connection, which are closed along with it. */
+    native_vector<native_persistent_string> sessions;
+  };
+
+  /* Evaluation isn't thread safe, so sessions take turns. This only serializes the evals
+   * themselves; queueing, output, and every other op carry on while one runs. */
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static std::mutex eval_lock;
+
+  struct session : gc
+  {
+    session(native_persistent_string const &id, obj::persistent_hash_map_ptr const bindings)
+      : id{ id }
+      , exec{ new(GC) executor{ 1, 1, std::chrono::milliseconds::zero() } }
+      , bindings{ bindings.data }
+      , out{ make_box<obj::writer>(&send_out, this) }
+      , err{ make_box<obj::writer>(&send_err, this) }
+    {
+    }
+
+    static void send_out(void * const data, char const * const s, size_t const size)
+    {
+      static_cast<session *>(data)->send_output("out", { s, size });
+    }
+
+    static void send_err(void * const data, char const * const s, size_t const size)
+    {
+      static_cast<session *>(data)->send_output("err", { s, size });
+    }
+
+    /* Output can come from any thread which the session's bindings were conveyed to, even
+     * after the eval which started it has finished. That output goes to wherever the
+     * session's most recent request came from. */
+    void send_output(native_persistent_string_view const &key,
+                     native_persistent_string_view const &chunk)
+    {
+      std::shared_ptr<connection> conn;
+      native_persistent_string request_id;
+      {
+        std::lock_guard<std::mutex> const locked{ target_lock };
+        conn = target;
+        request_id = target_id;
+      }
+      if(conn)
+      {
+        conn->send(reply{ request_id, id }.entry(key, chunk).finish());
+      }
+    }
+
+    /* Runs on the session's thread. */
+    void evaluate(std::shared_ptr<connection> const &conn,
+                  native_persistent_string const &request_id,
+                  native_persistent_string const &code)
+    {
+      {
+        std::lock_guard<std::mutex> const locked{ target_lock };
+        target = conn;
+        target_id = request_id;
+      }
+
+      auto const respond([&](auto &&fn) {
+        reply r{ request_id, id };
+        fn(r);
+        conn->send(r.finish());
+      });
+
+      try
+      {
+        std::lock_guard<std::mutex> const locked{ eval_lock };
+        context::binding_scope const scope{
+          *__rt_ctx,
+          expect_object<obj::persistent_hash_map>(bindings.load())
+            ->assoc(__rt_ctx->out_var, out)
+            ->assoc(__rt_ctx->err_var, err)
+        };
+
+        auto const ret(__rt_ctx->eval_string(code));
+        /* The value mustn't overtake the output which came before it. */
+        out->flush();
+        err->flush();
+
+        auto const value(to_code_string(ret));
+        auto const current_ns(expect_object<ns>(__rt_ctx->current_ns_var->deref()));
+        respond([&](reply &r) {
+          r.entry("ns", current_ns->name->to_string()).entry("value", value);
+        });
+
+        /* Anything changed with set!, such as *ns* from in-ns, sticks for the next eval. */
+        bindings.store(__rt_ctx->get_thread_bindings().data);
+      }
+      catch(std::exception const &e)
+      {
+        fail(respond, e.what());
+      }
+      catch(object_ptr const o)
+      {
+        fail(respond, to_code_string(o));
+      }
+      catch(native_persistent_string const &s)
+      {
+        fail(respond, s);
+      }
+      catch(error_ptr const &e)
+      {
+        fail(respond, e->message);
+      }
+
+      out->flush();
+      err->flush();
+      respond([](reply &r) { r.status({ "done" }); });
+    }
+
+    /* Stops sending output anywhere, so the connection can go away. */
+    void release()
+    {
+      std::lock_guard<std::mutex> const locked{ target_lock };
+      target.reset();
+    }
+
+    template <typename F>
+    void fail(F const &respond, native_persistent_string const &message)
+    {
+      out->flush();
+      respond([&](reply &r) { r.entry("err", message + "\n"); });
+      respond([](reply &r) { r.entry("ex", "exception").status({ "eval-error" }); });
+    }
+
+    native_persistent_string id;
+    /* A single thread, so a session's evals run in the order they were sent. */
+    executor *exec{};
+    /* The thread bindings each eval runs with, such as *ns*. This is only replaced by the
+     * session's thread, but clone reads it from the I/O thread. */
+    std::atomic<object *> bindings{};
+    obj::writer_ptr out;
+    obj::writer_ptr err;
+
+    std::mutex target_lock;
+    std::shared_ptr<connection> target;
+    native_persistent_string target_id;
+  };
+
+  struct eval_task : executor::task
+  {
+    eval_task(session * const s,
+              native_bool const ephemeral,
+              std::shared_ptr<connection> const &conn,
+              native_persistent_string const &request_id,
+              native_persistent_string const &code)
+      : s{ s }
+      , ephemeral{ ephemeral }
+      , conn{ conn }
+      , request_id{ request_id }
+      , code{ code }
+    {
+    }
+
+    void run() override
+    {
+      /* Tasks are GC memory, which is never destructed, so we let go of the connection
+       * ourselves. */
+      auto const c(std::move(conn));
+      s->evaluate(c, request_id, code);
+      if(ephemeral)
+      {
+        s->release();
+      }
+    }
+
+    session *s{};
+    native_bool ephemeral{};
+    std::shared_ptr<connection> conn;
+    native_persistent_string request_id;
+    native_persistent_string code;
+  };
+
+  struct server : gc
+  {
+    server(native_integer const port)
+      : acceptor{ io, tcp::endpoint{ tcp::v4(), static_cast<uint16_t>(port) } }
+    {
+    }
+
+    void accept()
+    {
+      acceptor.async_accept([this](boost::system::error_code const ec, tcp::socket socket) {
+        /* The acceptor is only closed when we're stopping. */
+        if(!acceptor.is_open())
+        {
+          return;
+        }
+        if(!ec)
+        {
+          auto const conn(std::allocate_shared<connection>(traceable_allocator<connection>{},
+                                                           *this,
+                                                           std::move(socket)));
+          connections.insert(conn.get());
+          conn->read();
+        }
+        accept();
+      });
+    }
+
+    /* Runs on the I/O thread. Once every connection is closed, their pending reads finish
+     * and run! returns. */
+    void stop()
+    {
+      boost::system::error_code ignored;
+      acceptor.close(ignored);
+      while(!connections.empty())
+      {
+        (*connections.begin())->disconnected();
+      }
+    }
+
+    session *create_session(obj::persistent_hash_map_ptr const bindings)
+    {
+      /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+      static std::mt19937_64 gen{ std::random_device{}() };
+      auto const id(fmt::format("{:016x}{:016x}", gen(), gen()));
+      return new(GC) session{ id, bindings };
+    }
+
+    obj::persistent_hash_map_ptr fresh_bindings() const
+    {
+      return obj::persistent_hash_map::create_unique(
+        std::make_pair(__rt_ctx->current_ns_var, __rt_ctx->intern_ns("user")));
+    }
+
+    void close_session(native_persistent_string const &id)
+    {
+      auto const found(sessions.find(id));
+      if(found != sessions.end())
+      {
+        found->second->exec->shutdown();
+        found->second->release();
+        sessions.erase(found);
+      }
+    }
+
+    void handle(std::shared_ptr<connection> const &conn, object_ptr const msg);
+
+    boost::asio::io_context io;
+    tcp::acceptor acceptor;
+    /* These are only touched from the I/O thread. Connections remove themselves once
+     * they're disconnected. */
+    native_set<connection *> connections;
+    native_unordered_map<native_persistent_string, session *> sessions;
+  };
+
+  /* Each read is decoded as its own piece of input, which the decoder picks up from where
+   * the last one left off, so messages can be split across reads however they like. */
+  void connection::handle_messages(size_t const length)
+  {
+    auto const input(buffer.shared_substr(filled, length));
+    filled += length;
+
+    for(size_t offset{}; offset < input.size();)
+    {
+      auto const res(dec->decode_some(input, offset));
+      if(res.is_err())
+      {
+        auto const &e(res.expect_err());
+        if(e.reason == runtime::bencode::decode_error_reason::incomplete_data)
+        {
+          break;
+        }
+        throw std::runtime_error{ ("invalid bencode: " + e.message).c_str() };
+      }
+
+      auto const msg(res.expect_ok().first);
+      offset = res.expect_ok().second;
+      if(msg->type != object_type::persistent_array_map
+         && msg->type != object_type::persistent_hash_map)
+      {
+        throw std::runtime_error{ "nREPL messages must be dicts" };
+      }
+      srv.handle(shared_from_this(), msg);
+    }
   }
 
-  object_ptr run_server(object_ptr const port, object_ptr const callback)
+  void connection::disconnected()
   {
-    auto const p(to_int(port));
-    acceptor = std::make_unique<tcp::acceptor>(io_context, tcp::endpoint(tcp::v4(), p));
-    socket = std::make_unique<tcp::socket>(io_context);
+    boost::system::error_code ignored;
+    socket.close(ignored);
+    for(auto const &id : sessions)
+    {
+      srv.close_session(id);
+    }
+    sessions.clear();
+    srv.connections.erase(this);
+  }
 
-    accept_connection();
+  void server::handle(std::shared_ptr<connection> const &conn, object_ptr const msg)
+  {
+    auto const op(string_field(msg, "op").unwrap_or(""));
+    auto const request_id(string_field(msg, "id").unwrap_or(""));
+    auto const session_id(string_field(msg, "session"));
 
-    /* This blocks. */
-    io_context.run();
-    return obj::nil::nil_const();
+    auto const respond([&](native_persistent_string const &sid, auto &&fn) {
+      reply r{ request_id, sid };
+      fn(r);
+      conn->send(r.finish());
+    });
+
+    session *s{};
+    if(session_id.is_some())
+    {
+      auto const found(sessions.find(session_id.unwrap()));
+      if(found == sessions.end())
+      {
+        respond(session_id.unwrap(), [](reply &r) {
+          r.status({ "done", "error", "unknown-session" });
+        });
+        return;
+      }
+      s = found->second;
+    }
+
+    if(op == "clone")
+    {
+      auto const bindings(s ? expect_object<obj::persistent_hash_map>(s->bindings.load())
+                            : fresh_bindings());
+      auto const cloned(create_session(bindings));
+      sessions[cloned->id] = cloned;
+      conn->sessions.emplace_back(cloned->id);
+      respond(session_id.unwrap_or(""), [&](reply &r) {
+        r.entry("new-session", cloned->id).status({ "done" });
+      });
+    }
+    else if(op == "close")
+    {
+      if(s)
+      {
+        close_session(s->id);
+      }
+      respond(session_id.unwrap_or(""), [](reply &r) { r.status({ "done", "session-closed" }); });
+    }
+    else if(op == "ls-sessions")
+    {
+      auto const ids(obj::transient_vector::empty());
+      for(auto const &entry : sessions)
+      {
+        ids->conj_in_place(make_box<obj::persistent_string>(entry.first));
+      }
+      respond(session_id.unwrap_or(""), [&](reply &r) {
+        r.entry("sessions", ids->to_persistent()).status({ "done" });
+      });
+    }
+    else if(op == "describe")
+    {
+      object_ptr ops{ obj::persistent_array_map::empty()->to_transient() };
+      for(auto const name : { "clone", "close", "describe", "eval", "load-file", "ls-sessions" })
+      {
+        ops = runtime::assoc_in_place(ops,
+                                      make_box<obj::persistent_string>(name),
+                                      obj::persistent_array_map::empty());
+      }
+      respond(session_id.unwrap_or(""), [&](reply &r) {
+        r.entry("ops", runtime::persistent(ops)).status({ "done" });
+      });
+    }
+    else if(op == "eval" || op == "load-file")
+    {
+      auto const code(string_field(msg, op == "eval" ? "code" : "file"));
+      if(code.is_none())
+      {
+        respond(session_id.unwrap_or(""), [](reply &r) {
+          r.status({ "done", "error", "no-code" });
+        });
+        return;
+      }
+
+      /* Evals without a session get one of their own, which goes away once it's done. */
+      auto const target(s ? s : create_session(fresh_bindings()));
+      target->exec->submit(new(GC) eval_task{ target, !s, conn, request_id, code.unwrap() });
+      if(!s)
+      {
+        target->exec->shutdown();
+      }
+    }
+    else
+    {
+      respond(session_id.unwrap_or(""), [](reply &r) {
+        r.status({ "done", "error", "unknown-op" });
+      });
+    }
   }
 
-  /* TODO: Make base class for ns which does this_object_ptr */
-  struct __ns : behavior::callable
+  /* The servers which are running, by port, so they can be stopped from any thread. */
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static std::mutex servers_lock;
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static native_unordered_map<native_integer, server *> servers;
+
+  /* Blocks, handling connections on this thread, until the server is stopped. The callback
+   * is given the port once we're listening, which is useful when asking for port 0. */
+  static object_ptr run_server(object_ptr const port, object_ptr const on_ready)
   {
-    /* TODO: Remove const from all of these. */
-    object_ptr call() const override
+    auto const srv(new(GC) server{ to_int(port) });
+    srv->accept();
+    auto const bound_port(static_cast<native_integer>(srv->acceptor.local_endpoint().port()));
     {
-      auto const ns(__rt_ctx->intern_ns("jank.nrepl-server.asio"));
-      ns->intern_var("run!")->bind_root(make_box<obj::native_function_wrapper>(&run_server));
-      return obj::nil::nil_const();
+      std::lock_guard<std::mutex> const locked{ servers_lock };
+      servers[bound_port] = srv;
     }
+    dynamic_call(on_ready, make_box(bound_port));
 
-    object_ptr this_object_ptr() const override
+    srv->io.run();
+
+    std::lock_guard<std::mutex> const locked{ servers_lock };
+    servers.erase(bound_port);
+    return obj::nil::nil_const();
+  }
+
+  /* Closes the server on the given port, along with its connections and their sessions.
+   * Returns false if there's no server running there. */
+  static object_ptr stop_server(object_ptr const port)
+  {
+    std::lock_guard<std::mutex> const locked{ servers_lock };
+    auto const found(servers.find(to_int(port)));
+    if(found == servers.end())
     {
-      return obj::nil::nil_const();
+      return make_box(false);
     }
-  };
+
+    auto const srv(found->second);
+    boost::asio::post(srv->io, [srv]() { srv->stop(); });
+    return make_box(true);
+  }
+}
+
+extern "C" jank_object_ptr jank_load_jank_nrepl_server_asio()
+{
+  using namespace jank;
+  using namespace jank::runtime;
+
+  auto const ns(__rt_ctx->intern_ns("jank.nrepl-server.asio"));
+  auto const intern_fn([=](native_persistent_string const &name, auto const fn) {
+    ns->intern_var(name)->bind_root(make_box<obj::native_function_wrapper>(convert_function(fn)));
+  });
+  intern_fn("run!", &nrepl_server::asio::run_server);
+  intern_fn("stop!", &nrepl_server::asio::stop_server);
+
+  return erase(obj::nil::nil_const());
 }
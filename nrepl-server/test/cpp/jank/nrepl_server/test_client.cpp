@@ -0,0 +1,153 @@
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include <boost/asio/ts/buffer.hpp>
+#include <boost/asio/ts/internet.hpp>
+
+#include <jank/c_api.h>
+#include <jank/runtime/bencode.hpp>
+#include <jank/runtime/convert.hpp>
+#include <jank/runtime/core/seq.hpp>
+#include <jank/runtime/executor.hpp>
+#include <jank/runtime/obj/native_function_wrapper.hpp>
+#include <jank/runtime/obj/native_pointer_wrapper.hpp>
+#include <jank/runtime/obj/persistent_string.hpp>
+
+/* A blocking nREPL client for the tests. It writes exactly the pieces it's given, pausing
+ * between them, so each piece normally shows up in its own read on the server's end. That's
+ * how the tests split messages across reads. */
+namespace jank::nrepl_server::test_client
+{
+  using namespace jank;
+  using namespace jank::runtime;
+  using boost::asio::ip::tcp;
+
+  struct client : gc
+  {
+    client(native_integer const port)
+      : socket{ io }
+    {
+      socket.connect(
+        tcp::endpoint{ boost::asio::ip::address_v4::loopback(), static_cast<uint16_t>(port) });
+      socket.set_option(tcp::no_delay{ true });
+    }
+
+    boost::asio::io_context io;
+    tcp::socket socket;
+    runtime::bencode::decoder *dec{ new(GC) runtime::bencode::decoder{} };
+    /* The last read, along with how much of it has been decoded. */
+    native_persistent_string input;
+    size_t offset{};
+  };
+
+  struct thread_task : executor::task
+  {
+    thread_task(object_ptr const fn)
+      : fn{ fn }
+    {
+    }
+
+    void run() override
+    {
+      try
+      {
+        dynamic_call(fn);
+      }
+      catch(...)
+      {
+        std::cerr << "nREPL test thread failed\n";
+      }
+    }
+
+    object_ptr fn{};
+  };
+
+  /* Calls the function on a thread of its own, such as for running a server. */
+  static object_ptr in_thread(object_ptr const fn)
+  {
+    executor::solo().submit(new(GC) thread_task{ fn });
+    return obj::nil::nil_const();
+  }
+
+  static client *to_client(object_ptr const c)
+  {
+    return try_object<obj::native_pointer_wrapper>(c)->as<client>();
+  }
+
+  static object_ptr connect(object_ptr const port)
+  {
+    return make_box<obj::native_pointer_wrapper>(new(GC) client{ to_int(port) });
+  }
+
+  static object_ptr encode(object_ptr const msg)
+  {
+    return make_box<obj::persistent_string>(runtime::bencode::encode(msg));
+  }
+
+  static object_ptr write(object_ptr const c, object_ptr const pieces)
+  {
+    auto const cl(to_client(c));
+    for(auto it(fresh_seq(pieces)); it != obj::nil::nil_const(); it = next_in_place(it))
+    {
+      auto const &piece(try_object<obj::persistent_string>(first(it))->data);
+      boost::asio::write(cl->socket, boost::asio::buffer(piece.data(), piece.size()));
+      std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+    }
+    return obj::nil::nil_const();
+  }
+
+  /* Blocks until the next whole message has been read. */
+  static object_ptr read_message(object_ptr const c)
+  {
+    auto const cl(to_client(c));
+    while(true)
+    {
+      if(cl->offset < cl->input.size())
+      {
+        auto const res(cl->dec->decode_some(cl->input, cl->offset));
+        if(res.is_ok())
+        {
+          cl->offset = res.expect_ok().second;
+          return res.expect_ok().first;
+        }
+        if(res.expect_err().reason == runtime::bencode::decode_error_reason::invalid_data)
+        {
+          throw std::runtime_error{ ("invalid bencode: " + res.expect_err().message).c_str() };
+        }
+      }
+
+      std::array<char, 4096> chunk{};
+      auto const length(cl->socket.read_some(boost::asio::buffer(chunk)));
+      cl->input = native_persistent_string{ chunk.data(), length };
+      cl->offset = 0;
+    }
+  }
+
+  static object_ptr close(object_ptr const c)
+  {
+    boost::system::error_code ignored;
+    to_client(c)->socket.close(ignored);
+    return obj::nil::nil_const();
+  }
+}
+
+extern "C" jank_object_ptr jank_load_jank_nrepl_server_test_client()
+{
+  using namespace jank;
+  using namespace jank::runtime;
+
+  auto const ns(__rt_ctx->intern_ns("jank.nrepl-server.test-client"));
+  auto const intern_fn([=](native_persistent_string const &name, auto const fn) {
+    ns->intern_var(name)->bind_root(make_box<obj::native_function_wrapper>(convert_function(fn)));
+  });
+  intern_fn("in-thread!", &nrepl_server::test_client::in_thread);
+  intern_fn("connect", &nrepl_server::test_client::connect);
+  intern_fn("encode", &nrepl_server::test_client::encode);
+  intern_fn("write!", &nrepl_server::test_client::write);
+  intern_fn("read-message", &nrepl_server::test_client::read_message);
+  intern_fn("close!", &nrepl_server::test_client::close);
+
+  return erase(obj::nil::nil_const());
+}